@@ -0,0 +1,138 @@
+//==============================================================================
+/**
+@file       ArtworkCache.cpp
+
+@brief      In-memory cache of finished key images, keyed by a hash of the source thumbnail
+
+@copyright  (c) 2021, bionyx187
+			This source code is licensed under the MIT-style license found in the LICENSE file.
+
+**/
+//==============================================================================
+
+#include "ArtworkCache.h"
+#include "Trace.h"
+
+#include <cstring>
+
+std::shared_ptr<KeyImage> MakeKeyImage(std::string inPng)
+{
+	TRACE_SCOPE("artwork", "base64");
+	static const char kAlphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+	static const char kPrefix[] = "data:image/png;base64,";
+
+	auto image = std::make_shared<KeyImage>();
+	image->png = std::move(inPng);
+
+	auto data = reinterpret_cast<const unsigned char*>(image->png.data());
+	auto size = image->png.size();
+	auto& uri = image->dataUri;
+	uri.reserve(sizeof(kPrefix) - 1 + (size + 2) / 3 * 4);
+	uri += kPrefix;
+
+	size_t i = 0;
+	for (; i + 3 <= size; i += 3) {
+		uint32_t triple = (uint32_t(data[i]) << 16) | (uint32_t(data[i + 1]) << 8) | data[i + 2];
+		uri += kAlphabet[(triple >> 18) & 0x3F];
+		uri += kAlphabet[(triple >> 12) & 0x3F];
+		uri += kAlphabet[(triple >> 6) & 0x3F];
+		uri += kAlphabet[triple & 0x3F];
+	}
+	if (i < size) {
+		uint32_t triple = uint32_t(data[i]) << 16;
+		if (i + 1 < size) {
+			triple |= uint32_t(data[i + 1]) << 8;
+		}
+		uri += kAlphabet[(triple >> 18) & 0x3F];
+		uri += kAlphabet[(triple >> 12) & 0x3F];
+		uri += i + 1 < size ? kAlphabet[(triple >> 6) & 0x3F] : '=';
+		uri += '=';
+	}
+	return image;
+}
+
+uint64_t HashArtworkBytes(const void* inData, size_t inSize)
+{
+	const uint64_t m = 0xc6a4a7935bd1e995ULL;
+	const int r = 47;
+	const uint64_t seed = 0x9747b28c;
+
+	uint64_t h = seed ^ (inSize * m);
+
+	auto data = static_cast<const unsigned char*>(inData);
+	auto end = data + (inSize & ~static_cast<size_t>(7));
+	for (; data != end; data += 8) {
+		uint64_t k;
+		std::memcpy(&k, data, sizeof(k));
+
+		k *= m;
+		k ^= k >> r;
+		k *= m;
+
+		h ^= k;
+		h *= m;
+	}
+
+	switch (inSize & 7) {
+	case 7: h ^= uint64_t(data[6]) << 48; [[fallthrough]];
+	case 6: h ^= uint64_t(data[5]) << 40; [[fallthrough]];
+	case 5: h ^= uint64_t(data[4]) << 32; [[fallthrough]];
+	case 4: h ^= uint64_t(data[3]) << 24; [[fallthrough]];
+	case 3: h ^= uint64_t(data[2]) << 16; [[fallthrough]];
+	case 2: h ^= uint64_t(data[1]) << 8; [[fallthrough]];
+	case 1: h ^= uint64_t(data[0]);
+		h *= m;
+	}
+
+	h ^= h >> r;
+	h *= m;
+	h ^= h >> r;
+
+	return h;
+}
+
+std::shared_ptr<const KeyImage> ArtworkCache::Find(uint64_t inHash)
+{
+	std::lock_guard<std::mutex> lock(mMutex);
+	auto found = mIndex.find(inHash);
+	if (found == mIndex.end()) {
+		return nullptr;
+	}
+
+	mEntries.splice(mEntries.begin(), mEntries, found->second);
+	return found->second->second;
+}
+
+void ArtworkCache::Insert(uint64_t inHash, std::shared_ptr<const KeyImage> inImage)
+{
+	std::lock_guard<std::mutex> lock(mMutex);
+	auto found = mIndex.find(inHash);
+	if (found != mIndex.end()) {
+		mByteSize -= found->second->second->ByteSize();
+		mEntries.erase(found->second);
+		mIndex.erase(found);
+	}
+
+	// Something bigger than the whole budget would only evict everything else and then itself.
+	auto size = inImage->ByteSize();
+	if (size > mByteBudget) {
+		return;
+	}
+
+	mEntries.emplace_front(inHash, std::move(inImage));
+	mIndex[inHash] = mEntries.begin();
+	mByteSize += size;
+
+	while (mByteSize > mByteBudget) {
+		auto& oldest = mEntries.back();
+		mByteSize -= oldest.second->ByteSize();
+		mIndex.erase(oldest.first);
+		mEntries.pop_back();
+	}
+}
+
+size_t ArtworkCache::ByteSize() const
+{
+	std::lock_guard<std::mutex> lock(mMutex);
+	return mByteSize;
+}
@@ -0,0 +1,60 @@
+//==============================================================================
+/**
+@file       ArtworkCache.h
+
+@brief      In-memory cache of finished key images, keyed by a hash of the source thumbnail
+
+@copyright  (c) 2021, bionyx187
+			This source code is licensed under the MIT-style license found in the LICENSE file.
+
+**/
+//==============================================================================
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+// The image sent as a key background, in both forms we need it in.
+struct KeyImage
+{
+	std::string png;		// Encoded 72x72 PNG
+	std::string dataUri;	// "data:image/png;base64,..." ready for setImage, empty when there is no artwork
+
+	size_t ByteSize() const { return png.size() + dataUri.size(); }
+};
+
+// Wraps an encoded PNG into a key image, base64-encoding it into the data URI.
+std::shared_ptr<KeyImage> MakeKeyImage(std::string inPng);
+
+// 64-bit MurmurHash2 (MurmurHash64A). Not cryptographic, just fast and well distributed.
+uint64_t HashArtworkBytes(const void* inData, size_t inSize);
+
+// Least recently used key images, bounded by their total size. A hit means the thumbnail bytes are
+// identical to ones seen before, so none of the decode/scale/encode/base64 work needs redoing.
+class ArtworkCache
+{
+public:
+	explicit ArtworkCache(size_t inByteBudget) : mByteBudget(inByteBudget) { }
+
+	std::shared_ptr<const KeyImage> Find(uint64_t inHash);
+	void Insert(uint64_t inHash, std::shared_ptr<const KeyImage> inImage);
+
+	size_t ByteSize() const;
+
+private:
+	using Entry = std::pair<uint64_t, std::shared_ptr<const KeyImage>>;
+
+	const size_t mByteBudget;
+	size_t mByteSize = 0;
+
+	// Most recently used at the front
+	std::list<Entry> mEntries;
+	std::unordered_map<uint64_t, std::list<Entry>::iterator> mIndex;
+	mutable std::mutex mMutex; // protects mByteSize, mEntries, mIndex
+};
@@ -0,0 +1,218 @@
+//==============================================================================
+/**
+@file       ArtworkDiskCache.cpp
+
+@brief      Persistent cache of finished key images that survives plugin restarts
+
+@copyright  (c) 2021, bionyx187
+			This source code is licensed under the MIT-style license found in the LICENSE file.
+
+**/
+//==============================================================================
+
+#include "ArtworkDiskCache.h"
+#include "Common/ESDUtilities.h"
+
+#include <cstring>
+
+static constexpr uint32_t kIndexMagic = 0x41574958;	// 'AWIX'
+static constexpr uint32_t kRecordMagic = 0x41575243;	// 'AWRC'
+static constexpr uint32_t kFormatVersion = 1;
+static constexpr uint32_t kSlotCount = 1024;
+static constexpr uint32_t kMaxProbes = 16;
+
+struct IndexHeader
+{
+	uint32_t magic;
+	uint32_t version;
+	uint32_t slotCount;
+	uint32_t reserved;
+	uint64_t blobCapacity;
+	uint64_t writeOffset;		// Where the next record goes in the blob ring
+	uint64_t nextSequence;		// Sequence number of the next record, never reused
+};
+
+struct IndexSlot
+{
+	uint64_t hash;				// 0 marks an empty slot
+	uint64_t offset;
+	uint64_t sequence;
+	uint64_t checksum;
+};
+
+struct RecordHeader
+{
+	uint32_t magic;
+	uint32_t pngSize;
+	uint32_t uriSize;
+	uint32_t reserved;
+	uint64_t hash;
+	uint64_t sequence;
+	uint64_t checksum;
+};
+
+static uint64_t Checksum(const char* inPng, size_t inPngSize, const char* inUri, size_t inUriSize)
+{
+	return HashArtworkBytes(inPng, inPngSize) * 31 + HashArtworkBytes(inUri, inUriSize);
+}
+
+static size_t RecordSize(size_t inPngSize, size_t inUriSize)
+{
+	// Keep every record header 8-byte aligned
+	return (sizeof(RecordHeader) + inPngSize + inUriSize + 7) & ~static_cast<size_t>(7);
+}
+
+static IndexHeader* Header(const MappedFile& inIndex)
+{
+	return reinterpret_cast<IndexHeader*>(inIndex.Data());
+}
+
+static IndexSlot* Slots(const MappedFile& inIndex)
+{
+	return reinterpret_cast<IndexSlot*>(inIndex.Data() + sizeof(IndexHeader));
+}
+
+// The record a slot points to, or nullptr if it has been overwritten or was never completely written
+static const RecordHeader* ValidRecord(const MappedFile& inBlob, const IndexSlot& inSlot)
+{
+	if (inSlot.hash == 0 || inSlot.offset + sizeof(RecordHeader) > inBlob.Size() || inSlot.offset % 8 != 0) {
+		return nullptr;
+	}
+
+	auto record = reinterpret_cast<const RecordHeader*>(inBlob.Data() + inSlot.offset);
+	if (record->magic != kRecordMagic || record->hash != inSlot.hash || record->sequence != inSlot.sequence || record->checksum != inSlot.checksum) {
+		return nullptr;
+	}
+	if (inSlot.offset + RecordSize(record->pngSize, record->uriSize) > inBlob.Size()) {
+		return nullptr;
+	}
+
+	auto data = reinterpret_cast<const char*>(record + 1);
+	if (Checksum(data, record->pngSize, data + record->pngSize, record->uriSize) != record->checksum) {
+		return nullptr;
+	}
+
+	return record;
+}
+
+ArtworkDiskCache::ArtworkDiskCache(const std::string& inDirectory, size_t inBlobCapacity)
+{
+	// Without a directory there is no cache, rather than one in whatever the current directory is.
+	if (inDirectory.empty()) {
+		return;
+	}
+
+	bool indexCreated = false;
+	bool blobCreated = false;
+	size_t indexSize = sizeof(IndexHeader) + kSlotCount * sizeof(IndexSlot);
+	if (!mIndex.Open(ESDUtilities::AddPathComponent(inDirectory, "artwork.idx"), indexSize, indexCreated) ||
+		!mBlob.Open(ESDUtilities::AddPathComponent(inDirectory, "artwork.blob"), inBlobCapacity, blobCreated)) {
+		mIndex.Close();
+		mBlob.Close();
+		return;
+	}
+
+	// Start over if either file is new or was written by a different layout.
+	auto header = Header(mIndex);
+	if (indexCreated || blobCreated || header->magic != kIndexMagic || header->version != kFormatVersion ||
+		header->slotCount != kSlotCount || header->blobCapacity != inBlobCapacity || header->writeOffset > inBlobCapacity) {
+		std::memset(mIndex.Data(), 0, mIndex.Size());
+		header->magic = kIndexMagic;
+		header->version = kFormatVersion;
+		header->slotCount = kSlotCount;
+		header->blobCapacity = inBlobCapacity;
+		header->writeOffset = 0;
+		header->nextSequence = 1;
+		mIndex.Flush(0, mIndex.Size());
+	}
+
+	mOpen = true;
+}
+
+std::shared_ptr<const KeyImage> ArtworkDiskCache::Find(uint64_t inHash)
+{
+	std::lock_guard<std::mutex> lock(mMutex);
+	if (!mOpen || inHash == 0) {
+		return nullptr;
+	}
+
+	auto slots = Slots(mIndex);
+	for (uint32_t probe = 0; probe < kMaxProbes; ++probe) {
+		const auto& slot = slots[(inHash + probe) % kSlotCount];
+		if (slot.hash == 0) {
+			return nullptr;
+		}
+		if (slot.hash != inHash) {
+			continue;
+		}
+
+		auto record = ValidRecord(mBlob, slot);
+		if (record == nullptr) {
+			return nullptr;
+		}
+
+		auto data = reinterpret_cast<const char*>(record + 1);
+		auto image = std::make_shared<KeyImage>();
+		image->png.assign(data, record->pngSize);
+		image->dataUri.assign(data + record->pngSize, record->uriSize);
+		return image;
+	}
+	return nullptr;
+}
+
+void ArtworkDiskCache::Insert(uint64_t inHash, const KeyImage& inImage)
+{
+	std::lock_guard<std::mutex> lock(mMutex);
+	if (!mOpen || inHash == 0) {
+		return;
+	}
+
+	auto header = Header(mIndex);
+	size_t size = RecordSize(inImage.png.size(), inImage.dataUri.size());
+	if (size > header->blobCapacity) {
+		return;
+	}
+
+	// Append to the ring, wrapping to the start when the record doesn't fit in what's left. Whatever was there
+	// is overwritten and its index slots stop validating.
+	uint64_t offset = header->writeOffset;
+	if (offset + size > header->blobCapacity) {
+		offset = 0;
+	}
+
+	RecordHeader record{};
+	record.magic = kRecordMagic;
+	record.pngSize = static_cast<uint32_t>(inImage.png.size());
+	record.uriSize = static_cast<uint32_t>(inImage.dataUri.size());
+	record.hash = inHash;
+	record.sequence = header->nextSequence;
+	record.checksum = Checksum(inImage.png.data(), inImage.png.size(), inImage.dataUri.data(), inImage.dataUri.size());
+
+	auto destination = mBlob.Data() + offset;
+	std::memcpy(destination, &record, sizeof(record));
+	std::memcpy(destination + sizeof(record), inImage.png.data(), inImage.png.size());
+	std::memcpy(destination + sizeof(record) + inImage.png.size(), inImage.dataUri.data(), inImage.dataUri.size());
+	mBlob.Flush(offset, size);
+
+	// Pick a slot: the one already holding this hash, an empty one, one whose record is gone, or failing that
+	// the oldest in the probe window.
+	auto slots = Slots(mIndex);
+	IndexSlot* target = nullptr;
+	for (uint32_t probe = 0; probe < kMaxProbes; ++probe) {
+		auto& slot = slots[(inHash + probe) % kSlotCount];
+		if (slot.hash == inHash || slot.hash == 0 || ValidRecord(mBlob, slot) == nullptr) {
+			target = &slot;
+			break;
+		}
+		if (target == nullptr || slot.sequence < target->sequence) {
+			target = &slot;
+		}
+	}
+
+	IndexSlot slot = { inHash, offset, record.sequence, record.checksum };
+	*target = slot;
+
+	header->writeOffset = offset + size;
+	header->nextSequence = record.sequence + 1;
+	mIndex.Flush(0, mIndex.Size());
+}
@@ -0,0 +1,47 @@
+//==============================================================================
+/**
+@file       ArtworkDiskCache.h
+
+@brief      Persistent cache of finished key images that survives plugin restarts
+
+@copyright  (c) 2021, bionyx187
+			This source code is licensed under the MIT-style license found in the LICENSE file.
+
+**/
+//==============================================================================
+
+#pragma once
+
+#include "ArtworkCache.h"
+#include "MappedFile.h"
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+
+// Two memory-mapped files in a directory:
+//
+// - artwork.blob is a fixed-size ring of records, each holding one key image. Records are only
+//   ever appended; when the ring is full, writing wraps to the start and overwrites the oldest.
+// - artwork.idx is a fixed-size open-addressing table from thumbnail hash to record.
+//
+// A record is written and flushed before its index slot, and every lookup checks the record's
+// header and checksum against the slot. A slot whose record was overwritten by the ring, or
+// torn by a crash, is simply a miss.
+class ArtworkDiskCache
+{
+public:
+	ArtworkDiskCache(const std::string& inDirectory, size_t inBlobCapacity);
+
+	bool IsOpen() const { return mOpen; }
+
+	std::shared_ptr<const KeyImage> Find(uint64_t inHash);
+	void Insert(uint64_t inHash, const KeyImage& inImage);
+
+private:
+	MappedFile mIndex;
+	MappedFile mBlob;
+	bool mOpen = false;
+	std::mutex mMutex; // protects both mappings
+};
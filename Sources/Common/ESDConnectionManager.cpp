@@ -11,7 +11,10 @@
 //==============================================================================
 
 #include "ESDConnectionManager.h"
-#include "EPLJSONUtils.h"
+#include "ESDMessageBuilder.h"
+#include "../Logger.h"
+#include "../Metrics.h"
+#include "../Trace.h"
 
 
 void ESDConnectionManager::OnOpen(WebsocketClient* inClient, websocketpp::connection_hdl inConnectionHandler)
@@ -63,60 +66,60 @@ void ESDConnectionManager::OnMessage(websocketpp::connection_hdl, WebsocketClien
 {
 	if (inMsg != NULL && inMsg->get_opcode() == websocketpp::frame::opcode::text)
 	{
-		std::string message = inMsg->get_payload();
+		// Decoded in place from websocketpp's buffer, into strings that keep their capacity between messages
+		const std::string& message = inMsg->get_payload();
 		DebugPrint("OnMessage: %s\n", message.c_str());
-#if LOG_MESSAGES
-		LogMessage("OnMessage: " + message);
-#endif
+		LOG(Messages, Debug, "OnMessage: " + message);
 
 		try
 		{
-			json receivedJson = json::parse(message);
-			
-			std::string event = EPLJSONUtils::GetStringByName(receivedJson, kESDSDKCommonEvent);
-			std::string context = EPLJSONUtils::GetStringByName(receivedJson, kESDSDKCommonContext);
-			std::string action = EPLJSONUtils::GetStringByName(receivedJson, kESDSDKCommonAction);
-			std::string deviceID = EPLJSONUtils::GetStringByName(receivedJson, kESDSDKCommonDevice);
-			json payload;
-			EPLJSONUtils::GetObjectByName(receivedJson, kESDSDKCommonPayload, payload);
-
-			if(event == kESDSDKEventKeyDown)
-			{
-				mPlugin->KeyDownForAction(action, context, payload, deviceID);
-			}
-			else if(event == kESDSDKEventKeyUp)
-			{
-				mPlugin->KeyUpForAction(action, context, payload, deviceID);
-			}
-			else if(event == kESDSDKEventWillAppear)
-			{
-				mPlugin->WillAppearForAction(action, context, payload, deviceID);
-			}
-			else if(event == kESDSDKEventWillDisappear)
+			ESDInboundEvent& event = mInboundEvent;
 			{
-				mPlugin->WillDisappearForAction(action, context, payload, deviceID);
+				TRACE_SCOPE("esd", "parse");
+				if (!ESDDecodeInboundEvent(message, event))
+				{
+					LOG(Messages, Warning, "Could not decode message: " + message);
+					return;
+				}
 			}
-			else if(event == kESDSDKEventDeviceDidConnect)
-			{
-				json deviceInfo;
-				EPLJSONUtils::GetObjectByName(receivedJson, kESDSDKCommonDeviceInfo, deviceInfo);
-				mPlugin->DeviceDidConnect(deviceID, deviceInfo);
-			}
-			else if(event == kESDSDKEventDeviceDidDisconnect)
-			{
-				mPlugin->DeviceDidDisconnect(deviceID);
-			}
-			else if (event == kESDSDKEventSendToPlugin)
-			{
-				mPlugin->SendToPlugin(action, context, payload, deviceID);
-			}
-			else if (event == kESDSDKEventDidReceiveSettings)
+
+			if (event.type == ESDEventType::Unknown)
 			{
-				mPlugin->ReceiveSettings(action, context, payload, deviceID);
+				return;
 			}
-			else if (event == kESDSDKEventTitleParametersDidChange)
+			TRACE_SCOPE("esd", ESDEventName(event.type));
+
+			switch (event.type)
 			{
-				mPlugin->TitleParametersDidChange(action, context, payload, deviceID);
+			case ESDEventType::KeyDown:
+				mPlugin->KeyDownForAction(event.action, event.context, event.payload, event.deviceID);
+				break;
+			case ESDEventType::KeyUp:
+				mPlugin->KeyUpForAction(event.action, event.context, event.payload, event.deviceID);
+				break;
+			case ESDEventType::WillAppear:
+				mPlugin->WillAppearForAction(event.action, event.context, event.payload, event.deviceID);
+				break;
+			case ESDEventType::WillDisappear:
+				mPlugin->WillDisappearForAction(event.action, event.context, event.payload, event.deviceID);
+				break;
+			case ESDEventType::DeviceDidConnect:
+				mPlugin->DeviceDidConnect(event.deviceID, event.deviceInfo);
+				break;
+			case ESDEventType::DeviceDidDisconnect:
+				mPlugin->DeviceDidDisconnect(event.deviceID);
+				break;
+			case ESDEventType::SendToPlugin:
+				mPlugin->SendToPlugin(event.action, event.context, event.payload, event.deviceID);
+				break;
+			case ESDEventType::DidReceiveSettings:
+				mPlugin->ReceiveSettings(event.action, event.context, event.payload, event.deviceID);
+				break;
+			case ESDEventType::TitleParametersDidChange:
+				mPlugin->TitleParametersDidChange(event.action, event.context, event.payload, event.deviceID);
+				break;
+			default:
+				break;
 			}
 		}
 		catch (...)
@@ -151,6 +154,17 @@ void ESDConnectionManager::Run()
 		
 		// Initialize ASIO
 		mWebsocket.init_asio();
+		Trace::SetThreadName("websocket io");
+
+		// The per-tick messages go through a latest-wins queue flushed on the io_service
+		mOutboundQueue = std::make_unique<ESDOutboundQueue>(mWebsocket.get_io_service(),
+			[this](const std::string& inMessage)
+			{
+				TRACE_SCOPE("esd", "send");
+				websocketpp::lib::error_code ec;
+				mWebsocket.send(mConnectionHandle, inMessage.data(), inMessage.size(), websocketpp::frame::opcode::text, ec);
+			},
+			[this]() { return GetBufferedAmount(); });
 		
 		// Register our message handler
 		mWebsocket.set_open_handler(websocketpp::lib::bind(&ESDConnectionManager::OnOpen, this, &mWebsocket, websocketpp::lib::placeholders::_1));
@@ -186,40 +200,62 @@ void ESDConnectionManager::Run()
     }
 }
 
-void ESDConnectionManager::SetTitle(const std::string &inTitle, const std::string& inContext, ESDSDKTarget inTarget)
+template<typename Builder>
+void ESDConnectionManager::SendBuilt(Builder&& inBuilder)
 {
-	json jsonObject;
+	// One buffer per sending thread, reused for every message. websocketpp copies the bytes into its own
+	// message before send returns, so the buffer is free again right away.
+	thread_local std::string buffer;
+	inBuilder(buffer);
 
-	jsonObject[kESDSDKCommonEvent] = kESDSDKEventSetTitle;
-	jsonObject[kESDSDKCommonContext] = inContext;
-
-	json payload;
-	payload[kESDSDKPayloadTarget] = inTarget;
-	payload[kESDSDKPayloadTitle] = inTitle;
-	jsonObject[kESDSDKCommonPayload] = payload;
-	
+	TRACE_SCOPE("esd", "send");
 	websocketpp::lib::error_code ec;
-	mWebsocket.send(mConnectionHandle, jsonObject.dump(), websocketpp::frame::opcode::text, ec);
+	mWebsocket.send(mConnectionHandle, buffer.data(), buffer.size(), websocketpp::frame::opcode::text, ec);
 }
 
-void ESDConnectionManager::SetImage(const std::string &inBase64ImageString, const std::string& inContext, ESDSDKTarget inTarget)
+size_t ESDConnectionManager::GetBufferedAmount()
 {
-	json jsonObject;
+	websocketpp::lib::error_code ec;
+	WebsocketClient::connection_ptr connection = mWebsocket.get_con_from_hdl(mConnectionHandle, ec);
+	if (ec || connection == NULL)
+		return 0;
+	return connection->get_buffered_amount();
+}
 
-	jsonObject[kESDSDKCommonEvent] = kESDSDKEventSetImage;
-	jsonObject[kESDSDKCommonContext] = inContext;
+void ESDConnectionManager::SetTitle(std::string_view inTitle, const std::string& inContext, ESDSDKTarget inTarget)
+{
+	Metrics::Add(MetricCounter::TitleCalls);
+	auto writer = [&](std::string& outBuffer) { ESDMessageBuilder::SetTitle(outBuffer, inTitle, inContext, inTarget); };
+	if (mOutboundQueue != nullptr)
+		mOutboundQueue->Enqueue(ESDOutboundQueue::Kind::Title, inContext, writer);
+	else
+		SendBuilt(writer);
+}
 
-	json payload;
-	payload[kESDSDKPayloadTarget] = inTarget;
-	const std::string prefix = "data:image/png;base64,";
-	if (inBase64ImageString.empty() || inBase64ImageString.substr(0, prefix.length()).find(prefix) == 0)
-		payload[kESDSDKPayloadImage] = inBase64ImageString;
+void ESDConnectionManager::SetImage(std::string_view inBase64ImageString, const std::string& inContext, ESDSDKTarget inTarget)
+{
+	Metrics::Add(MetricCounter::ImageCalls);
+	auto writer = [&](std::string& outBuffer) { ESDMessageBuilder::SetImage(outBuffer, inBase64ImageString, inContext, inTarget); };
+	if (mOutboundQueue != nullptr)
+		mOutboundQueue->Enqueue(ESDOutboundQueue::Kind::Image, inContext, writer);
 	else
-		payload[kESDSDKPayloadImage] = "data:image/png;base64," + inBase64ImageString;
-	jsonObject[kESDSDKCommonPayload] = payload;
-	
-	websocketpp::lib::error_code ec;
-	mWebsocket.send(mConnectionHandle, jsonObject.dump(), websocketpp::frame::opcode::text, ec);
+		SendBuilt(writer);
+}
+
+void ESDConnectionManager::DiscardPending(const std::string& inContext)
+{
+	if (mOutboundQueue != nullptr)
+		mOutboundQueue->Discard(inContext);
+}
+
+unsigned long long ESDConnectionManager::GetSupersededFrameCount() const
+{
+	return mOutboundQueue != nullptr ? mOutboundQueue->SupersededCount() : 0;
+}
+
+const LatencyHistogram* ESDConnectionManager::GetSendLatency(ESDOutboundQueue::Kind inKind) const
+{
+	return mOutboundQueue != nullptr ? &mOutboundQueue->SendLatency(inKind) : nullptr;
 }
 
 void ESDConnectionManager::ShowAlertForContext(const std::string& inContext)
@@ -258,17 +294,7 @@ void ESDConnectionManager::SetSettings(const json &inSettings, const std::string
 
 void ESDConnectionManager::SetState(int inState, const std::string& inContext)
 {
-	json jsonObject;
-	
-	json payload;
-	payload[kESDSDKPayloadState] = inState;
-
-	jsonObject[kESDSDKCommonEvent] = kESDSDKEventSetState;
-	jsonObject[kESDSDKCommonContext] = inContext;
-	jsonObject[kESDSDKCommonPayload] = payload;
-	
-	websocketpp::lib::error_code ec;
-	mWebsocket.send(mConnectionHandle, jsonObject.dump(), websocketpp::frame::opcode::text, ec);
+	SendBuilt([&](std::string& outBuffer) { ESDMessageBuilder::SetState(outBuffer, inState, inContext); });
 }
 
 void ESDConnectionManager::SendToPropertyInspector(const std::string & inAction, const std::string & inContext, const json & inPayload)
@@ -310,16 +336,6 @@ void ESDConnectionManager::LogMessage(const std::string& inMessage)
 {
 	if(!inMessage.empty())
 	{
-		json jsonObject;
-
-		jsonObject[kESDSDKCommonEvent] = kESDSDKEventLogMessage;
-		
-		json payload;
-		payload[kESDSDKPayloadMessage] = inMessage;
-		jsonObject[kESDSDKCommonPayload] = payload;
-
-		websocketpp::lib::error_code ec;
-		mWebsocket.send(mConnectionHandle, jsonObject.dump(), websocketpp::frame::opcode::text, ec);
+		SendBuilt([&](std::string& outBuffer) { ESDMessageBuilder::LogMessage(outBuffer, inMessage); });
 	}
 }
-
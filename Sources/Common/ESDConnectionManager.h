@@ -13,6 +13,8 @@
 #pragma once
 
 #include "ESDBasePlugin.h"
+#include "ESDInboundEvent.h"
+#include "ESDOutboundQueue.h"
 #include "ESDSDKDefines.h"
 
 #include <websocketpp/config/asio_no_tls_client.hpp>
@@ -20,6 +22,9 @@
 #include <websocketpp/common/thread.hpp>
 #include <websocketpp/common/memory.hpp>
 
+#include <memory>
+#include <string_view>
+
 typedef websocketpp::config::asio_client::message_type::ptr message_ptr;
 typedef websocketpp::client<websocketpp::config::asio_client> WebsocketClient;
 
@@ -38,8 +43,8 @@ public:
 	void Run();
 	
 	// API to communicate with the Stream Deck application
-	void SetTitle(const std::string &inTitle, const std::string& inContext, ESDSDKTarget inTarget);
-	void SetImage(const std::string &inBase64ImageString, const std::string& inContext, ESDSDKTarget inTarget);
+	void SetTitle(std::string_view inTitle, const std::string& inContext, ESDSDKTarget inTarget);
+	void SetImage(std::string_view inBase64ImageString, const std::string& inContext, ESDSDKTarget inTarget);
 	void ShowAlertForContext(const std::string& inContext);
 	void ShowOKForContext(const std::string& inContext);
 	void SetSettings(const json &inSettings, const std::string& inContext);
@@ -48,6 +53,18 @@ public:
 	void SwitchToProfile(const std::string& inDeviceID, const std::string& inProfileName);
 	void LogMessage(const std::string& inMessage);
 
+	// Forget frames still queued for a context that disappeared
+	void DiscardPending(const std::string& inContext);
+
+	// Number of queued setTitle/setImage frames replaced by a newer one before they were sent
+	unsigned long long GetSupersededFrameCount() const;
+
+	// Queue-to-websocket latency of setTitle/setImage frames, nullptr before the connection is running
+	const LatencyHistogram* GetSendLatency(ESDOutboundQueue::Kind inKind) const;
+
+	// The io_service running the websocket, for plugin timers that share its thread
+	websocketpp::lib::asio::io_service& GetIOService() { return mWebsocket.get_io_service(); }
+
 private:
 	
 	// Websocket callbacks
@@ -55,6 +72,12 @@ private:
 	void OnFail(WebsocketClient * inClient, websocketpp::connection_hdl inConnectionHandler);
 	void OnClose(WebsocketClient * inClient, websocketpp::connection_hdl inConnectionHandler);
 	void OnMessage(websocketpp::connection_hdl, WebsocketClient::message_ptr inMsg);
+
+	// Send a message written by ESDMessageBuilder into the calling thread's reusable buffer
+	template<typename Builder>
+	void SendBuilt(Builder&& inBuilder);
+
+	size_t GetBufferedAmount();
 	
 	// Member variables
 	int mPort = 0;
@@ -62,6 +85,10 @@ private:
 	std::string mRegisterEvent;
 	websocketpp::connection_hdl mConnectionHandle;
 	WebsocketClient mWebsocket;
+	std::unique_ptr<ESDOutboundQueue> mOutboundQueue;
 	ESDBasePlugin * mPlugin = nullptr;
+
+	// Reused for every message, only touched on the websocket thread
+	ESDInboundEvent mInboundEvent;
 };
 
@@ -0,0 +1,262 @@
+//==============================================================================
+/**
+@file       ESDInboundEvent.cpp
+
+@brief      Decodes messages from the Stream Deck application into typed events
+
+@copyright  (c) 2021, bionyx187
+			This source code is licensed under the MIT-style license found in the LICENSE file.
+
+**/
+//==============================================================================
+
+#include "ESDInboundEvent.h"
+#include "ESDSDKDefines.h"
+
+#include <array>
+#include <optional>
+
+struct ESDEventEntry
+{
+	std::string_view name;
+	ESDEventType type;
+};
+
+static constexpr ESDEventEntry kEvents[] = {
+	{ kESDSDKEventKeyDown, ESDEventType::KeyDown },
+	{ kESDSDKEventKeyUp, ESDEventType::KeyUp },
+	{ kESDSDKEventWillAppear, ESDEventType::WillAppear },
+	{ kESDSDKEventWillDisappear, ESDEventType::WillDisappear },
+	{ kESDSDKEventDeviceDidConnect, ESDEventType::DeviceDidConnect },
+	{ kESDSDKEventDeviceDidDisconnect, ESDEventType::DeviceDidDisconnect },
+	{ kESDSDKEventApplicationDidLaunch, ESDEventType::ApplicationDidLaunch },
+	{ kESDSDKEventApplicationDidTerminate, ESDEventType::ApplicationDidTerminate },
+	{ kESDSDKEventSystemDidWakeUp, ESDEventType::SystemDidWakeUp },
+	{ kESDSDKEventTitleParametersDidChange, ESDEventType::TitleParametersDidChange },
+	{ kESDSDKEventDidReceiveSettings, ESDEventType::DidReceiveSettings },
+	{ kESDSDKEventDidReceiveGlobalSettings, ESDEventType::DidReceiveGlobalSettings },
+	{ kESDSDKEventPropertyInspectorDidAppear, ESDEventType::PropertyInspectorDidAppear },
+	{ kESDSDKEventPropertyInspectorDidDisappear, ESDEventType::PropertyInspectorDidDisappear },
+	{ kESDSDKEventSendToPlugin, ESDEventType::SendToPlugin },
+};
+static constexpr size_t kEventCount = sizeof(kEvents) / sizeof(kEvents[0]);
+static_assert(kEventCount + 1 == static_cast<size_t>(ESDEventType::Count), "every event type needs a name");
+
+// FNV-1a with a seed mixed into the offset basis. The seed is searched for at compile time until every
+// event name lands in its own slot.
+static constexpr size_t kEventTableSize = 32;
+
+static constexpr uint32_t EventHash(std::string_view inName, uint32_t inSeed)
+{
+	uint32_t hash = 2166136261u ^ inSeed;
+	for (char c : inName) {
+		hash ^= static_cast<unsigned char>(c);
+		hash *= 16777619u;
+	}
+	return hash;
+}
+
+static constexpr bool IsPerfectSeed(uint32_t inSeed)
+{
+	bool used[kEventTableSize] = {};
+	for (const auto& entry : kEvents) {
+		auto slot = EventHash(entry.name, inSeed) % kEventTableSize;
+		if (used[slot]) {
+			return false;
+		}
+		used[slot] = true;
+	}
+	return true;
+}
+
+static constexpr uint32_t FindPerfectSeed()
+{
+	for (uint32_t seed = 0; seed < 4096; ++seed) {
+		if (IsPerfectSeed(seed)) {
+			return seed;
+		}
+	}
+	return UINT32_MAX;
+}
+
+static constexpr uint32_t kEventSeed = FindPerfectSeed();
+static_assert(kEventSeed != UINT32_MAX, "no perfect hash seed for the event names, grow kEventTableSize");
+
+static constexpr std::array<ESDEventEntry, kEventTableSize> BuildEventTable()
+{
+	std::array<ESDEventEntry, kEventTableSize> table = {};
+	for (const auto& entry : kEvents) {
+		table[EventHash(entry.name, kEventSeed) % kEventTableSize] = entry;
+	}
+	return table;
+}
+
+static constexpr auto kEventTable = BuildEventTable();
+
+static constexpr ESDEventType LookupEvent(std::string_view inName)
+{
+	const auto& entry = kEventTable[EventHash(inName, kEventSeed) % kEventTableSize];
+	return entry.name == inName && !inName.empty() ? entry.type : ESDEventType::Unknown;
+}
+
+static_assert(LookupEvent(kESDSDKEventKeyDown) == ESDEventType::KeyDown, "event table is broken");
+static_assert(LookupEvent(kESDSDKEventSendToPlugin) == ESDEventType::SendToPlugin, "event table is broken");
+static_assert(LookupEvent(kESDSDKEventSetTitle) == ESDEventType::Unknown, "event table is broken");
+
+ESDEventType ESDEventTypeFromName(std::string_view inName)
+{
+	return LookupEvent(inName);
+}
+
+const char* ESDEventName(ESDEventType inType)
+{
+	for (const auto& entry : kEvents) {
+		if (entry.type == inType) {
+			return entry.name.data();
+		}
+	}
+	return "unknown";
+}
+
+// Fills an ESDInboundEvent from the parser's callbacks. Values of the top-level members we know are stored
+// directly, the payload and deviceInfo objects are handed to nlohmann's own DOM builder, and anything else
+// is only counted in and out.
+class ESDInboundHandler
+{
+public:
+	using number_integer_t = json::number_integer_t;
+	using number_unsigned_t = json::number_unsigned_t;
+	using number_float_t = json::number_float_t;
+	using string_t = json::string_t;
+
+	explicit ESDInboundHandler(ESDInboundEvent& ioEvent) : mEvent(ioEvent) { }
+
+	bool null() { return !mBuilder || mBuilder->null(); }
+	bool boolean(bool inValue) { return !mBuilder || mBuilder->boolean(inValue); }
+	bool number_integer(number_integer_t inValue) { return !mBuilder || mBuilder->number_integer(inValue); }
+	bool number_unsigned(number_unsigned_t inValue) { return !mBuilder || mBuilder->number_unsigned(inValue); }
+	bool number_float(number_float_t inValue, const string_t& inText) { return !mBuilder || mBuilder->number_float(inValue, inText); }
+
+	bool string(string_t& inValue)
+	{
+		if (mBuilder) {
+			return mBuilder->string(inValue);
+		}
+		if (mDepth == 1) {
+			switch (mMember) {
+			case Member::Event: mEvent.type = LookupEvent(inValue); break;
+			case Member::Action: mEvent.action.assign(inValue); break;
+			case Member::Context: mEvent.context.assign(inValue); break;
+			case Member::Device: mEvent.deviceID.assign(inValue); break;
+			default: break;
+			}
+		}
+		return true;
+	}
+
+	bool key(string_t& inKey)
+	{
+		if (mBuilder) {
+			return mBuilder->key(inKey);
+		}
+		if (mDepth == 1) {
+			mMember = MemberFromKey(inKey);
+		}
+		return true;
+	}
+
+	bool start_object(size_t inElements)
+	{
+		++mDepth;
+		if (mDepth == 1) {
+			mSawObject = true;
+		}
+		else if (!mBuilder && mDepth == 2) {
+			if (mMember == Member::Payload) {
+				mBuilder.emplace(mEvent.payload);
+				mBuildDepth = mDepth;
+			}
+			else if (mMember == Member::DeviceInfo) {
+				mBuilder.emplace(mEvent.deviceInfo);
+				mBuildDepth = mDepth;
+			}
+		}
+		return !mBuilder || mBuilder->start_object(inElements);
+	}
+
+	bool end_object()
+	{
+		bool result = !mBuilder || mBuilder->end_object();
+		if (mBuilder && mDepth == mBuildDepth) {
+			mBuilder.reset();
+		}
+		--mDepth;
+		return result;
+	}
+
+	bool start_array(size_t inElements)
+	{
+		// A message is always an object
+		if (mDepth == 0) {
+			return false;
+		}
+		++mDepth;
+		return !mBuilder || mBuilder->start_array(inElements);
+	}
+
+	bool end_array()
+	{
+		--mDepth;
+		return !mBuilder || mBuilder->end_array();
+	}
+
+	bool parse_error(size_t, const std::string&, const nlohmann::detail::exception&)
+	{
+		return false;
+	}
+
+	bool IsComplete() const { return mSawObject && mDepth == 0; }
+
+private:
+	enum class Member
+	{
+		Other,
+		Event,
+		Action,
+		Context,
+		Device,
+		Payload,
+		DeviceInfo
+	};
+
+	static Member MemberFromKey(const std::string& inKey)
+	{
+		if (inKey == kESDSDKCommonEvent) return Member::Event;
+		if (inKey == kESDSDKCommonAction) return Member::Action;
+		if (inKey == kESDSDKCommonContext) return Member::Context;
+		if (inKey == kESDSDKCommonDevice) return Member::Device;
+		if (inKey == kESDSDKCommonPayload) return Member::Payload;
+		if (inKey == kESDSDKCommonDeviceInfo) return Member::DeviceInfo;
+		return Member::Other;
+	}
+
+	ESDInboundEvent& mEvent;
+	std::optional<nlohmann::detail::json_sax_dom_parser<json>> mBuilder;
+	int mDepth = 0;
+	int mBuildDepth = 0;
+	Member mMember = Member::Other;
+	bool mSawObject = false;
+};
+
+bool ESDDecodeInboundEvent(std::string_view inMessage, ESDInboundEvent& ioEvent)
+{
+	ioEvent.type = ESDEventType::Unknown;
+	ioEvent.action.clear();
+	ioEvent.context.clear();
+	ioEvent.deviceID.clear();
+	ioEvent.payload = nullptr;
+	ioEvent.deviceInfo = nullptr;
+
+	ESDInboundHandler handler(ioEvent);
+	return json::sax_parse(inMessage.data(), inMessage.data() + inMessage.size(), &handler) && handler.IsComplete();
+}
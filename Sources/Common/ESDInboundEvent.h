@@ -0,0 +1,64 @@
+//==============================================================================
+/**
+@file       ESDInboundEvent.h
+
+@brief      Decodes messages from the Stream Deck application into typed events
+
+@copyright  (c) 2021, bionyx187
+			This source code is licensed under the MIT-style license found in the LICENSE file.
+
+**/
+//==============================================================================
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+// Every event the Stream Deck application sends to a plugin
+enum class ESDEventType : uint8_t
+{
+	Unknown,
+	KeyDown,
+	KeyUp,
+	WillAppear,
+	WillDisappear,
+	DeviceDidConnect,
+	DeviceDidDisconnect,
+	ApplicationDidLaunch,
+	ApplicationDidTerminate,
+	SystemDidWakeUp,
+	TitleParametersDidChange,
+	DidReceiveSettings,
+	DidReceiveGlobalSettings,
+	PropertyInspectorDidAppear,
+	PropertyInspectorDidDisappear,
+	SendToPlugin,
+
+	Count
+};
+
+// Looks the name up in a perfect hash table built at compile time: one hash and one string compare.
+// Returns Unknown for anything that isn't an event name.
+ESDEventType ESDEventTypeFromName(std::string_view inName);
+
+// The kESDSDKEvent* literal for the type, or "unknown"
+const char* ESDEventName(ESDEventType inType);
+
+// One decoded message. The connection keeps a single instance and decodes every message into it, so the
+// strings keep their capacity from one message to the next and the handlers get references to them.
+struct ESDInboundEvent
+{
+	ESDEventType type = ESDEventType::Unknown;
+	std::string action;
+	std::string context;
+	std::string deviceID;
+	json payload;		// null unless the message has a payload object
+	json deviceInfo;	// deviceDidConnect only
+};
+
+// Decodes straight from the message text with the SAX parser. Only the payload and deviceInfo objects
+// are built as json; every other member is skipped without being stored. Returns false if the message
+// isn't a JSON object, in which case ioEvent is left half filled and shouldn't be used.
+bool ESDDecodeInboundEvent(std::string_view inMessage, ESDInboundEvent& ioEvent);
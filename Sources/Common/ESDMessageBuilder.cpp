@@ -0,0 +1,122 @@
+//==============================================================================
+/**
+@file       ESDMessageBuilder.cpp
+
+@brief      Writes the wire format of the frequent outbound messages without building a JSON DOM
+
+@copyright  (c) 2021, bionyx187
+			This source code is licensed under the MIT-style license found in the LICENSE file.
+
+**/
+//==============================================================================
+
+#include "ESDMessageBuilder.h"
+
+#include <charconv>
+
+//
+// Templates. The pieces between them are the spliced values.
+//
+
+static constexpr std::string_view kContextPrefix = "{\"" kESDSDKCommonContext "\":\"";
+
+static constexpr std::string_view kSetTitleInfix = "\",\"" kESDSDKCommonEvent "\":\"" kESDSDKEventSetTitle "\",\"" kESDSDKCommonPayload "\":{\"" kESDSDKPayloadTarget "\":";
+static constexpr std::string_view kSetTitleTitle = ",\"" kESDSDKPayloadTitle "\":\"";
+static constexpr std::string_view kSetTitleSuffix = "\"}}";
+
+static constexpr std::string_view kSetImageInfix = "\",\"" kESDSDKCommonEvent "\":\"" kESDSDKEventSetImage "\",\"" kESDSDKCommonPayload "\":{\"" kESDSDKPayloadImage "\":\"";
+static constexpr std::string_view kSetImageTarget = "\",\"" kESDSDKPayloadTarget "\":";
+static constexpr std::string_view kSetImageSuffix = "}}";
+static constexpr std::string_view kImageDataPrefix = "data:image/png;base64,";
+
+static constexpr std::string_view kSetStateInfix = "\",\"" kESDSDKCommonEvent "\":\"" kESDSDKEventSetState "\",\"" kESDSDKCommonPayload "\":{\"" kESDSDKPayloadState "\":";
+static constexpr std::string_view kSetStateSuffix = "}}";
+
+static constexpr std::string_view kLogMessagePrefix = "{\"" kESDSDKCommonEvent "\":\"" kESDSDKEventLogMessage "\",\"" kESDSDKCommonPayload "\":{\"" kESDSDKPayloadMessage "\":\"";
+static constexpr std::string_view kLogMessageSuffix = "\"}}";
+
+void ESDMessageBuilder::SetTitle(std::string& outBuffer, std::string_view inTitle, std::string_view inContext, ESDSDKTarget inTarget)
+{
+	outBuffer.clear();
+	outBuffer.append(kContextPrefix);
+	AppendEscaped(outBuffer, inContext);
+	outBuffer.append(kSetTitleInfix);
+	AppendInt(outBuffer, inTarget);
+	outBuffer.append(kSetTitleTitle);
+	AppendEscaped(outBuffer, inTitle);
+	outBuffer.append(kSetTitleSuffix);
+}
+
+void ESDMessageBuilder::SetImage(std::string& outBuffer, std::string_view inBase64ImageString, std::string_view inContext, ESDSDKTarget inTarget)
+{
+	outBuffer.clear();
+	outBuffer.append(kContextPrefix);
+	AppendEscaped(outBuffer, inContext);
+	outBuffer.append(kSetImageInfix);
+	// Base64 never needs escaping, only the data URI prefix may need adding
+	if (!inBase64ImageString.empty() && inBase64ImageString.substr(0, kImageDataPrefix.size()) != kImageDataPrefix) {
+		outBuffer.append(kImageDataPrefix);
+	}
+	AppendEscaped(outBuffer, inBase64ImageString);
+	outBuffer.append(kSetImageTarget);
+	AppendInt(outBuffer, inTarget);
+	outBuffer.append(kSetImageSuffix);
+}
+
+void ESDMessageBuilder::SetState(std::string& outBuffer, int inState, std::string_view inContext)
+{
+	outBuffer.clear();
+	outBuffer.append(kContextPrefix);
+	AppendEscaped(outBuffer, inContext);
+	outBuffer.append(kSetStateInfix);
+	AppendInt(outBuffer, inState);
+	outBuffer.append(kSetStateSuffix);
+}
+
+void ESDMessageBuilder::LogMessage(std::string& outBuffer, std::string_view inMessage)
+{
+	outBuffer.clear();
+	outBuffer.append(kLogMessagePrefix);
+	AppendEscaped(outBuffer, inMessage);
+	outBuffer.append(kLogMessageSuffix);
+}
+
+void ESDMessageBuilder::AppendEscaped(std::string& outBuffer, std::string_view inString)
+{
+	static constexpr char kHex[] = "0123456789abcdef";
+
+	// Copy runs of characters that need no escaping in one go. UTF-8 sequences pass through untouched.
+	size_t runStart = 0;
+	for (size_t i = 0; i < inString.size(); ++i) {
+		auto c = static_cast<unsigned char>(inString[i]);
+		if (c >= 0x20 && c != '"' && c != '\\') {
+			continue;
+		}
+
+		outBuffer.append(inString.data() + runStart, i - runStart);
+		runStart = i + 1;
+		switch (c) {
+		case '"': outBuffer.append("\\\""); break;
+		case '\\': outBuffer.append("\\\\"); break;
+		case '\b': outBuffer.append("\\b"); break;
+		case '\f': outBuffer.append("\\f"); break;
+		case '\n': outBuffer.append("\\n"); break;
+		case '\r': outBuffer.append("\\r"); break;
+		case '\t': outBuffer.append("\\t"); break;
+		default:
+		{
+			char escaped[] = { '\\', 'u', '0', '0', kHex[c >> 4], kHex[c & 0xF] };
+			outBuffer.append(escaped, sizeof(escaped));
+			break;
+		}
+		}
+	}
+	outBuffer.append(inString.data() + runStart, inString.size() - runStart);
+}
+
+void ESDMessageBuilder::AppendInt(std::string& outBuffer, int inValue)
+{
+	char digits[16];
+	auto result = std::to_chars(digits, digits + sizeof(digits), inValue);
+	outBuffer.append(digits, result.ptr - digits);
+}
@@ -0,0 +1,36 @@
+//==============================================================================
+/**
+@file       ESDMessageBuilder.h
+
+@brief      Writes the wire format of the frequent outbound messages without building a JSON DOM
+
+@copyright  (c) 2021, bionyx187
+			This source code is licensed under the MIT-style license found in the LICENSE file.
+
+**/
+//==============================================================================
+
+#pragma once
+
+#include "ESDSDKDefines.h"
+
+#include <string>
+#include <string_view>
+
+// The output is byte-for-byte what json::dump() produces for the same message (keys in
+// sorted order, no whitespace), with only the context and the string values spliced into
+// fixed templates. Every function clears and reuses outBuffer, so a buffer that is kept
+// around stops allocating once it has grown to the largest message.
+class ESDMessageBuilder
+{
+public:
+	static void SetTitle(std::string& outBuffer, std::string_view inTitle, std::string_view inContext, ESDSDKTarget inTarget);
+	static void SetImage(std::string& outBuffer, std::string_view inBase64ImageString, std::string_view inContext, ESDSDKTarget inTarget);
+	static void SetState(std::string& outBuffer, int inState, std::string_view inContext);
+	static void LogMessage(std::string& outBuffer, std::string_view inMessage);
+
+private:
+	// Append inString as the body of a JSON string literal, escaping the way json::dump() does
+	static void AppendEscaped(std::string& outBuffer, std::string_view inString);
+	static void AppendInt(std::string& outBuffer, int inValue);
+};
@@ -0,0 +1,104 @@
+//==============================================================================
+/**
+@file       ESDOutboundQueue.cpp
+
+@brief      Latest-wins queue for the per-context messages sent every tick
+
+@copyright  (c) 2021, bionyx187
+			This source code is licensed under the MIT-style license found in the LICENSE file.
+
+**/
+//==============================================================================
+
+#include "ESDOutboundQueue.h"
+#include "../Metrics.h"
+
+#include <asio/post.hpp>
+
+// Above this many bytes waiting in websocketpp's send queue, we stop adding to it and let frames coalesce.
+static constexpr size_t kBackpressureLimit = 256 * 1024;
+static constexpr std::chrono::milliseconds kBackpressureRetry(20);
+
+ESDOutboundQueue::ESDOutboundQueue(asio::io_service& inIOService, Sender inSender, BufferedAmount inBufferedAmount) :
+	mIOService(inIOService),
+	mRetryTimer(inIOService),
+	mSender(std::move(inSender)),
+	mBufferedAmount(std::move(inBufferedAmount))
+{
+}
+
+ESDOutboundQueue::~ESDOutboundQueue()
+{
+	asio::error_code ec;
+	mRetryTimer.cancel(ec);
+}
+
+void ESDOutboundQueue::Enqueue(Kind inKind, const std::string& inContext, const Writer& inWriter)
+{
+	bool scheduleFlush = false;
+	{
+		std::lock_guard<std::mutex> lock(mMutex);
+		SlotKey key(inContext, inKind);
+		auto& slot = mSlots[key];
+		inWriter(slot.buffer);
+		slot.queuedAt = std::chrono::steady_clock::now();
+		if (slot.pending) {
+			mSuperseded.fetch_add(1, std::memory_order_relaxed);
+		}
+		else {
+			slot.pending = true;
+			mPendingOrder.push_back(std::move(key));
+		}
+
+		if (!mFlushScheduled) {
+			mFlushScheduled = true;
+			scheduleFlush = true;
+		}
+	}
+
+	if (scheduleFlush) {
+		asio::post(mIOService, [this]() { Flush(); });
+	}
+}
+
+void ESDOutboundQueue::Discard(const std::string& inContext)
+{
+	std::lock_guard<std::mutex> lock(mMutex);
+	mSlots.erase(SlotKey(inContext, Kind::Title));
+	mSlots.erase(SlotKey(inContext, Kind::Image));
+	// Entries left in mPendingOrder for this context are skipped by Flush since their slot is gone.
+}
+
+void ESDOutboundQueue::Flush()
+{
+	auto buffered = mBufferedAmount();
+	Metrics::SetBufferedBytes(buffered);
+	if (buffered > kBackpressureLimit) {
+		// Leave mFlushScheduled set so producers only overwrite their slots until the retry.
+		mRetryTimer.expires_after(kBackpressureRetry);
+		mRetryTimer.async_wait([this](const asio::error_code& ec) {
+			if (ec != asio::error::operation_aborted) {
+				Flush();
+			}
+		});
+		return;
+	}
+
+	// Sending copies the bytes into a websocketpp message, so the slots can be reused as soon as this returns.
+	std::lock_guard<std::mutex> lock(mMutex);
+	auto now = std::chrono::steady_clock::now();
+	for (const auto& key : mPendingOrder) {
+		auto slot = mSlots.find(key);
+		if (slot == mSlots.end() || !slot->second.pending) {
+			continue;
+		}
+		mSender(slot->second.buffer);
+		slot->second.pending = false;
+		bool title = key.second == Kind::Title;
+		Metrics::Add(title ? MetricCounter::TitleMessagesSent : MetricCounter::ImageMessagesSent);
+		Metrics::Add(title ? MetricCounter::TitleBytesSent : MetricCounter::ImageBytesSent, slot->second.buffer.size());
+		mSendLatency[static_cast<int>(key.second)].Record(now - slot->second.queuedAt);
+	}
+	mPendingOrder.clear();
+	mFlushScheduled = false;
+}
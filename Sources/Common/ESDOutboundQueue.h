@@ -0,0 +1,85 @@
+//==============================================================================
+/**
+@file       ESDOutboundQueue.h
+
+@brief      Latest-wins queue for the per-context messages sent every tick
+
+@copyright  (c) 2021, bionyx187
+			This source code is licensed under the MIT-style license found in the LICENSE file.
+
+**/
+//==============================================================================
+
+#pragma once
+
+#include <atomic>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <asio/io_service.hpp>
+#include <asio/steady_timer.hpp>
+
+#include "../LatencyHistogram.h"
+
+// Keeps at most one pending message per (context, kind). Queuing a message for a slot that
+// hasn't been flushed yet replaces it, so a slow Stream Deck application gets the newest frame
+// instead of a backlog. Everything pending is flushed in one handler on the io_service, which
+// lets websocketpp gather it into a single write. While the connection still has more than
+// the backpressure limit buffered, the flush is retried later and frames keep coalescing.
+class ESDOutboundQueue
+{
+public:
+	enum class Kind
+	{
+		Title,
+		Image
+	};
+
+	using Writer = std::function<void(std::string& outBuffer)>;
+	using Sender = std::function<void(const std::string& inMessage)>;
+	using BufferedAmount = std::function<size_t()>;
+
+	ESDOutboundQueue(asio::io_service& inIOService, Sender inSender, BufferedAmount inBufferedAmount);
+	~ESDOutboundQueue();
+
+	// inWriter fills the slot's buffer, which keeps its capacity from the previous frame. Safe to call from any thread.
+	void Enqueue(Kind inKind, const std::string& inContext, const Writer& inWriter);
+
+	// Drop anything pending for a context that went away
+	void Discard(const std::string& inContext);
+
+	unsigned long long SupersededCount() const { return mSuperseded.load(std::memory_order_relaxed); }
+
+	// Time from a message being queued to it being handed to websocketpp. A superseded message counts from
+	// when the one that replaced it was queued.
+	const LatencyHistogram& SendLatency(Kind inKind) const { return mSendLatency[static_cast<int>(inKind)]; }
+
+private:
+	using SlotKey = std::pair<std::string, Kind>;
+
+	struct Slot
+	{
+		std::string buffer;
+		bool pending = false;
+		std::chrono::steady_clock::time_point queuedAt;
+	};
+
+	void Flush();
+
+	asio::io_service& mIOService;
+	asio::steady_timer mRetryTimer;
+	Sender mSender;
+	BufferedAmount mBufferedAmount;
+
+	std::map<SlotKey, Slot> mSlots;
+	std::vector<SlotKey> mPendingOrder;
+	bool mFlushScheduled = false;
+	std::mutex mMutex; // protects mSlots, mPendingOrder, mFlushScheduled
+
+	std::atomic<unsigned long long> mSuperseded{ 0 };
+	LatencyHistogram mSendLatency[2];
+};
@@ -28,5 +28,12 @@ public:
 	
 	// Get the path of the .sdPlugin bundle
 	static std::string GetPluginPath();
+
+	// Get the path of a folder of the given name for this user's data, creating it if needed.
+	// Return an empty string if error
+	static std::string GetUserDataPath(const std::string& inFolderName);
+
+	// Resident memory of this process in bytes, or 0 if it can't be found out
+	static size_t GetResidentMemory();
 };
 
@@ -0,0 +1,141 @@
+//==============================================================================
+/**
+@file       ESDUtilitiesLinux.cpp
+
+@brief      Various filesystem and other utility functions
+
+@copyright  (c) 2021, bionyx187
+			This source code is licensed under the MIT-style license found in the LICENSE file.
+
+**/
+//==============================================================================
+
+#include "ESDUtilities.h"
+
+#include <cerrno>
+#include <climits>
+#include <cstdio>
+#include <cstdlib>
+
+#include <sys/stat.h>
+#include <unistd.h>
+
+
+static bool HasSuffix(const std::string& inString, const std::string& inSuffix)
+{
+	return (inString.length() >= inSuffix.length()) && (inSuffix.length() > 0) && (inString.compare(inString.size() - inSuffix.size(), inSuffix.size(), inSuffix) == 0);
+}
+
+static std::string RemoveTrailingDelimiters(std::string inPath)
+{
+	while (inPath.length() > 1 && HasSuffix(inPath, "/")) {
+		inPath.pop_back();
+	}
+	return inPath;
+}
+
+void ESDUtilities::DoSleep(int inMilliseconds)
+{
+	usleep(1000 * inMilliseconds);
+}
+
+std::string ESDUtilities::AddPathComponent(const std::string &inPath, const std::string &inComponentToAdd)
+{
+	if (inPath.empty()) {
+		return inComponentToAdd;
+	}
+
+	bool pathEndsWithDelimiter = inPath.back() == '/';
+	bool compStartsWithDelimiter = !inComponentToAdd.empty() && inComponentToAdd.front() == '/';
+
+	if (pathEndsWithDelimiter && compStartsWithDelimiter) {
+		return inPath + inComponentToAdd.substr(1);
+	}
+	if (pathEndsWithDelimiter || compStartsWithDelimiter) {
+		return inPath + inComponentToAdd;
+	}
+	return inPath + '/' + inComponentToAdd;
+}
+
+std::string ESDUtilities::GetFolderPath(const std::string& inPath)
+{
+	std::string path = RemoveTrailingDelimiters(inPath);
+	size_t pos = path.find_last_of('/');
+	if (pos == std::string::npos) {
+		return "";
+	}
+	if (pos == 0) {
+		return "/";
+	}
+	return RemoveTrailingDelimiters(path.substr(0, pos));
+}
+
+std::string ESDUtilities::GetPluginPath()
+{
+	static std::string sPluginPath;
+
+	// The executable sits somewhere inside the .sdPlugin folder, like on the Mac
+	if (sPluginPath.empty()) {
+		char executable[PATH_MAX];
+		ssize_t length = readlink("/proc/self/exe", executable, sizeof(executable) - 1);
+		if (length > 0) {
+			std::string path = GetFolderPath(std::string(executable, length));
+			while (!path.empty() && path != "/") {
+				if (HasSuffix(path, ".sdPlugin")) {
+					sPluginPath = path;
+					break;
+				}
+				path = GetFolderPath(path);
+			}
+		}
+	}
+
+	return sPluginPath;
+}
+
+std::string ESDUtilities::GetUserDataPath(const std::string& inFolderName)
+{
+	// $XDG_DATA_HOME, which defaults to ~/.local/share
+	std::string base;
+	const char* dataHome = std::getenv("XDG_DATA_HOME");
+	const char* home = std::getenv("HOME");
+	if (dataHome != nullptr && dataHome[0] == '/') {
+		base = dataHome;
+	}
+	else if (home != nullptr && home[0] == '/') {
+		base = AddPathComponent(home, ".local/share");
+	}
+	else {
+		return "";
+	}
+
+	// Create every missing folder on the way
+	std::string path = AddPathComponent(base, inFolderName);
+	for (size_t pos = path.find('/', 1); ; pos = path.find('/', pos + 1)) {
+		std::string folder = path.substr(0, pos);
+		if (mkdir(folder.c_str(), 0700) != 0 && errno != EEXIST) {
+			return "";
+		}
+		if (pos == std::string::npos) {
+			break;
+		}
+	}
+	return path;
+}
+
+size_t ESDUtilities::GetResidentMemory()
+{
+	// The second field of statm is the resident set, in pages
+	FILE* statm = std::fopen("/proc/self/statm", "r");
+	if (statm == nullptr) {
+		return 0;
+	}
+	unsigned long size = 0;
+	unsigned long resident = 0;
+	int fields = std::fscanf(statm, "%lu %lu", &size, &resident);
+	std::fclose(statm);
+	if (fields != 2) {
+		return 0;
+	}
+	return static_cast<size_t>(resident) * static_cast<size_t>(sysconf(_SC_PAGESIZE));
+}
@@ -12,6 +12,10 @@
 
 #include "ESDUtilities.h"
 #include <CoreFoundation/CoreFoundation.h>
+#include <mach/mach.h>
+#include <sys/stat.h>
+#include <cerrno>
+#include <cstdlib>
 
 
 static std::string CFStringGetStdString(CFStringRef inStringRef, CFStringEncoding inEncoding)
@@ -186,3 +190,30 @@ std::string ESDUtilities::GetPluginPath()
 	return sPluginPath;
 }
 
+std::string ESDUtilities::GetUserDataPath(const std::string& inFolderName)
+{
+	// ~/Library/Application Support, which always exists
+	const char* home = getenv("HOME");
+	if(home == NULL || home[0] != '/')
+	{
+		return "";
+	}
+
+	std::string path = AddPathComponent(AddPathComponent(home, "Library/Application Support"), inFolderName);
+	if(mkdir(path.c_str(), 0700) != 0 && errno != EEXIST)
+	{
+		return "";
+	}
+	return path;
+}
+
+size_t ESDUtilities::GetResidentMemory()
+{
+	mach_task_basic_info_data_t info;
+	mach_msg_type_number_t count = MACH_TASK_BASIC_INFO_COUNT;
+	if(task_info(mach_task_self(), MACH_TASK_BASIC_INFO, reinterpret_cast<task_info_t>(&info), &count) != KERN_SUCCESS)
+	{
+		return 0;
+	}
+	return info.resident_size;
+}
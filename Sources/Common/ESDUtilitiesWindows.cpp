@@ -12,6 +12,10 @@
 
 #include "ESDUtilities.h"
 
+#include <psapi.h>
+
+#pragma comment(lib, "psapi")
+
 void ESDUtilities::DoSleep(int inMilliseconds)
 {
 	Sleep(inMilliseconds);
@@ -276,3 +280,32 @@ std::string ESDUtilities::GetPluginPath()
 
 	return sPluginPath;
 }
+
+std::string ESDUtilities::GetUserDataPath(const std::string& inFolderName)
+{
+	char localAppData[MAX_PATH] = { 0 };
+	DWORD length = GetEnvironmentVariableA("LOCALAPPDATA", localAppData, MAX_PATH);
+	if (length == 0 || length >= MAX_PATH)
+	{
+		DebugPrint("Could not get LOCALAPPDATA.\n");
+		return "";
+	}
+
+	std::string path = AddPathComponent(localAppData, inFolderName);
+	if (!CreateDirectoryA(path.c_str(), NULL) && GetLastError() != ERROR_ALREADY_EXISTS)
+	{
+		DebugPrint("Could not create %s.\n", path.c_str());
+		return "";
+	}
+	return path;
+}
+
+size_t ESDUtilities::GetResidentMemory()
+{
+	PROCESS_MEMORY_COUNTERS counters = { 0 };
+	if (!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+	{
+		return 0;
+	}
+	return counters.WorkingSetSize;
+}
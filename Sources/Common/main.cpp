@@ -14,14 +14,19 @@
 #include "../MediaStreamDeckPlugin.h"
 #include "ESDLocalizer.h"
 #include "EPLJSONUtils.h"
+
+#ifdef _WIN32
 #include <winrt/base.h>
 #include "../Windows/pch.h"
 
 using namespace winrt;
+#endif
 
 int main(int argc, const char* const argv[])
 {
+#ifdef _WIN32
 	winrt::init_apartment();
+#endif
 	if (argc != 9)
 	{
 		DebugPrint("Invalid number of parameters %d instead of 9\n", argc);
@@ -0,0 +1,140 @@
+//==============================================================================
+/**
+@file       FontMetrics.cpp
+
+@brief      Advance widths of the title fonts Stream Deck offers, to fit titles by pixels
+
+@copyright  (c) 2021, bionyx187
+			This source code is licensed under the MIT-style license found in the LICENSE file.
+
+**/
+//==============================================================================
+
+#include "FontMetrics.h"
+
+// Advance widths of U+0020 to U+007E in thousandths of an em, from the Adobe core font AFMs
+static constexpr uint16_t kHelvetica[95] = {
+	278, 278, 355, 556, 556, 889, 667, 191, 333, 333, 389, 584, 278, 333, 278, 278,	// space to /
+	556, 556, 556, 556, 556, 556, 556, 556, 556, 556, 278, 278, 584, 584, 584, 556,	// 0 to ?
+	1015, 667, 667, 722, 722, 667, 611, 778, 722, 278, 500, 667, 556, 833, 722, 778,// @ to O
+	667, 778, 722, 667, 611, 722, 667, 944, 667, 667, 611, 278, 278, 278, 469, 556,	// P to _
+	333, 556, 556, 500, 556, 556, 278, 556, 556, 222, 222, 500, 222, 833, 556, 556,	// ` to o
+	556, 556, 333, 500, 278, 556, 500, 722, 500, 500, 500, 334, 260, 334, 584		// p to ~
+};
+
+static constexpr uint16_t kHelveticaBold[95] = {
+	278, 333, 474, 556, 556, 889, 722, 238, 333, 333, 389, 584, 278, 333, 278, 278,
+	556, 556, 556, 556, 556, 556, 556, 556, 556, 556, 333, 333, 584, 584, 584, 611,
+	975, 722, 722, 722, 722, 667, 611, 778, 722, 278, 556, 722, 611, 833, 722, 778,
+	667, 778, 722, 667, 611, 722, 667, 944, 667, 667, 611, 333, 278, 333, 584, 556,
+	333, 556, 611, 556, 611, 556, 333, 611, 611, 278, 278, 556, 278, 889, 611, 611,
+	611, 611, 389, 556, 333, 611, 556, 778, 556, 556, 500, 389, 280, 389, 584
+};
+
+static constexpr uint16_t kTimes[95] = {
+	250, 333, 408, 500, 500, 833, 778, 180, 333, 333, 500, 564, 250, 333, 250, 278,
+	500, 500, 500, 500, 500, 500, 500, 500, 500, 500, 278, 278, 564, 564, 564, 444,
+	921, 722, 667, 667, 722, 611, 556, 722, 722, 333, 389, 722, 611, 889, 722, 722,
+	556, 722, 667, 556, 611, 722, 722, 944, 722, 722, 611, 333, 278, 333, 469, 500,
+	333, 444, 500, 444, 500, 444, 333, 500, 500, 278, 278, 500, 278, 778, 500, 500,
+	500, 500, 333, 389, 278, 500, 500, 722, 500, 500, 444, 480, 200, 480, 541
+};
+
+static constexpr uint16_t kTimesBold[95] = {
+	250, 333, 555, 500, 500, 1000, 833, 278, 333, 333, 500, 570, 250, 333, 250, 278,
+	500, 500, 500, 500, 500, 500, 500, 500, 500, 500, 333, 333, 570, 570, 570, 500,
+	930, 722, 667, 722, 722, 667, 611, 778, 778, 389, 500, 778, 667, 944, 722, 778,
+	611, 778, 722, 556, 667, 722, 722, 1000, 722, 722, 667, 333, 278, 333, 581, 500,
+	333, 500, 556, 444, 556, 444, 333, 500, 556, 278, 333, 556, 278, 833, 556, 500,
+	556, 556, 444, 389, 333, 556, 500, 722, 500, 500, 444, 394, 220, 394, 520
+};
+
+static constexpr const uint16_t* kFaceTables[] = { kHelvetica, kHelveticaBold, kTimes, kTimesBold, nullptr };
+
+static_assert(kHelvetica['n' - 0x20] == 556 && kHelvetica['~' - 0x20] == 584, "Helvetica table is misaligned");
+static_assert(kHelveticaBold['n' - 0x20] == 611 && kHelveticaBold['~' - 0x20] == 584, "Helvetica Bold table is misaligned");
+static_assert(kTimes['n' - 0x20] == 500 && kTimes['~' - 0x20] == 541, "Times table is misaligned");
+static_assert(kTimesBold['n' - 0x20] == 556 && kTimesBold['~' - 0x20] == 520, "Times Bold table is misaligned");
+
+static constexpr int kMonoAdvance = 600;
+static constexpr int kWideAdvance = 1000;
+
+struct FontFamily
+{
+	const char* name;
+	FontFace regular;
+	FontFace bold;
+	int scalePercent;
+};
+
+// The families in Stream Deck's title font menu. The scales of families without a table are estimates of their
+// average character width against the table they use, and only need to be close enough to pick the right frames.
+static constexpr FontFamily kFamilies[] = {
+	{ "Arial", FontFace::Sans, FontFace::SansBold, 100 },
+	{ "Arial Black", FontFace::SansBold, FontFace::SansBold, 120 },
+	{ "Comic Sans MS", FontFace::Sans, FontFace::SansBold, 105 },
+	{ "Courier", FontFace::Mono, FontFace::Mono, 100 },
+	{ "Courier New", FontFace::Mono, FontFace::Mono, 100 },
+	{ "Georgia", FontFace::Serif, FontFace::SerifBold, 110 },
+	{ "Impact", FontFace::SansBold, FontFace::SansBold, 85 },
+	{ "Microsoft Sans Serif", FontFace::Sans, FontFace::SansBold, 100 },
+	{ "Tahoma", FontFace::Sans, FontFace::SansBold, 95 },
+	{ "Times New Roman", FontFace::Serif, FontFace::SerifBold, 100 },
+	{ "Trebuchet MS", FontFace::Sans, FontFace::SansBold, 97 },
+	{ "Verdana", FontFace::Sans, FontFace::SansBold, 115 },
+};
+
+TitleFont LookupTitleFont(const std::string& inFamily, const std::string& inStyle, int inSize)
+{
+	TitleFont font;
+	font.size = inSize > 0 ? inSize : 0;
+
+	bool bold = inStyle.find("Bold") != std::string::npos;
+	font.face = bold ? FontFace::SansBold : FontFace::Sans;
+	for (const auto& family : kFamilies) {
+		if (inFamily == family.name) {
+			font.face = bold ? family.bold : family.regular;
+			font.scalePercent = family.scalePercent;
+			break;
+		}
+	}
+	return font;
+}
+
+// Advance in thousandths of an em
+static int EmAdvance(FontFace inFace, char32_t inCodePoint, GraphemeWidthClass inWidth)
+{
+	switch (inWidth) {
+	case GraphemeWidthClass::Zero:
+		return 0;
+	case GraphemeWidthClass::Wide:
+		return inFace == FontFace::Mono ? 2 * kMonoAdvance : kWideAdvance;
+	default:
+		break;
+	}
+
+	auto table = kFaceTables[static_cast<int>(inFace)];
+	if (table == nullptr) {
+		return kMonoAdvance;
+	}
+	if (inCodePoint >= 0x20 && inCodePoint <= 0x7E) {
+		return table[inCodePoint - 0x20];
+	}
+	if (inCodePoint == 0xA0) {
+		return table[0];
+	}
+	if (inCodePoint == 0x2026) {
+		return kWideAdvance; // the ellipsis is an em in all four tables
+	}
+	return table['n' - 0x20];
+}
+
+int GlyphAdvance(const TitleFont& inFont, char32_t inCodePoint)
+{
+	return EmAdvance(inFont.face, inCodePoint, GetGraphemeWidthClass(inCodePoint)) * inFont.size * inFont.scalePercent / 100;
+}
+
+int GlyphAdvance(const TitleFont& inFont, const Grapheme& inGrapheme)
+{
+	return EmAdvance(inFont.face, inGrapheme.base, inGrapheme.width) * inFont.size * inFont.scalePercent / 100;
+}
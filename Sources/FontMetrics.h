@@ -0,0 +1,65 @@
+//==============================================================================
+/**
+@file       FontMetrics.h
+
+@brief      Advance widths of the title fonts Stream Deck offers, to fit titles by pixels
+
+@copyright  (c) 2021, bionyx187
+			This source code is licensed under the MIT-style license found in the LICENSE file.
+
+**/
+//==============================================================================
+
+#pragma once
+
+#include "Graphemes.h"
+
+#include <cstdint>
+#include <string>
+
+// Width of the title area of a key, in pixels at the sizes titleParametersDidChange reports
+static constexpr int kKeyTitleWidth = 72;
+
+// The width tables we carry. Each is the metric-compatible PostScript core font (Helvetica for Arial,
+// Times for Times New Roman, Courier for Courier New), which is what the Windows fonts were designed
+// to match.
+enum class FontFace : uint8_t
+{
+	Sans,
+	SansBold,
+	Serif,
+	SerifBold,
+	Mono
+};
+
+// How a key draws its title
+struct TitleFont
+{
+	FontFace face = FontFace::Sans;
+	int scalePercent = 100;	// the family's widths relative to the face's table
+	int size = 0;			// 0 until the key's title parameters arrive
+
+	bool IsKnown() const { return size > 0; }
+
+	bool operator==(const TitleFont& inOther) const { return face == inOther.face && scalePercent == inOther.scalePercent && size == inOther.size; }
+	bool operator!=(const TitleFont& inOther) const { return !(*this == inOther); }
+	bool operator<(const TitleFont& inOther) const
+	{
+		if (face != inOther.face) return face < inOther.face;
+		if (scalePercent != inOther.scalePercent) return scalePercent < inOther.scalePercent;
+		return size < inOther.size;
+	}
+};
+
+// The font for fontFamily, fontStyle and fontSize from titleParameters. Families without a table of
+// their own use the closest one, scaled by how much wider or narrower the family runs on average.
+// Unknown families are measured as Arial. A size below 1 gives a font that isn't known.
+TitleFont LookupTitleFont(const std::string& inFamily, const std::string& inStyle, int inSize);
+
+// Advance of a code point in thousandths of a pixel. East Asian wide characters and emoji are an em,
+// marks that combine with the character before them are 0, and letters outside the tables are
+// measured like "n".
+int GlyphAdvance(const TitleFont& inFont, char32_t inCodePoint);
+
+// Advance of a whole cluster, which is that of its base drawn at the cluster's width
+int GlyphAdvance(const TitleFont& inFont, const Grapheme& inGrapheme);
@@ -0,0 +1,607 @@
+//==============================================================================
+/**
+@file       Graphemes.cpp
+
+@brief      Splits titles into user-perceived characters (extended grapheme clusters)
+
+@copyright  (c) 2021, bionyx187
+			This source code is licensed under the MIT-style license found in the LICENSE file.
+
+**/
+//==============================================================================
+
+#include "Graphemes.h"
+#include "UTFTranscode.h"
+
+#include <algorithm>
+#include <iterator>
+
+enum class BreakClass : uint8_t
+{
+	Other,
+	CR,
+	LF,
+	Control,
+	Extend,
+	ZWJ,
+	RegionalIndicator,
+	Prepend,
+	SpacingMark,
+	L,
+	V,
+	T,
+	LV,
+	LVT,
+	Pictographic,	// Extended_Pictographic, which is Other as far as Grapheme_Cluster_Break goes
+	Linker,			// Indic_Conjunct_Break=Linker, which is Extend
+	Consonant		// Indic_Conjunct_Break=Consonant, which is Other
+};
+
+// Where each run of code points with the same break class starts, from Grapheme_Cluster_Break, Extended_Pictographic
+// and Indic_Syllabic_Category in the Unicode 14 UCD. Hangul syllables are left as Other: LV and LVT alternate every
+// 28 code points, which GetBreakClass works out instead.
+struct BreakRun
+{
+	uint32_t first : 24;
+	BreakClass breakClass : 8;
+};
+
+static constexpr BreakRun kBreakRuns[] = {
+	{ 0x0000, BreakClass::Control }, { 0x000A, BreakClass::LF }, { 0x000B, BreakClass::Control },
+	{ 0x000D, BreakClass::CR }, { 0x000E, BreakClass::Control }, { 0x0020, BreakClass::Other },
+	{ 0x007F, BreakClass::Control }, { 0x00A0, BreakClass::Other }, { 0x00A9, BreakClass::Pictographic },
+	{ 0x00AA, BreakClass::Other }, { 0x00AD, BreakClass::Control }, { 0x00AE, BreakClass::Pictographic },
+	{ 0x00AF, BreakClass::Other }, { 0x0300, BreakClass::Extend }, { 0x0370, BreakClass::Other },
+	{ 0x0483, BreakClass::Extend }, { 0x048A, BreakClass::Other }, { 0x0591, BreakClass::Extend },
+	{ 0x05BE, BreakClass::Other }, { 0x05BF, BreakClass::Extend }, { 0x05C0, BreakClass::Other },
+	{ 0x05C1, BreakClass::Extend }, { 0x05C3, BreakClass::Other }, { 0x05C4, BreakClass::Extend },
+	{ 0x05C6, BreakClass::Other }, { 0x05C7, BreakClass::Extend }, { 0x05C8, BreakClass::Other },
+	{ 0x0600, BreakClass::Prepend }, { 0x0606, BreakClass::Other }, { 0x0610, BreakClass::Extend },
+	{ 0x061B, BreakClass::Other }, { 0x061C, BreakClass::Control }, { 0x061D, BreakClass::Other },
+	{ 0x064B, BreakClass::Extend }, { 0x0660, BreakClass::Other }, { 0x0670, BreakClass::Extend },
+	{ 0x0671, BreakClass::Other }, { 0x06D6, BreakClass::Extend }, { 0x06DD, BreakClass::Prepend },
+	{ 0x06DE, BreakClass::Other }, { 0x06DF, BreakClass::Extend }, { 0x06E5, BreakClass::Other },
+	{ 0x06E7, BreakClass::Extend }, { 0x06E9, BreakClass::Other }, { 0x06EA, BreakClass::Extend },
+	{ 0x06EE, BreakClass::Other }, { 0x070F, BreakClass::Prepend }, { 0x0710, BreakClass::Other },
+	{ 0x0711, BreakClass::Extend }, { 0x0712, BreakClass::Other }, { 0x0730, BreakClass::Extend },
+	{ 0x074B, BreakClass::Other }, { 0x07A6, BreakClass::Extend }, { 0x07B1, BreakClass::Other },
+	{ 0x07EB, BreakClass::Extend }, { 0x07F4, BreakClass::Other }, { 0x07FD, BreakClass::Extend },
+	{ 0x07FE, BreakClass::Other }, { 0x0816, BreakClass::Extend }, { 0x081A, BreakClass::Other },
+	{ 0x081B, BreakClass::Extend }, { 0x0824, BreakClass::Other }, { 0x0825, BreakClass::Extend },
+	{ 0x0828, BreakClass::Other }, { 0x0829, BreakClass::Extend }, { 0x082E, BreakClass::Other },
+	{ 0x0859, BreakClass::Extend }, { 0x085C, BreakClass::Other }, { 0x0890, BreakClass::Prepend },
+	{ 0x0892, BreakClass::Other }, { 0x0898, BreakClass::Extend }, { 0x08A0, BreakClass::Other },
+	{ 0x08CA, BreakClass::Extend }, { 0x08E2, BreakClass::Prepend }, { 0x08E3, BreakClass::Extend },
+	{ 0x0903, BreakClass::SpacingMark }, { 0x0904, BreakClass::Other }, { 0x0915, BreakClass::Consonant },
+	{ 0x093A, BreakClass::Extend }, { 0x093B, BreakClass::SpacingMark }, { 0x093C, BreakClass::Extend },
+	{ 0x093D, BreakClass::Other }, { 0x093E, BreakClass::SpacingMark }, { 0x0941, BreakClass::Extend },
+	{ 0x0949, BreakClass::SpacingMark }, { 0x094D, BreakClass::Linker }, { 0x094E, BreakClass::SpacingMark },
+	{ 0x0950, BreakClass::Other }, { 0x0951, BreakClass::Extend }, { 0x0958, BreakClass::Consonant },
+	{ 0x0960, BreakClass::Other }, { 0x0962, BreakClass::Extend }, { 0x0964, BreakClass::Other },
+	{ 0x0978, BreakClass::Consonant }, { 0x0980, BreakClass::Other }, { 0x0981, BreakClass::Extend },
+	{ 0x0982, BreakClass::SpacingMark }, { 0x0984, BreakClass::Other }, { 0x0995, BreakClass::Consonant },
+	{ 0x09A9, BreakClass::Other }, { 0x09AA, BreakClass::Consonant }, { 0x09B1, BreakClass::Other },
+	{ 0x09B2, BreakClass::Consonant }, { 0x09B3, BreakClass::Other }, { 0x09B6, BreakClass::Consonant },
+	{ 0x09BA, BreakClass::Other }, { 0x09BC, BreakClass::Extend }, { 0x09BD, BreakClass::Other },
+	{ 0x09BE, BreakClass::Extend }, { 0x09BF, BreakClass::SpacingMark }, { 0x09C1, BreakClass::Extend },
+	{ 0x09C5, BreakClass::Other }, { 0x09C7, BreakClass::SpacingMark }, { 0x09C9, BreakClass::Other },
+	{ 0x09CB, BreakClass::SpacingMark }, { 0x09CD, BreakClass::Linker }, { 0x09CE, BreakClass::Other },
+	{ 0x09D7, BreakClass::Extend }, { 0x09D8, BreakClass::Other }, { 0x09DC, BreakClass::Consonant },
+	{ 0x09DE, BreakClass::Other }, { 0x09DF, BreakClass::Consonant }, { 0x09E0, BreakClass::Other },
+	{ 0x09E2, BreakClass::Extend }, { 0x09E4, BreakClass::Other }, { 0x09F0, BreakClass::Consonant },
+	{ 0x09F2, BreakClass::Other }, { 0x09FE, BreakClass::Extend }, { 0x09FF, BreakClass::Other },
+	{ 0x0A01, BreakClass::Extend }, { 0x0A03, BreakClass::SpacingMark }, { 0x0A04, BreakClass::Other },
+	{ 0x0A3C, BreakClass::Extend }, { 0x0A3D, BreakClass::Other }, { 0x0A3E, BreakClass::SpacingMark },
+	{ 0x0A41, BreakClass::Extend }, { 0x0A43, BreakClass::Other }, { 0x0A47, BreakClass::Extend },
+	{ 0x0A49, BreakClass::Other }, { 0x0A4B, BreakClass::Extend }, { 0x0A4E, BreakClass::Other },
+	{ 0x0A51, BreakClass::Extend }, { 0x0A52, BreakClass::Other }, { 0x0A70, BreakClass::Extend },
+	{ 0x0A72, BreakClass::Other }, { 0x0A75, BreakClass::Extend }, { 0x0A76, BreakClass::Other },
+	{ 0x0A81, BreakClass::Extend }, { 0x0A83, BreakClass::SpacingMark }, { 0x0A84, BreakClass::Other },
+	{ 0x0A95, BreakClass::Consonant }, { 0x0AA9, BreakClass::Other }, { 0x0AAA, BreakClass::Consonant },
+	{ 0x0AB1, BreakClass::Other }, { 0x0AB2, BreakClass::Consonant }, { 0x0AB4, BreakClass::Other },
+	{ 0x0AB5, BreakClass::Consonant }, { 0x0ABA, BreakClass::Other }, { 0x0ABC, BreakClass::Extend },
+	{ 0x0ABD, BreakClass::Other }, { 0x0ABE, BreakClass::SpacingMark }, { 0x0AC1, BreakClass::Extend },
+	{ 0x0AC6, BreakClass::Other }, { 0x0AC7, BreakClass::Extend }, { 0x0AC9, BreakClass::SpacingMark },
+	{ 0x0ACA, BreakClass::Other }, { 0x0ACB, BreakClass::SpacingMark }, { 0x0ACD, BreakClass::Linker },
+	{ 0x0ACE, BreakClass::Other }, { 0x0AE2, BreakClass::Extend }, { 0x0AE4, BreakClass::Other },
+	{ 0x0AF9, BreakClass::Consonant }, { 0x0AFA, BreakClass::Extend }, { 0x0B00, BreakClass::Other },
+	{ 0x0B01, BreakClass::Extend }, { 0x0B02, BreakClass::SpacingMark }, { 0x0B04, BreakClass::Other },
+	{ 0x0B15, BreakClass::Consonant }, { 0x0B29, BreakClass::Other }, { 0x0B2A, BreakClass::Consonant },
+	{ 0x0B31, BreakClass::Other }, { 0x0B32, BreakClass::Consonant }, { 0x0B34, BreakClass::Other },
+	{ 0x0B35, BreakClass::Consonant }, { 0x0B3A, BreakClass::Other }, { 0x0B3C, BreakClass::Extend },
+	{ 0x0B3D, BreakClass::Other }, { 0x0B3E, BreakClass::Extend }, { 0x0B40, BreakClass::SpacingMark },
+	{ 0x0B41, BreakClass::Extend }, { 0x0B45, BreakClass::Other }, { 0x0B47, BreakClass::SpacingMark },
+	{ 0x0B49, BreakClass::Other }, { 0x0B4B, BreakClass::SpacingMark }, { 0x0B4D, BreakClass::Linker },
+	{ 0x0B4E, BreakClass::Other }, { 0x0B55, BreakClass::Extend }, { 0x0B58, BreakClass::Other },
+	{ 0x0B5C, BreakClass::Consonant }, { 0x0B5E, BreakClass::Other }, { 0x0B5F, BreakClass::Consonant },
+	{ 0x0B60, BreakClass::Other }, { 0x0B62, BreakClass::Extend }, { 0x0B64, BreakClass::Other },
+	{ 0x0B71, BreakClass::Consonant }, { 0x0B72, BreakClass::Other }, { 0x0B82, BreakClass::Extend },
+	{ 0x0B83, BreakClass::Other }, { 0x0BBE, BreakClass::Extend }, { 0x0BBF, BreakClass::SpacingMark },
+	{ 0x0BC0, BreakClass::Extend }, { 0x0BC1, BreakClass::SpacingMark }, { 0x0BC3, BreakClass::Other },
+	{ 0x0BC6, BreakClass::SpacingMark }, { 0x0BC9, BreakClass::Other }, { 0x0BCA, BreakClass::SpacingMark },
+	{ 0x0BCD, BreakClass::Extend }, { 0x0BCE, BreakClass::Other }, { 0x0BD7, BreakClass::Extend },
+	{ 0x0BD8, BreakClass::Other }, { 0x0C00, BreakClass::Extend }, { 0x0C01, BreakClass::SpacingMark },
+	{ 0x0C04, BreakClass::Extend }, { 0x0C05, BreakClass::Other }, { 0x0C15, BreakClass::Consonant },
+	{ 0x0C29, BreakClass::Other }, { 0x0C2A, BreakClass::Consonant }, { 0x0C3A, BreakClass::Other },
+	{ 0x0C3C, BreakClass::Extend }, { 0x0C3D, BreakClass::Other }, { 0x0C3E, BreakClass::Extend },
+	{ 0x0C41, BreakClass::SpacingMark }, { 0x0C45, BreakClass::Other }, { 0x0C46, BreakClass::Extend },
+	{ 0x0C49, BreakClass::Other }, { 0x0C4A, BreakClass::Extend }, { 0x0C4D, BreakClass::Linker },
+	{ 0x0C4E, BreakClass::Other }, { 0x0C55, BreakClass::Extend }, { 0x0C57, BreakClass::Other },
+	{ 0x0C58, BreakClass::Consonant }, { 0x0C5B, BreakClass::Other }, { 0x0C62, BreakClass::Extend },
+	{ 0x0C64, BreakClass::Other }, { 0x0C81, BreakClass::Extend }, { 0x0C82, BreakClass::SpacingMark },
+	{ 0x0C84, BreakClass::Other }, { 0x0CBC, BreakClass::Extend }, { 0x0CBD, BreakClass::Other },
+	{ 0x0CBE, BreakClass::SpacingMark }, { 0x0CBF, BreakClass::Extend }, { 0x0CC0, BreakClass::SpacingMark },
+	{ 0x0CC2, BreakClass::Extend }, { 0x0CC3, BreakClass::SpacingMark }, { 0x0CC5, BreakClass::Other },
+	{ 0x0CC6, BreakClass::Extend }, { 0x0CC7, BreakClass::SpacingMark }, { 0x0CC9, BreakClass::Other },
+	{ 0x0CCA, BreakClass::SpacingMark }, { 0x0CCC, BreakClass::Extend }, { 0x0CCE, BreakClass::Other },
+	{ 0x0CD5, BreakClass::Extend }, { 0x0CD7, BreakClass::Other }, { 0x0CE2, BreakClass::Extend },
+	{ 0x0CE4, BreakClass::Other }, { 0x0D00, BreakClass::Extend }, { 0x0D02, BreakClass::SpacingMark },
+	{ 0x0D04, BreakClass::Other }, { 0x0D15, BreakClass::Consonant }, { 0x0D3B, BreakClass::Extend },
+	{ 0x0D3D, BreakClass::Other }, { 0x0D3E, BreakClass::Extend }, { 0x0D3F, BreakClass::SpacingMark },
+	{ 0x0D41, BreakClass::Extend }, { 0x0D45, BreakClass::Other }, { 0x0D46, BreakClass::SpacingMark },
+	{ 0x0D49, BreakClass::Other }, { 0x0D4A, BreakClass::SpacingMark }, { 0x0D4D, BreakClass::Linker },
+	{ 0x0D4E, BreakClass::Prepend }, { 0x0D4F, BreakClass::Other }, { 0x0D57, BreakClass::Extend },
+	{ 0x0D58, BreakClass::Other }, { 0x0D62, BreakClass::Extend }, { 0x0D64, BreakClass::Other },
+	{ 0x0D81, BreakClass::Extend }, { 0x0D82, BreakClass::SpacingMark }, { 0x0D84, BreakClass::Other },
+	{ 0x0DCA, BreakClass::Extend }, { 0x0DCB, BreakClass::Other }, { 0x0DCF, BreakClass::Extend },
+	{ 0x0DD0, BreakClass::SpacingMark }, { 0x0DD2, BreakClass::Extend }, { 0x0DD5, BreakClass::Other },
+	{ 0x0DD6, BreakClass::Extend }, { 0x0DD7, BreakClass::Other }, { 0x0DD8, BreakClass::SpacingMark },
+	{ 0x0DDF, BreakClass::Extend }, { 0x0DE0, BreakClass::Other }, { 0x0DF2, BreakClass::SpacingMark },
+	{ 0x0DF4, BreakClass::Other }, { 0x0E31, BreakClass::Extend }, { 0x0E32, BreakClass::Other },
+	{ 0x0E33, BreakClass::SpacingMark }, { 0x0E34, BreakClass::Extend }, { 0x0E3B, BreakClass::Other },
+	{ 0x0E47, BreakClass::Extend }, { 0x0E4F, BreakClass::Other }, { 0x0EB1, BreakClass::Extend },
+	{ 0x0EB2, BreakClass::Other }, { 0x0EB3, BreakClass::SpacingMark }, { 0x0EB4, BreakClass::Extend },
+	{ 0x0EBD, BreakClass::Other }, { 0x0EC8, BreakClass::Extend }, { 0x0ECE, BreakClass::Other },
+	{ 0x0F18, BreakClass::Extend }, { 0x0F1A, BreakClass::Other }, { 0x0F35, BreakClass::Extend },
+	{ 0x0F36, BreakClass::Other }, { 0x0F37, BreakClass::Extend }, { 0x0F38, BreakClass::Other },
+	{ 0x0F39, BreakClass::Extend }, { 0x0F3A, BreakClass::Other }, { 0x0F3E, BreakClass::SpacingMark },
+	{ 0x0F40, BreakClass::Other }, { 0x0F71, BreakClass::Extend }, { 0x0F7F, BreakClass::SpacingMark },
+	{ 0x0F80, BreakClass::Extend }, { 0x0F85, BreakClass::Other }, { 0x0F86, BreakClass::Extend },
+	{ 0x0F88, BreakClass::Other }, { 0x0F8D, BreakClass::Extend }, { 0x0F98, BreakClass::Other },
+	{ 0x0F99, BreakClass::Extend }, { 0x0FBD, BreakClass::Other }, { 0x0FC6, BreakClass::Extend },
+	{ 0x0FC7, BreakClass::Other }, { 0x102D, BreakClass::Extend }, { 0x1031, BreakClass::SpacingMark },
+	{ 0x1032, BreakClass::Extend }, { 0x1038, BreakClass::Other }, { 0x1039, BreakClass::Extend },
+	{ 0x103B, BreakClass::SpacingMark }, { 0x103D, BreakClass::Extend }, { 0x103F, BreakClass::Other },
+	{ 0x1056, BreakClass::SpacingMark }, { 0x1058, BreakClass::Extend }, { 0x105A, BreakClass::Other },
+	{ 0x105E, BreakClass::Extend }, { 0x1061, BreakClass::Other }, { 0x1071, BreakClass::Extend },
+	{ 0x1075, BreakClass::Other }, { 0x1082, BreakClass::Extend }, { 0x1083, BreakClass::Other },
+	{ 0x1084, BreakClass::SpacingMark }, { 0x1085, BreakClass::Extend }, { 0x1087, BreakClass::Other },
+	{ 0x108D, BreakClass::Extend }, { 0x108E, BreakClass::Other }, { 0x109D, BreakClass::Extend },
+	{ 0x109E, BreakClass::Other }, { 0x1100, BreakClass::L }, { 0x1160, BreakClass::V }, { 0x11A8, BreakClass::T },
+	{ 0x1200, BreakClass::Other }, { 0x135D, BreakClass::Extend }, { 0x1360, BreakClass::Other },
+	{ 0x1712, BreakClass::Extend }, { 0x1715, BreakClass::SpacingMark }, { 0x1716, BreakClass::Other },
+	{ 0x1732, BreakClass::Extend }, { 0x1734, BreakClass::SpacingMark }, { 0x1735, BreakClass::Other },
+	{ 0x1752, BreakClass::Extend }, { 0x1754, BreakClass::Other }, { 0x1772, BreakClass::Extend },
+	{ 0x1774, BreakClass::Other }, { 0x17B4, BreakClass::Extend }, { 0x17B6, BreakClass::SpacingMark },
+	{ 0x17B7, BreakClass::Extend }, { 0x17BE, BreakClass::SpacingMark }, { 0x17C6, BreakClass::Extend },
+	{ 0x17C7, BreakClass::SpacingMark }, { 0x17C9, BreakClass::Extend }, { 0x17D4, BreakClass::Other },
+	{ 0x17DD, BreakClass::Extend }, { 0x17DE, BreakClass::Other }, { 0x180B, BreakClass::Extend },
+	{ 0x180E, BreakClass::Control }, { 0x180F, BreakClass::Extend }, { 0x1810, BreakClass::Other },
+	{ 0x1885, BreakClass::Extend }, { 0x1887, BreakClass::Other }, { 0x18A9, BreakClass::Extend },
+	{ 0x18AA, BreakClass::Other }, { 0x1920, BreakClass::Extend }, { 0x1923, BreakClass::SpacingMark },
+	{ 0x1927, BreakClass::Extend }, { 0x1929, BreakClass::SpacingMark }, { 0x192C, BreakClass::Other },
+	{ 0x1930, BreakClass::SpacingMark }, { 0x1932, BreakClass::Extend }, { 0x1933, BreakClass::SpacingMark },
+	{ 0x1939, BreakClass::Extend }, { 0x193C, BreakClass::Other }, { 0x1A17, BreakClass::Extend },
+	{ 0x1A19, BreakClass::SpacingMark }, { 0x1A1B, BreakClass::Extend }, { 0x1A1C, BreakClass::Other },
+	{ 0x1A55, BreakClass::SpacingMark }, { 0x1A56, BreakClass::Extend }, { 0x1A57, BreakClass::SpacingMark },
+	{ 0x1A58, BreakClass::Extend }, { 0x1A5F, BreakClass::Other }, { 0x1A60, BreakClass::Extend },
+	{ 0x1A61, BreakClass::Other }, { 0x1A62, BreakClass::Extend }, { 0x1A63, BreakClass::Other },
+	{ 0x1A65, BreakClass::Extend }, { 0x1A6D, BreakClass::SpacingMark }, { 0x1A73, BreakClass::Extend },
+	{ 0x1A7D, BreakClass::Other }, { 0x1A7F, BreakClass::Extend }, { 0x1A80, BreakClass::Other },
+	{ 0x1AB0, BreakClass::Extend }, { 0x1ACF, BreakClass::Other }, { 0x1B00, BreakClass::Extend },
+	{ 0x1B04, BreakClass::SpacingMark }, { 0x1B05, BreakClass::Other }, { 0x1B34, BreakClass::Extend },
+	{ 0x1B3B, BreakClass::SpacingMark }, { 0x1B3C, BreakClass::Extend }, { 0x1B3D, BreakClass::SpacingMark },
+	{ 0x1B42, BreakClass::Extend }, { 0x1B43, BreakClass::SpacingMark }, { 0x1B45, BreakClass::Other },
+	{ 0x1B6B, BreakClass::Extend }, { 0x1B74, BreakClass::Other }, { 0x1B80, BreakClass::Extend },
+	{ 0x1B82, BreakClass::SpacingMark }, { 0x1B83, BreakClass::Other }, { 0x1BA1, BreakClass::SpacingMark },
+	{ 0x1BA2, BreakClass::Extend }, { 0x1BA6, BreakClass::SpacingMark }, { 0x1BA8, BreakClass::Extend },
+	{ 0x1BAA, BreakClass::SpacingMark }, { 0x1BAB, BreakClass::Extend }, { 0x1BAE, BreakClass::Other },
+	{ 0x1BE6, BreakClass::Extend }, { 0x1BE7, BreakClass::SpacingMark }, { 0x1BE8, BreakClass::Extend },
+	{ 0x1BEA, BreakClass::SpacingMark }, { 0x1BED, BreakClass::Extend }, { 0x1BEE, BreakClass::SpacingMark },
+	{ 0x1BEF, BreakClass::Extend }, { 0x1BF2, BreakClass::SpacingMark }, { 0x1BF4, BreakClass::Other },
+	{ 0x1C24, BreakClass::SpacingMark }, { 0x1C2C, BreakClass::Extend }, { 0x1C34, BreakClass::SpacingMark },
+	{ 0x1C36, BreakClass::Extend }, { 0x1C38, BreakClass::Other }, { 0x1CD0, BreakClass::Extend },
+	{ 0x1CD3, BreakClass::Other }, { 0x1CD4, BreakClass::Extend }, { 0x1CE1, BreakClass::SpacingMark },
+	{ 0x1CE2, BreakClass::Extend }, { 0x1CE9, BreakClass::Other }, { 0x1CED, BreakClass::Extend },
+	{ 0x1CEE, BreakClass::Other }, { 0x1CF4, BreakClass::Extend }, { 0x1CF5, BreakClass::Other },
+	{ 0x1CF7, BreakClass::SpacingMark }, { 0x1CF8, BreakClass::Extend }, { 0x1CFA, BreakClass::Other },
+	{ 0x1DC0, BreakClass::Extend }, { 0x1E00, BreakClass::Other }, { 0x200B, BreakClass::Control },
+	{ 0x200C, BreakClass::Extend }, { 0x200D, BreakClass::ZWJ }, { 0x200E, BreakClass::Control },
+	{ 0x2010, BreakClass::Other }, { 0x2028, BreakClass::Control }, { 0x202F, BreakClass::Other },
+	{ 0x203C, BreakClass::Pictographic }, { 0x203D, BreakClass::Other }, { 0x2049, BreakClass::Pictographic },
+	{ 0x204A, BreakClass::Other }, { 0x2060, BreakClass::Control }, { 0x2070, BreakClass::Other },
+	{ 0x20D0, BreakClass::Extend }, { 0x20F1, BreakClass::Other }, { 0x2122, BreakClass::Pictographic },
+	{ 0x2123, BreakClass::Other }, { 0x2139, BreakClass::Pictographic }, { 0x213A, BreakClass::Other },
+	{ 0x2194, BreakClass::Pictographic }, { 0x219A, BreakClass::Other }, { 0x21A9, BreakClass::Pictographic },
+	{ 0x21AB, BreakClass::Other }, { 0x231A, BreakClass::Pictographic }, { 0x231C, BreakClass::Other },
+	{ 0x2328, BreakClass::Pictographic }, { 0x2329, BreakClass::Other }, { 0x2388, BreakClass::Pictographic },
+	{ 0x2389, BreakClass::Other }, { 0x23CF, BreakClass::Pictographic }, { 0x23D0, BreakClass::Other },
+	{ 0x23E9, BreakClass::Pictographic }, { 0x23F4, BreakClass::Other }, { 0x23F8, BreakClass::Pictographic },
+	{ 0x23FB, BreakClass::Other }, { 0x24C2, BreakClass::Pictographic }, { 0x24C3, BreakClass::Other },
+	{ 0x25AA, BreakClass::Pictographic }, { 0x25AC, BreakClass::Other }, { 0x25B6, BreakClass::Pictographic },
+	{ 0x25B7, BreakClass::Other }, { 0x25C0, BreakClass::Pictographic }, { 0x25C1, BreakClass::Other },
+	{ 0x25FB, BreakClass::Pictographic }, { 0x25FF, BreakClass::Other }, { 0x2600, BreakClass::Pictographic },
+	{ 0x2606, BreakClass::Other }, { 0x2607, BreakClass::Pictographic }, { 0x2613, BreakClass::Other },
+	{ 0x2614, BreakClass::Pictographic }, { 0x2686, BreakClass::Other }, { 0x2690, BreakClass::Pictographic },
+	{ 0x2706, BreakClass::Other }, { 0x2708, BreakClass::Pictographic }, { 0x2713, BreakClass::Other },
+	{ 0x2714, BreakClass::Pictographic }, { 0x2715, BreakClass::Other }, { 0x2716, BreakClass::Pictographic },
+	{ 0x2717, BreakClass::Other }, { 0x271D, BreakClass::Pictographic }, { 0x271E, BreakClass::Other },
+	{ 0x2721, BreakClass::Pictographic }, { 0x2722, BreakClass::Other }, { 0x2728, BreakClass::Pictographic },
+	{ 0x2729, BreakClass::Other }, { 0x2733, BreakClass::Pictographic }, { 0x2735, BreakClass::Other },
+	{ 0x2744, BreakClass::Pictographic }, { 0x2745, BreakClass::Other }, { 0x2747, BreakClass::Pictographic },
+	{ 0x2748, BreakClass::Other }, { 0x274C, BreakClass::Pictographic }, { 0x274D, BreakClass::Other },
+	{ 0x274E, BreakClass::Pictographic }, { 0x274F, BreakClass::Other }, { 0x2753, BreakClass::Pictographic },
+	{ 0x2756, BreakClass::Other }, { 0x2757, BreakClass::Pictographic }, { 0x2758, BreakClass::Other },
+	{ 0x2763, BreakClass::Pictographic }, { 0x2768, BreakClass::Other }, { 0x2795, BreakClass::Pictographic },
+	{ 0x2798, BreakClass::Other }, { 0x27A1, BreakClass::Pictographic }, { 0x27A2, BreakClass::Other },
+	{ 0x27B0, BreakClass::Pictographic }, { 0x27B1, BreakClass::Other }, { 0x27BF, BreakClass::Pictographic },
+	{ 0x27C0, BreakClass::Other }, { 0x2934, BreakClass::Pictographic }, { 0x2936, BreakClass::Other },
+	{ 0x2B05, BreakClass::Pictographic }, { 0x2B08, BreakClass::Other }, { 0x2B1B, BreakClass::Pictographic },
+	{ 0x2B1D, BreakClass::Other }, { 0x2B50, BreakClass::Pictographic }, { 0x2B51, BreakClass::Other },
+	{ 0x2B55, BreakClass::Pictographic }, { 0x2B56, BreakClass::Other }, { 0x2CEF, BreakClass::Extend },
+	{ 0x2CF2, BreakClass::Other }, { 0x2D7F, BreakClass::Extend }, { 0x2D80, BreakClass::Other },
+	{ 0x2DE0, BreakClass::Extend }, { 0x2E00, BreakClass::Other }, { 0x302A, BreakClass::Extend },
+	{ 0x3030, BreakClass::Pictographic }, { 0x3031, BreakClass::Other }, { 0x303D, BreakClass::Pictographic },
+	{ 0x303E, BreakClass::Other }, { 0x3099, BreakClass::Extend }, { 0x309B, BreakClass::Other },
+	{ 0x3297, BreakClass::Pictographic }, { 0x3298, BreakClass::Other }, { 0x3299, BreakClass::Pictographic },
+	{ 0x329A, BreakClass::Other }, { 0xA66F, BreakClass::Extend }, { 0xA673, BreakClass::Other },
+	{ 0xA674, BreakClass::Extend }, { 0xA67E, BreakClass::Other }, { 0xA69E, BreakClass::Extend },
+	{ 0xA6A0, BreakClass::Other }, { 0xA6F0, BreakClass::Extend }, { 0xA6F2, BreakClass::Other },
+	{ 0xA802, BreakClass::Extend }, { 0xA803, BreakClass::Other }, { 0xA806, BreakClass::Extend },
+	{ 0xA807, BreakClass::Other }, { 0xA80B, BreakClass::Extend }, { 0xA80C, BreakClass::Other },
+	{ 0xA823, BreakClass::SpacingMark }, { 0xA825, BreakClass::Extend }, { 0xA827, BreakClass::SpacingMark },
+	{ 0xA828, BreakClass::Other }, { 0xA82C, BreakClass::Extend }, { 0xA82D, BreakClass::Other },
+	{ 0xA880, BreakClass::SpacingMark }, { 0xA882, BreakClass::Other }, { 0xA8B4, BreakClass::SpacingMark },
+	{ 0xA8C4, BreakClass::Extend }, { 0xA8C6, BreakClass::Other }, { 0xA8E0, BreakClass::Extend },
+	{ 0xA8F2, BreakClass::Other }, { 0xA8FF, BreakClass::Extend }, { 0xA900, BreakClass::Other },
+	{ 0xA926, BreakClass::Extend }, { 0xA92E, BreakClass::Other }, { 0xA947, BreakClass::Extend },
+	{ 0xA952, BreakClass::SpacingMark }, { 0xA954, BreakClass::Other }, { 0xA960, BreakClass::L },
+	{ 0xA97D, BreakClass::Other }, { 0xA980, BreakClass::Extend }, { 0xA983, BreakClass::SpacingMark },
+	{ 0xA984, BreakClass::Other }, { 0xA9B3, BreakClass::Extend }, { 0xA9B4, BreakClass::SpacingMark },
+	{ 0xA9B6, BreakClass::Extend }, { 0xA9BA, BreakClass::SpacingMark }, { 0xA9BC, BreakClass::Extend },
+	{ 0xA9BE, BreakClass::SpacingMark }, { 0xA9C1, BreakClass::Other }, { 0xA9E5, BreakClass::Extend },
+	{ 0xA9E6, BreakClass::Other }, { 0xAA29, BreakClass::Extend }, { 0xAA2F, BreakClass::SpacingMark },
+	{ 0xAA31, BreakClass::Extend }, { 0xAA33, BreakClass::SpacingMark }, { 0xAA35, BreakClass::Extend },
+	{ 0xAA37, BreakClass::Other }, { 0xAA43, BreakClass::Extend }, { 0xAA44, BreakClass::Other },
+	{ 0xAA4C, BreakClass::Extend }, { 0xAA4D, BreakClass::SpacingMark }, { 0xAA4E, BreakClass::Other },
+	{ 0xAA7C, BreakClass::Extend }, { 0xAA7D, BreakClass::Other }, { 0xAAB0, BreakClass::Extend },
+	{ 0xAAB1, BreakClass::Other }, { 0xAAB2, BreakClass::Extend }, { 0xAAB5, BreakClass::Other },
+	{ 0xAAB7, BreakClass::Extend }, { 0xAAB9, BreakClass::Other }, { 0xAABE, BreakClass::Extend },
+	{ 0xAAC0, BreakClass::Other }, { 0xAAC1, BreakClass::Extend }, { 0xAAC2, BreakClass::Other },
+	{ 0xAAEB, BreakClass::SpacingMark }, { 0xAAEC, BreakClass::Extend }, { 0xAAEE, BreakClass::SpacingMark },
+	{ 0xAAF0, BreakClass::Other }, { 0xAAF5, BreakClass::SpacingMark }, { 0xAAF6, BreakClass::Extend },
+	{ 0xAAF7, BreakClass::Other }, { 0xABE3, BreakClass::SpacingMark }, { 0xABE5, BreakClass::Extend },
+	{ 0xABE6, BreakClass::SpacingMark }, { 0xABE8, BreakClass::Extend }, { 0xABE9, BreakClass::SpacingMark },
+	{ 0xABEB, BreakClass::Other }, { 0xABEC, BreakClass::SpacingMark }, { 0xABED, BreakClass::Extend },
+	{ 0xABEE, BreakClass::Other }, { 0xD7B0, BreakClass::V }, { 0xD7C7, BreakClass::Other }, { 0xD7CB, BreakClass::T },
+	{ 0xD7FC, BreakClass::Other }, { 0xFB1E, BreakClass::Extend }, { 0xFB1F, BreakClass::Other },
+	{ 0xFE00, BreakClass::Extend }, { 0xFE10, BreakClass::Other }, { 0xFE20, BreakClass::Extend },
+	{ 0xFE30, BreakClass::Other }, { 0xFEFF, BreakClass::Control }, { 0xFF00, BreakClass::Other },
+	{ 0xFF9E, BreakClass::Extend }, { 0xFFA0, BreakClass::Other }, { 0xFFF0, BreakClass::Control },
+	{ 0xFFFC, BreakClass::Other }, { 0x101FD, BreakClass::Extend }, { 0x101FE, BreakClass::Other },
+	{ 0x102E0, BreakClass::Extend }, { 0x102E1, BreakClass::Other }, { 0x10376, BreakClass::Extend },
+	{ 0x1037B, BreakClass::Other }, { 0x10A01, BreakClass::Extend }, { 0x10A04, BreakClass::Other },
+	{ 0x10A05, BreakClass::Extend }, { 0x10A07, BreakClass::Other }, { 0x10A0C, BreakClass::Extend },
+	{ 0x10A10, BreakClass::Other }, { 0x10A38, BreakClass::Extend }, { 0x10A3B, BreakClass::Other },
+	{ 0x10A3F, BreakClass::Extend }, { 0x10A40, BreakClass::Other }, { 0x10AE5, BreakClass::Extend },
+	{ 0x10AE7, BreakClass::Other }, { 0x10D24, BreakClass::Extend }, { 0x10D28, BreakClass::Other },
+	{ 0x10EAB, BreakClass::Extend }, { 0x10EAD, BreakClass::Other }, { 0x10F46, BreakClass::Extend },
+	{ 0x10F51, BreakClass::Other }, { 0x10F82, BreakClass::Extend }, { 0x10F86, BreakClass::Other },
+	{ 0x11000, BreakClass::SpacingMark }, { 0x11001, BreakClass::Extend }, { 0x11002, BreakClass::SpacingMark },
+	{ 0x11003, BreakClass::Other }, { 0x11038, BreakClass::Extend }, { 0x11047, BreakClass::Other },
+	{ 0x11070, BreakClass::Extend }, { 0x11071, BreakClass::Other }, { 0x11073, BreakClass::Extend },
+	{ 0x11075, BreakClass::Other }, { 0x1107F, BreakClass::Extend }, { 0x11082, BreakClass::SpacingMark },
+	{ 0x11083, BreakClass::Other }, { 0x110B0, BreakClass::SpacingMark }, { 0x110B3, BreakClass::Extend },
+	{ 0x110B7, BreakClass::SpacingMark }, { 0x110B9, BreakClass::Extend }, { 0x110BB, BreakClass::Other },
+	{ 0x110BD, BreakClass::Prepend }, { 0x110BE, BreakClass::Other }, { 0x110C2, BreakClass::Extend },
+	{ 0x110C3, BreakClass::Other }, { 0x110CD, BreakClass::Prepend }, { 0x110CE, BreakClass::Other },
+	{ 0x11100, BreakClass::Extend }, { 0x11103, BreakClass::Other }, { 0x11127, BreakClass::Extend },
+	{ 0x1112C, BreakClass::SpacingMark }, { 0x1112D, BreakClass::Extend }, { 0x11135, BreakClass::Other },
+	{ 0x11145, BreakClass::SpacingMark }, { 0x11147, BreakClass::Other }, { 0x11173, BreakClass::Extend },
+	{ 0x11174, BreakClass::Other }, { 0x11180, BreakClass::Extend }, { 0x11182, BreakClass::SpacingMark },
+	{ 0x11183, BreakClass::Other }, { 0x111B3, BreakClass::SpacingMark }, { 0x111B6, BreakClass::Extend },
+	{ 0x111BF, BreakClass::SpacingMark }, { 0x111C1, BreakClass::Other }, { 0x111C2, BreakClass::Prepend },
+	{ 0x111C4, BreakClass::Other }, { 0x111C9, BreakClass::Extend }, { 0x111CD, BreakClass::Other },
+	{ 0x111CE, BreakClass::SpacingMark }, { 0x111CF, BreakClass::Extend }, { 0x111D0, BreakClass::Other },
+	{ 0x1122C, BreakClass::SpacingMark }, { 0x1122F, BreakClass::Extend }, { 0x11232, BreakClass::SpacingMark },
+	{ 0x11234, BreakClass::Extend }, { 0x11235, BreakClass::SpacingMark }, { 0x11236, BreakClass::Extend },
+	{ 0x11238, BreakClass::Other }, { 0x1123E, BreakClass::Extend }, { 0x1123F, BreakClass::Other },
+	{ 0x112DF, BreakClass::Extend }, { 0x112E0, BreakClass::SpacingMark }, { 0x112E3, BreakClass::Extend },
+	{ 0x112EB, BreakClass::Other }, { 0x11300, BreakClass::Extend }, { 0x11302, BreakClass::SpacingMark },
+	{ 0x11304, BreakClass::Other }, { 0x1133B, BreakClass::Extend }, { 0x1133D, BreakClass::Other },
+	{ 0x1133E, BreakClass::Extend }, { 0x1133F, BreakClass::SpacingMark }, { 0x11340, BreakClass::Extend },
+	{ 0x11341, BreakClass::SpacingMark }, { 0x11345, BreakClass::Other }, { 0x11347, BreakClass::SpacingMark },
+	{ 0x11349, BreakClass::Other }, { 0x1134B, BreakClass::SpacingMark }, { 0x1134E, BreakClass::Other },
+	{ 0x11357, BreakClass::Extend }, { 0x11358, BreakClass::Other }, { 0x11362, BreakClass::SpacingMark },
+	{ 0x11364, BreakClass::Other }, { 0x11366, BreakClass::Extend }, { 0x1136D, BreakClass::Other },
+	{ 0x11370, BreakClass::Extend }, { 0x11375, BreakClass::Other }, { 0x11435, BreakClass::SpacingMark },
+	{ 0x11438, BreakClass::Extend }, { 0x11440, BreakClass::SpacingMark }, { 0x11442, BreakClass::Extend },
+	{ 0x11445, BreakClass::SpacingMark }, { 0x11446, BreakClass::Extend }, { 0x11447, BreakClass::Other },
+	{ 0x1145E, BreakClass::Extend }, { 0x1145F, BreakClass::Other }, { 0x114B0, BreakClass::Extend },
+	{ 0x114B1, BreakClass::SpacingMark }, { 0x114B3, BreakClass::Extend }, { 0x114B9, BreakClass::SpacingMark },
+	{ 0x114BA, BreakClass::Extend }, { 0x114BB, BreakClass::SpacingMark }, { 0x114BD, BreakClass::Extend },
+	{ 0x114BE, BreakClass::SpacingMark }, { 0x114BF, BreakClass::Extend }, { 0x114C1, BreakClass::SpacingMark },
+	{ 0x114C2, BreakClass::Extend }, { 0x114C4, BreakClass::Other }, { 0x115AF, BreakClass::Extend },
+	{ 0x115B0, BreakClass::SpacingMark }, { 0x115B2, BreakClass::Extend }, { 0x115B6, BreakClass::Other },
+	{ 0x115B8, BreakClass::SpacingMark }, { 0x115BC, BreakClass::Extend }, { 0x115BE, BreakClass::SpacingMark },
+	{ 0x115BF, BreakClass::Extend }, { 0x115C1, BreakClass::Other }, { 0x115DC, BreakClass::Extend },
+	{ 0x115DE, BreakClass::Other }, { 0x11630, BreakClass::SpacingMark }, { 0x11633, BreakClass::Extend },
+	{ 0x1163B, BreakClass::SpacingMark }, { 0x1163D, BreakClass::Extend }, { 0x1163E, BreakClass::SpacingMark },
+	{ 0x1163F, BreakClass::Extend }, { 0x11641, BreakClass::Other }, { 0x116AB, BreakClass::Extend },
+	{ 0x116AC, BreakClass::SpacingMark }, { 0x116AD, BreakClass::Extend }, { 0x116AE, BreakClass::SpacingMark },
+	{ 0x116B0, BreakClass::Extend }, { 0x116B6, BreakClass::SpacingMark }, { 0x116B7, BreakClass::Extend },
+	{ 0x116B8, BreakClass::Other }, { 0x1171D, BreakClass::Extend }, { 0x11720, BreakClass::Other },
+	{ 0x11722, BreakClass::Extend }, { 0x11726, BreakClass::SpacingMark }, { 0x11727, BreakClass::Extend },
+	{ 0x1172C, BreakClass::Other }, { 0x1182C, BreakClass::SpacingMark }, { 0x1182F, BreakClass::Extend },
+	{ 0x11838, BreakClass::SpacingMark }, { 0x11839, BreakClass::Extend }, { 0x1183B, BreakClass::Other },
+	{ 0x11930, BreakClass::Extend }, { 0x11931, BreakClass::SpacingMark }, { 0x11936, BreakClass::Other },
+	{ 0x11937, BreakClass::SpacingMark }, { 0x11939, BreakClass::Other }, { 0x1193B, BreakClass::Extend },
+	{ 0x1193D, BreakClass::SpacingMark }, { 0x1193E, BreakClass::Extend }, { 0x1193F, BreakClass::Prepend },
+	{ 0x11940, BreakClass::SpacingMark }, { 0x11941, BreakClass::Prepend }, { 0x11942, BreakClass::SpacingMark },
+	{ 0x11943, BreakClass::Extend }, { 0x11944, BreakClass::Other }, { 0x119D1, BreakClass::SpacingMark },
+	{ 0x119D4, BreakClass::Extend }, { 0x119D8, BreakClass::Other }, { 0x119DA, BreakClass::Extend },
+	{ 0x119DC, BreakClass::SpacingMark }, { 0x119E0, BreakClass::Extend }, { 0x119E1, BreakClass::Other },
+	{ 0x119E4, BreakClass::SpacingMark }, { 0x119E5, BreakClass::Other }, { 0x11A01, BreakClass::Extend },
+	{ 0x11A0B, BreakClass::Other }, { 0x11A33, BreakClass::Extend }, { 0x11A39, BreakClass::SpacingMark },
+	{ 0x11A3A, BreakClass::Prepend }, { 0x11A3B, BreakClass::Extend }, { 0x11A3F, BreakClass::Other },
+	{ 0x11A47, BreakClass::Extend }, { 0x11A48, BreakClass::Other }, { 0x11A51, BreakClass::Extend },
+	{ 0x11A57, BreakClass::SpacingMark }, { 0x11A59, BreakClass::Extend }, { 0x11A5C, BreakClass::Other },
+	{ 0x11A84, BreakClass::Prepend }, { 0x11A8A, BreakClass::Extend }, { 0x11A97, BreakClass::SpacingMark },
+	{ 0x11A98, BreakClass::Extend }, { 0x11A9A, BreakClass::Other }, { 0x11C2F, BreakClass::SpacingMark },
+	{ 0x11C30, BreakClass::Extend }, { 0x11C37, BreakClass::Other }, { 0x11C38, BreakClass::Extend },
+	{ 0x11C3E, BreakClass::SpacingMark }, { 0x11C3F, BreakClass::Extend }, { 0x11C40, BreakClass::Other },
+	{ 0x11C92, BreakClass::Extend }, { 0x11CA8, BreakClass::Other }, { 0x11CA9, BreakClass::SpacingMark },
+	{ 0x11CAA, BreakClass::Extend }, { 0x11CB1, BreakClass::SpacingMark }, { 0x11CB2, BreakClass::Extend },
+	{ 0x11CB4, BreakClass::SpacingMark }, { 0x11CB5, BreakClass::Extend }, { 0x11CB7, BreakClass::Other },
+	{ 0x11D31, BreakClass::Extend }, { 0x11D37, BreakClass::Other }, { 0x11D3A, BreakClass::Extend },
+	{ 0x11D3B, BreakClass::Other }, { 0x11D3C, BreakClass::Extend }, { 0x11D3E, BreakClass::Other },
+	{ 0x11D3F, BreakClass::Extend }, { 0x11D46, BreakClass::Prepend }, { 0x11D47, BreakClass::Extend },
+	{ 0x11D48, BreakClass::Other }, { 0x11D8A, BreakClass::SpacingMark }, { 0x11D8F, BreakClass::Other },
+	{ 0x11D90, BreakClass::Extend }, { 0x11D92, BreakClass::Other }, { 0x11D93, BreakClass::SpacingMark },
+	{ 0x11D95, BreakClass::Extend }, { 0x11D96, BreakClass::SpacingMark }, { 0x11D97, BreakClass::Extend },
+	{ 0x11D98, BreakClass::Other }, { 0x11EF3, BreakClass::Extend }, { 0x11EF5, BreakClass::SpacingMark },
+	{ 0x11EF7, BreakClass::Other }, { 0x13430, BreakClass::Control }, { 0x13439, BreakClass::Other },
+	{ 0x16AF0, BreakClass::Extend }, { 0x16AF5, BreakClass::Other }, { 0x16B30, BreakClass::Extend },
+	{ 0x16B37, BreakClass::Other }, { 0x16F4F, BreakClass::Extend }, { 0x16F50, BreakClass::Other },
+	{ 0x16F51, BreakClass::SpacingMark }, { 0x16F88, BreakClass::Other }, { 0x16F8F, BreakClass::Extend },
+	{ 0x16F93, BreakClass::Other }, { 0x16FE4, BreakClass::Extend }, { 0x16FE5, BreakClass::Other },
+	{ 0x16FF0, BreakClass::SpacingMark }, { 0x16FF2, BreakClass::Other }, { 0x1BC9D, BreakClass::Extend },
+	{ 0x1BC9F, BreakClass::Other }, { 0x1BCA0, BreakClass::Control }, { 0x1BCA4, BreakClass::Other },
+	{ 0x1CF00, BreakClass::Extend }, { 0x1CF2E, BreakClass::Other }, { 0x1CF30, BreakClass::Extend },
+	{ 0x1CF47, BreakClass::Other }, { 0x1D165, BreakClass::Extend }, { 0x1D166, BreakClass::SpacingMark },
+	{ 0x1D167, BreakClass::Extend }, { 0x1D16A, BreakClass::Other }, { 0x1D16D, BreakClass::SpacingMark },
+	{ 0x1D16E, BreakClass::Extend }, { 0x1D173, BreakClass::Control }, { 0x1D17B, BreakClass::Extend },
+	{ 0x1D183, BreakClass::Other }, { 0x1D185, BreakClass::Extend }, { 0x1D18C, BreakClass::Other },
+	{ 0x1D1AA, BreakClass::Extend }, { 0x1D1AE, BreakClass::Other }, { 0x1D242, BreakClass::Extend },
+	{ 0x1D245, BreakClass::Other }, { 0x1DA00, BreakClass::Extend }, { 0x1DA37, BreakClass::Other },
+	{ 0x1DA3B, BreakClass::Extend }, { 0x1DA6D, BreakClass::Other }, { 0x1DA75, BreakClass::Extend },
+	{ 0x1DA76, BreakClass::Other }, { 0x1DA84, BreakClass::Extend }, { 0x1DA85, BreakClass::Other },
+	{ 0x1DA9B, BreakClass::Extend }, { 0x1DAA0, BreakClass::Other }, { 0x1DAA1, BreakClass::Extend },
+	{ 0x1DAB0, BreakClass::Other }, { 0x1E000, BreakClass::Extend }, { 0x1E007, BreakClass::Other },
+	{ 0x1E008, BreakClass::Extend }, { 0x1E019, BreakClass::Other }, { 0x1E01B, BreakClass::Extend },
+	{ 0x1E022, BreakClass::Other }, { 0x1E023, BreakClass::Extend }, { 0x1E025, BreakClass::Other },
+	{ 0x1E026, BreakClass::Extend }, { 0x1E02B, BreakClass::Other }, { 0x1E130, BreakClass::Extend },
+	{ 0x1E137, BreakClass::Other }, { 0x1E2AE, BreakClass::Extend }, { 0x1E2AF, BreakClass::Other },
+	{ 0x1E2EC, BreakClass::Extend }, { 0x1E2F0, BreakClass::Other }, { 0x1E8D0, BreakClass::Extend },
+	{ 0x1E8D7, BreakClass::Other }, { 0x1E944, BreakClass::Extend }, { 0x1E94B, BreakClass::Other },
+	{ 0x1F000, BreakClass::Pictographic }, { 0x1F100, BreakClass::Other }, { 0x1F10D, BreakClass::Pictographic },
+	{ 0x1F110, BreakClass::Other }, { 0x1F12F, BreakClass::Pictographic }, { 0x1F130, BreakClass::Other },
+	{ 0x1F16C, BreakClass::Pictographic }, { 0x1F172, BreakClass::Other }, { 0x1F17E, BreakClass::Pictographic },
+	{ 0x1F180, BreakClass::Other }, { 0x1F18E, BreakClass::Pictographic }, { 0x1F18F, BreakClass::Other },
+	{ 0x1F191, BreakClass::Pictographic }, { 0x1F19B, BreakClass::Other }, { 0x1F1AD, BreakClass::Pictographic },
+	{ 0x1F1E6, BreakClass::RegionalIndicator }, { 0x1F200, BreakClass::Other }, { 0x1F201, BreakClass::Pictographic },
+	{ 0x1F210, BreakClass::Other }, { 0x1F21A, BreakClass::Pictographic }, { 0x1F21B, BreakClass::Other },
+	{ 0x1F22F, BreakClass::Pictographic }, { 0x1F230, BreakClass::Other }, { 0x1F232, BreakClass::Pictographic },
+	{ 0x1F23B, BreakClass::Other }, { 0x1F23C, BreakClass::Pictographic }, { 0x1F240, BreakClass::Other },
+	{ 0x1F249, BreakClass::Pictographic }, { 0x1F3FB, BreakClass::Extend }, { 0x1F400, BreakClass::Pictographic },
+	{ 0x1F53E, BreakClass::Other }, { 0x1F546, BreakClass::Pictographic }, { 0x1F650, BreakClass::Other },
+	{ 0x1F680, BreakClass::Pictographic }, { 0x1F700, BreakClass::Other }, { 0x1F774, BreakClass::Pictographic },
+	{ 0x1F780, BreakClass::Other }, { 0x1F7D5, BreakClass::Pictographic }, { 0x1F800, BreakClass::Other },
+	{ 0x1F80C, BreakClass::Pictographic }, { 0x1F810, BreakClass::Other }, { 0x1F848, BreakClass::Pictographic },
+	{ 0x1F850, BreakClass::Other }, { 0x1F85A, BreakClass::Pictographic }, { 0x1F860, BreakClass::Other },
+	{ 0x1F888, BreakClass::Pictographic }, { 0x1F890, BreakClass::Other }, { 0x1F8AE, BreakClass::Pictographic },
+	{ 0x1F900, BreakClass::Other }, { 0x1F90C, BreakClass::Pictographic }, { 0x1F93B, BreakClass::Other },
+	{ 0x1F93C, BreakClass::Pictographic }, { 0x1F946, BreakClass::Other }, { 0x1F947, BreakClass::Pictographic },
+	{ 0x1FB00, BreakClass::Other }, { 0x1FC00, BreakClass::Pictographic }, { 0x1FFFE, BreakClass::Other },
+	{ 0xE0000, BreakClass::Control }, { 0xE0020, BreakClass::Extend }, { 0xE0080, BreakClass::Control },
+	{ 0xE0100, BreakClass::Extend }, { 0xE01F0, BreakClass::Control }, { 0xE1000, BreakClass::Other },
+};
+
+struct CodePointRange
+{
+	char32_t first;
+	char32_t last;
+};
+
+// East_Asian_Width=W or F, and Emoji_Presentation
+static constexpr CodePointRange kWide[] = {
+	{ 0x1100, 0x115F }, { 0x231A, 0x231B }, { 0x2329, 0x232A }, { 0x23E9, 0x23EC }, { 0x23F0, 0x23F0 }, { 0x23F3, 0x23F3 },
+	{ 0x25FD, 0x25FE }, { 0x2614, 0x2615 }, { 0x2648, 0x2653 }, { 0x267F, 0x267F }, { 0x2693, 0x2693 }, { 0x26A1, 0x26A1 },
+	{ 0x26AA, 0x26AB }, { 0x26BD, 0x26BE }, { 0x26C4, 0x26C5 }, { 0x26CE, 0x26CE }, { 0x26D4, 0x26D4 }, { 0x26EA, 0x26EA },
+	{ 0x26F2, 0x26F3 }, { 0x26F5, 0x26F5 }, { 0x26FA, 0x26FA }, { 0x26FD, 0x26FD }, { 0x2705, 0x2705 }, { 0x270A, 0x270B },
+	{ 0x2728, 0x2728 }, { 0x274C, 0x274C }, { 0x274E, 0x274E }, { 0x2753, 0x2755 }, { 0x2757, 0x2757 }, { 0x2795, 0x2797 },
+	{ 0x27B0, 0x27B0 }, { 0x27BF, 0x27BF }, { 0x2B1B, 0x2B1C }, { 0x2B50, 0x2B50 }, { 0x2B55, 0x2B55 }, { 0x2E80, 0x2E99 },
+	{ 0x2E9B, 0x2EF3 }, { 0x2F00, 0x2FD5 }, { 0x2FF0, 0x2FFB }, { 0x3000, 0x303E }, { 0x3041, 0x3096 }, { 0x3099, 0x30FF },
+	{ 0x3105, 0x312F }, { 0x3131, 0x318E }, { 0x3190, 0x31E3 }, { 0x31F0, 0x321E }, { 0x3220, 0x3247 }, { 0x3250, 0x4DBF },
+	{ 0x4E00, 0xA48C }, { 0xA490, 0xA4C6 }, { 0xA960, 0xA97C }, { 0xAC00, 0xD7A3 }, { 0xF900, 0xFAFF }, { 0xFE10, 0xFE19 },
+	{ 0xFE30, 0xFE52 }, { 0xFE54, 0xFE66 }, { 0xFE68, 0xFE6B }, { 0xFF01, 0xFF60 }, { 0xFFE0, 0xFFE6 },
+	{ 0x16FE0, 0x16FE4 }, { 0x16FF0, 0x16FF1 }, { 0x17000, 0x187F7 }, { 0x18800, 0x18CD5 }, { 0x18D00, 0x18D08 },
+	{ 0x1AFF0, 0x1AFF3 }, { 0x1AFF5, 0x1AFFB }, { 0x1AFFD, 0x1AFFE }, { 0x1B000, 0x1B122 }, { 0x1B150, 0x1B152 },
+	{ 0x1B164, 0x1B167 }, { 0x1B170, 0x1B2FB }, { 0x1F004, 0x1F004 }, { 0x1F0CF, 0x1F0CF }, { 0x1F18E, 0x1F18E },
+	{ 0x1F191, 0x1F19A }, { 0x1F1E6, 0x1F202 }, { 0x1F210, 0x1F23B }, { 0x1F240, 0x1F248 }, { 0x1F250, 0x1F251 },
+	{ 0x1F260, 0x1F265 }, { 0x1F300, 0x1F320 }, { 0x1F32D, 0x1F335 }, { 0x1F337, 0x1F37C }, { 0x1F37E, 0x1F393 },
+	{ 0x1F3A0, 0x1F3CA }, { 0x1F3CF, 0x1F3D3 }, { 0x1F3E0, 0x1F3F0 }, { 0x1F3F4, 0x1F3F4 }, { 0x1F3F8, 0x1F43E },
+	{ 0x1F440, 0x1F440 }, { 0x1F442, 0x1F4FC }, { 0x1F4FF, 0x1F53D }, { 0x1F54B, 0x1F54E }, { 0x1F550, 0x1F567 },
+	{ 0x1F57A, 0x1F57A }, { 0x1F595, 0x1F596 }, { 0x1F5A4, 0x1F5A4 }, { 0x1F5FB, 0x1F64F }, { 0x1F680, 0x1F6C5 },
+	{ 0x1F6CC, 0x1F6CC }, { 0x1F6D0, 0x1F6D2 }, { 0x1F6D5, 0x1F6D7 }, { 0x1F6DD, 0x1F6DF }, { 0x1F6EB, 0x1F6EC },
+	{ 0x1F6F4, 0x1F6FC }, { 0x1F7E0, 0x1F7EB }, { 0x1F7F0, 0x1F7F0 }, { 0x1F90C, 0x1F93A }, { 0x1F93C, 0x1F945 },
+	{ 0x1F947, 0x1F9FF }, { 0x1FA70, 0x1FA74 }, { 0x1FA78, 0x1FA7C }, { 0x1FA80, 0x1FA86 }, { 0x1FA90, 0x1FAAC },
+	{ 0x1FAB0, 0x1FABA }, { 0x1FAC0, 0x1FAC5 }, { 0x1FAD0, 0x1FAD9 }, { 0x1FAE0, 0x1FAE7 }, { 0x1FAF0, 0x1FAF6 },
+	{ 0x20000, 0x2FFFD }, { 0x30000, 0x3FFFD },
+};
+
+static constexpr bool IsSorted()
+{
+	if (kBreakRuns[0].first != 0) {
+		return false;
+	}
+	for (size_t i = 1; i < std::size(kBreakRuns); ++i) {
+		if (kBreakRuns[i - 1].first >= kBreakRuns[i].first || kBreakRuns[i - 1].breakClass == kBreakRuns[i].breakClass) {
+			return false;
+		}
+	}
+	for (size_t i = 0; i < std::size(kWide); ++i) {
+		if (kWide[i].first > kWide[i].last || (i > 0 && kWide[i - 1].last + 1 >= kWide[i].first)) {
+			return false;
+		}
+	}
+	return true;
+}
+
+static_assert(IsSorted(), "kBreakRuns and kWide must be sorted, start at 0 and not repeat themselves");
+static_assert(sizeof(BreakRun) == 4, "BreakRun should pack into 32 bits");
+
+static BreakClass GetBreakClass(char32_t inCodePoint)
+{
+	// Nearly every title is mostly ASCII
+	if (inCodePoint < 0x7F) {
+		if (inCodePoint >= 0x20) return BreakClass::Other;
+		if (inCodePoint == '\r') return BreakClass::CR;
+		if (inCodePoint == '\n') return BreakClass::LF;
+		return BreakClass::Control;
+	}
+	if (inCodePoint >= 0xAC00 && inCodePoint <= 0xD7A3) {
+		return (inCodePoint - 0xAC00) % 28 == 0 ? BreakClass::LV : BreakClass::LVT;
+	}
+	auto run = std::upper_bound(std::begin(kBreakRuns), std::end(kBreakRuns), inCodePoint,
+		[](char32_t inValue, const BreakRun& inRun) { return inValue < inRun.first; });
+	return (run - 1)->breakClass;
+}
+
+static bool IsWide(char32_t inCodePoint)
+{
+	auto range = std::upper_bound(std::begin(kWide), std::end(kWide), inCodePoint,
+		[](char32_t inValue, const CodePointRange& inRange) { return inValue < inRange.first; });
+	return range != std::begin(kWide) && inCodePoint <= (range - 1)->last;
+}
+
+GraphemeWidthClass GetGraphemeWidthClass(char32_t inCodePoint)
+{
+	if (inCodePoint >= 0x20 && inCodePoint < 0x7F) {
+		return GraphemeWidthClass::Normal;
+	}
+	switch (GetBreakClass(inCodePoint)) {
+	case BreakClass::CR:
+	case BreakClass::LF:
+	case BreakClass::Control:
+	case BreakClass::Extend:
+	case BreakClass::Linker:
+	case BreakClass::ZWJ:
+	case BreakClass::V:
+	case BreakClass::T:
+		return GraphemeWidthClass::Zero;
+	default:
+		return IsWide(inCodePoint) ? GraphemeWidthClass::Wide : GraphemeWidthClass::Normal;
+	}
+}
+
+char32_t NextCodePoint(std::string_view inText, size_t& ioIndex)
+{
+	char32_t codePoint;
+	if (!DecodeUTF8(inText, ioIndex, codePoint)) {
+		++ioIndex;
+		return 0xFFFD;
+	}
+	return codePoint;
+}
+
+void RepairUTF8(std::string& ioText)
+{
+	// Titles from the media sources are almost always valid, so only copy when they aren't.
+	size_t index = ValidUTF8Length(ioText);
+	if (index == ioText.size()) {
+		return;
+	}
+
+	std::string repaired(ioText, 0, index);
+	char32_t codePoint;
+	while (index < ioText.size()) {
+		size_t start = index;
+		if (DecodeUTF8(ioText, index, codePoint)) {
+			repaired.append(ioText, start, index - start);
+		}
+		else {
+			repaired += "\xEF\xBF\xBD";
+			++index;
+		}
+	}
+	ioText = std::move(repaired);
+}
+
+// Whether UAX #29 keeps inNext in the same cluster as inPrevious. inPictographicZWJ says the cluster so far ends in
+// an emoji followed by marks and a ZWJ, inOddRegional that it ends in an odd number of regional indicators, and
+// inConjunctLinked that it ends in an Indic consonant, then marks with at least one linker (virama) among them.
+static bool JoinsCluster(BreakClass inPrevious, BreakClass inNext, bool inPictographicZWJ, bool inOddRegional, bool inConjunctLinked)
+{
+	if (inPrevious == BreakClass::CR && inNext == BreakClass::LF) return true;												// GB3
+	if (inPrevious == BreakClass::CR || inPrevious == BreakClass::LF || inPrevious == BreakClass::Control) return false;	// GB4
+	if (inNext == BreakClass::CR || inNext == BreakClass::LF || inNext == BreakClass::Control) return false;				// GB5
+	switch (inPrevious) {																								// GB6-8
+	case BreakClass::L:
+		if (inNext == BreakClass::L || inNext == BreakClass::V || inNext == BreakClass::LV || inNext == BreakClass::LVT) return true;
+		break;
+	case BreakClass::LV:
+	case BreakClass::V:
+		if (inNext == BreakClass::V || inNext == BreakClass::T) return true;
+		break;
+	case BreakClass::LVT:
+	case BreakClass::T:
+		if (inNext == BreakClass::T) return true;
+		break;
+	default:
+		break;
+	}
+	if (inNext == BreakClass::Extend || inNext == BreakClass::Linker || inNext == BreakClass::ZWJ) return true;		// GB9
+	if (inNext == BreakClass::SpacingMark) return true;																// GB9a
+	if (inPrevious == BreakClass::Prepend) return true;																// GB9b
+	if (inNext == BreakClass::Consonant && inConjunctLinked) return true;											// GB9c
+	if (inPrevious == BreakClass::ZWJ && inNext == BreakClass::Pictographic && inPictographicZWJ) return true;			// GB11
+	if (inPrevious == BreakClass::RegionalIndicator && inNext == BreakClass::RegionalIndicator && inOddRegional) return true;	// GB12, GB13
+	return false;																										// GB999
+}
+
+void IndexGraphemes(std::string_view inText, std::vector<Grapheme>& outGraphemes)
+{
+	outGraphemes.reserve(outGraphemes.size() + inText.size() + 1);
+
+	BreakClass previous = BreakClass::Control;
+	bool pictographic = false;		// the cluster ends in an emoji followed by marks
+	bool pictographicZWJ = false;	// ... and then a ZWJ
+	bool oddRegional = false;
+	bool conjunct = false;			// the cluster ends in an Indic consonant followed by marks
+	bool conjunctLinked = false;	// ... with a linker among them
+	size_t index = 0;
+	while (index < inText.size()) {
+		size_t start = index;
+		auto codePoint = NextCodePoint(inText, index);
+		auto next = GetBreakClass(codePoint);
+		bool isMark = next == BreakClass::Extend || next == BreakClass::Linker || next == BreakClass::ZWJ;
+
+		if (start == 0 || !JoinsCluster(previous, next, pictographicZWJ, oddRegional, conjunctLinked)) {
+			outGraphemes.push_back({ static_cast<uint32_t>(start), codePoint, GetGraphemeWidthClass(codePoint) });
+			oddRegional = false;
+		}
+		else if (codePoint == 0xFE0F && outGraphemes.back().width == GraphemeWidthClass::Normal) {
+			// VS16 asks for the emoji rather than the text form of its base, which is drawn as wide as any other emoji
+			outGraphemes.back().width = GraphemeWidthClass::Wide;
+		}
+
+		pictographicZWJ = pictographic && next == BreakClass::ZWJ;
+		pictographic = next == BreakClass::Pictographic || (pictographic && isMark && next != BreakClass::ZWJ);
+		oddRegional = next == BreakClass::RegionalIndicator && !oddRegional;
+		conjunctLinked = conjunct && isMark && (conjunctLinked || next == BreakClass::Linker);
+		conjunct = next == BreakClass::Consonant || (conjunct && isMark);
+		previous = next;
+	}
+	outGraphemes.push_back({ static_cast<uint32_t>(inText.size()), 0, GraphemeWidthClass::Zero });
+}
@@ -0,0 +1,49 @@
+//==============================================================================
+/**
+@file       Graphemes.h
+
+@brief      Splits titles into user-perceived characters (extended grapheme clusters)
+
+@copyright  (c) 2021, bionyx187
+			This source code is licensed under the MIT-style license found in the LICENSE file.
+
+**/
+//==============================================================================
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// How much room a code point takes when drawn on its own
+enum class GraphemeWidthClass : uint8_t
+{
+	Zero,		// combining marks, joiners, variation selectors and controls
+	Normal,
+	Wide		// East Asian wide and fullwidth characters, and emoji
+};
+
+GraphemeWidthClass GetGraphemeWidthClass(char32_t inCodePoint);
+
+// Reads the UTF-8 code point at ioIndex and moves past it. A byte that doesn't start a valid sequence reads as
+// U+FFFD and is skipped on its own.
+char32_t NextCodePoint(std::string_view inText, size_t& ioIndex);
+
+// Replaces every invalid UTF-8 sequence in ioText with U+FFFD, so any slice of it between grapheme clusters can be
+// sent as a JSON string. Valid text is left as it is.
+void RepairUTF8(std::string& ioText);
+
+// One extended grapheme cluster of a UTF-8 string
+struct Grapheme
+{
+	uint32_t offset;			// of its first byte
+	char32_t base;				// its first code point, which the rest are drawn on or into
+	GraphemeWidthClass width;	// of the cluster: its base's, or Wide for a base with emoji presentation selected
+};
+
+// Appends every extended grapheme cluster of inText, then an empty one at inText.size(), so cluster i is the bytes
+// from outGraphemes[i].offset up to outGraphemes[i + 1].offset. Implements all of UAX #29 from the Unicode 14
+// properties, plus the Indic conjunct rule (GB9c) from Unicode 15.1 for the six scripts it covers.
+void IndexGraphemes(std::string_view inText, std::vector<Grapheme>& outGraphemes);
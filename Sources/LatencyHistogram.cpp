@@ -0,0 +1,87 @@
+//==============================================================================
+/**
+@file       LatencyHistogram.cpp
+
+@brief      Lock-free log2 histogram of latencies
+
+@copyright  (c) 2021, bionyx187
+			This source code is licensed under the MIT-style license found in the LICENSE file.
+
+**/
+//==============================================================================
+
+#include "LatencyHistogram.h"
+
+#include <algorithm>
+
+// The number of bits needed to hold inValue, which is 0 for 0
+static int BitWidth(unsigned long long inValue)
+{
+	int width = 0;
+	while (inValue != 0) {
+		inValue >>= 1;
+		++width;
+	}
+	return width;
+}
+
+void LatencyHistogram::Record(std::chrono::steady_clock::duration inLatency)
+{
+	auto micros = static_cast<unsigned long long>(std::max<long long>(0, std::chrono::duration_cast<std::chrono::microseconds>(inLatency).count()));
+	auto bucket = std::min<int>(kBuckets - 1, BitWidth(micros));
+
+	mBuckets[bucket].fetch_add(1, std::memory_order_relaxed);
+	mCount.fetch_add(1, std::memory_order_relaxed);
+	mTotal.fetch_add(micros, std::memory_order_relaxed);
+
+	auto max = mMax.load(std::memory_order_relaxed);
+	while (micros > max && !mMax.compare_exchange_weak(max, micros, std::memory_order_relaxed)) {
+	}
+}
+
+int LatencyHistogram::QuantileBucket(double inQuantile) const
+{
+	// The rank of the quantile, counted from 1
+	auto rank = std::max<unsigned long long>(1, static_cast<unsigned long long>(inQuantile * Count() + 0.5));
+	unsigned long long seen = 0;
+	for (int bucket = 0; bucket < kBuckets - 1; ++bucket) {
+		seen += mBuckets[bucket].load(std::memory_order_relaxed);
+		if (seen >= rank) {
+			return bucket;
+		}
+	}
+	return kBuckets - 1;
+}
+
+std::chrono::microseconds LatencyHistogram::Quantile(double inQuantile) const
+{
+	if (Count() == 0) {
+		return std::chrono::microseconds(0);
+	}
+	auto bound = 1ULL << QuantileBucket(inQuantile);
+	return std::chrono::microseconds(std::min(bound, mMax.load(std::memory_order_relaxed)));
+}
+
+std::string LatencyHistogram::Format(const char* inName, std::chrono::microseconds inBudget) const
+{
+	auto count = Count();
+	std::string line = std::string(inName) + ": count " + std::to_string(count);
+	if (count == 0) {
+		return line;
+	}
+
+	line += " mean " + std::to_string(mTotal.load(std::memory_order_relaxed) / count) + "us" +
+		" p50<" + std::to_string(Quantile(0.5).count()) + "us" +
+		" p90<" + std::to_string(Quantile(0.9).count()) + "us" +
+		" p99<" + std::to_string(Quantile(0.99).count()) + "us" +
+		" max " + std::to_string(mMax.load(std::memory_order_relaxed)) + "us" +
+		" budget " + std::to_string(inBudget.count()) + "us";
+
+	// Quantiles are upper bounds, so this only fires once p99's bucket starts past the budget.
+	auto bucket = QuantileBucket(0.99);
+	auto lowerBound = std::chrono::microseconds(bucket > 0 ? 1ULL << (bucket - 1) : 0);
+	if (lowerBound >= inBudget) {
+		line += " OVER BUDGET";
+	}
+	return line;
+}
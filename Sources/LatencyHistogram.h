@@ -0,0 +1,61 @@
+//==============================================================================
+/**
+@file       LatencyHistogram.h
+
+@brief      Lock-free log2 histogram of latencies
+
+@copyright  (c) 2021, bionyx187
+			This source code is licensed under the MIT-style license found in the LICENSE file.
+
+**/
+//==============================================================================
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <string>
+
+// Bucket i counts latencies below 2^i microseconds that didn't fit in bucket i - 1, so quantiles
+// are only known to within a factor of two. That is plenty to hold a stage to a budget, and
+// recording is a handful of relaxed atomic adds from any thread.
+class LatencyHistogram
+{
+public:
+	static constexpr int kBuckets = 32; // the last bucket takes everything from about 18 minutes up
+
+	void Record(std::chrono::steady_clock::duration inLatency);
+
+	unsigned long long Count() const { return mCount.load(std::memory_order_relaxed); }
+	unsigned long long TotalMicros() const { return mTotal.load(std::memory_order_relaxed); }
+	unsigned long long BucketCount(int inBucket) const { return mBuckets[inBucket].load(std::memory_order_relaxed); }
+
+	// Upper bound of the bucket holding the given quantile (0 to 1), or the maximum if that is lower
+	std::chrono::microseconds Quantile(double inQuantile) const;
+
+	// One line for the log: count, mean, p50, p90, p99 and max, and whether p99 is over inBudget
+	std::string Format(const char* inName, std::chrono::microseconds inBudget) const;
+
+private:
+	int QuantileBucket(double inQuantile) const;
+
+	std::atomic<unsigned long long> mBuckets[kBuckets] = {};
+	std::atomic<unsigned long long> mCount{ 0 };
+	std::atomic<unsigned long long> mTotal{ 0 };	// microseconds
+	std::atomic<unsigned long long> mMax{ 0 };		// microseconds
+};
+
+// Records the time from its construction to the end of the scope
+class ScopedLatency
+{
+public:
+	explicit ScopedLatency(LatencyHistogram& inHistogram) : mHistogram(inHistogram), mStart(std::chrono::steady_clock::now()) { }
+	~ScopedLatency() { mHistogram.Record(std::chrono::steady_clock::now() - mStart); }
+
+	ScopedLatency(const ScopedLatency&) = delete;
+	ScopedLatency& operator=(const ScopedLatency&) = delete;
+
+private:
+	LatencyHistogram& mHistogram;
+	std::chrono::steady_clock::time_point mStart;
+};
@@ -0,0 +1,23 @@
+//==============================================================================
+/**
+@file       pch.cpp
+
+@brief		Precompiled header for the Linux build
+
+@copyright  (c) 2021, bionyx187
+			This source code is licensed under the MIT-style license found in the LICENSE file.
+
+**/
+//==============================================================================
+
+#include <cstdarg>
+#include <cstdio>
+
+// There is no debugger output window to speak of, so debug output goes to stderr
+void dbgprintf(const char *format, ...)
+{
+	va_list arg;
+	va_start(arg, format);
+	std::vfprintf(stderr, format, arg);
+	va_end(arg);
+}
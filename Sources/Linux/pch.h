@@ -0,0 +1,60 @@
+//==============================================================================
+/**
+@file       pch.h
+
+@brief		Precompiled header for the Linux build
+
+@copyright  (c) 2021, bionyx187
+			This source code is licensed under the MIT-style license found in the LICENSE file.
+
+**/
+//==============================================================================
+
+#ifndef PCH_H
+#define PCH_H
+
+//-------------------------------------------------------------------
+// C++ headers
+//-------------------------------------------------------------------
+
+#include <string>
+#include <set>
+#include <thread>
+
+//-------------------------------------------------------------------
+// Debug logging
+//-------------------------------------------------------------------
+
+#ifdef NDEBUG
+	#define DEBUG 0
+#else
+	#define DEBUG 1
+#endif
+
+#define ASIO_STANDALONE
+
+void dbgprintf(const char *format, ...);
+
+#if DEBUG
+#define DebugPrint			dbgprintf
+#else
+#define DebugPrint(...)		while(0)
+#endif
+
+
+//-------------------------------------------------------------------
+// json
+//-------------------------------------------------------------------
+
+#include "../Vendor/json/src/json.hpp"
+using json = nlohmann::json;
+
+
+// Logging categories that start out at the Debug level. Any category can be turned up
+// at runtime from the property inspector; see Logger.h.
+
+#define LOG_SESSIONS 0
+#define LOG_EVENTS 0
+#define LOG_MESSAGES 0
+
+#endif //PCH_H
@@ -0,0 +1,608 @@
+//==============================================================================
+/**
+@file       LoadGenerator.cpp
+
+@brief      Stands in for the Stream Deck application to put the plugin under load
+
+@copyright  (c) 2021, bionyx187
+			This source code is licensed under the MIT-style license found in the LICENSE file.
+
+**/
+//==============================================================================
+
+// Listens on ws://127.0.0.1:<port> like the Stream Deck application, optionally launches the plugin
+// pointed at it, and after the registration handshake makes any number of keys appear. It then keeps
+// sending scripted storms of willDisappear/willAppear, titleParametersDidChange and didReceiveSettings
+// while recording every setTitle and setImage the plugin sends back. At the end it reports frames/s,
+// bytes/s, the inter-frame jitter of each context and the CPU time the plugin used.
+//
+// LoadGenerator [-plugin <path to media.exe>] [-port 28196] [-keys 100] [-duration 60]
+//               [-churn-interval 1000] [-churn-keys 10] [-refresh 250] [-record frames.csv]
+
+#include <websocketpp/config/asio_no_tls.hpp>
+#include <websocketpp/server.hpp>
+
+#include "../Vendor/json/src/json.hpp"
+#include "../Common/ESDSDKDefines.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+
+#ifdef _WIN32
+#include <Windows.h>
+#else
+#include <signal.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+using json = nlohmann::json;
+using Clock = std::chrono::steady_clock;
+typedef websocketpp::server<websocketpp::config::asio> WebsocketServer;
+
+static const char kAction[] = "com.bionyx187.media.media";
+static const char kDeviceID[] = "LOADGENERATOR";
+static const char kPluginUUID[] = "LOADGENERATOR-PLUGIN";
+
+struct Options
+{
+	int port = 28196;
+	std::string pluginPath;
+	int keys = 100;
+	int durationSeconds = 60;
+	int churnIntervalMs = 1000;
+	int churnKeys = 10;
+	int refreshMs = 250;
+	std::string recordPath;
+};
+
+// Frames received for one context. The plugin ticks a key on a grid of deadlines one period apart that starts
+// when the key is (re)scheduled, and skips frames that are the same as the one before. The first title after a
+// restart lays down the grid; every later one is due at the last deadline of the grid it has reached, at or after
+// the one following the previous title, and its lateness is how long after that it arrived. Latenesses are in
+// milliseconds, with mean and variance kept with Welford's method so nothing per frame has to be stored. Frames for
+// a key that has disappeared aren't paced; they are only counted.
+struct ContextStats
+{
+	bool visible = false;
+	unsigned long long titles = 0;
+	unsigned long long images = 0;
+	unsigned long long bytes = 0;
+	unsigned long long hiddenFrames = 0; // setTitle and setImage after willDisappear
+
+	double periodMs = 0; // the refresh time the key was last given
+	bool hasGrid = false;
+	Clock::time_point nextDeadline;
+	unsigned long long pacedFrames = 0;
+	double meanLateness = 0;
+	double m2 = 0;
+	double maxLateness = 0;
+
+	double Jitter() const { return pacedFrames > 1 ? std::sqrt(m2 / (pacedFrames - 1)) : 0; }
+};
+
+//-------------------------------------------------------------------
+// The plugin process
+//-------------------------------------------------------------------
+
+class PluginProcess
+{
+public:
+	bool Launch(const std::string& inPath, int inPort, const std::string& inInfo);
+
+	// Stops the plugin and returns the CPU time it used, user and kernel, in seconds
+	double Terminate();
+
+private:
+#ifdef _WIN32
+	PROCESS_INFORMATION mProcess = {};
+#else
+	pid_t mPid = -1;
+#endif
+	bool mRunning = false;
+};
+
+#ifdef _WIN32
+
+static std::string QuoteArgument(const std::string& inArgument)
+{
+	std::string quoted = "\"";
+	for (char c : inArgument) {
+		if (c == '"') {
+			quoted += '\\';
+		}
+		quoted += c;
+	}
+	return quoted + "\"";
+}
+
+bool PluginProcess::Launch(const std::string& inPath, int inPort, const std::string& inInfo)
+{
+	std::string commandLine = QuoteArgument(inPath) +
+		" " kESDSDKPortParameter " " + std::to_string(inPort) +
+		" " kESDSDKPluginUUIDParameter " " + kPluginUUID +
+		" " kESDSDKRegisterEventParameter " " kESDSDKRegisterPlugin
+		" " kESDSDKInfoParameter " " + QuoteArgument(inInfo);
+
+	STARTUPINFOA startup = {};
+	startup.cb = sizeof(startup);
+	mRunning = CreateProcessA(nullptr, &commandLine[0], nullptr, nullptr, FALSE, 0, nullptr, nullptr, &startup, &mProcess) != 0;
+	return mRunning;
+}
+
+double PluginProcess::Terminate()
+{
+	if (!mRunning) {
+		return 0;
+	}
+	mRunning = false;
+
+	FILETIME creation, exit, kernel, user;
+	double seconds = 0;
+	if (GetProcessTimes(mProcess.hProcess, &creation, &exit, &kernel, &user)) {
+		auto ticks = [](const FILETIME& inTime) { return (static_cast<unsigned long long>(inTime.dwHighDateTime) << 32) | inTime.dwLowDateTime; };
+		seconds = (ticks(kernel) + ticks(user)) / 1e7;
+	}
+	TerminateProcess(mProcess.hProcess, 0);
+	WaitForSingleObject(mProcess.hProcess, INFINITE);
+	CloseHandle(mProcess.hThread);
+	CloseHandle(mProcess.hProcess);
+	return seconds;
+}
+
+#else
+
+bool PluginProcess::Launch(const std::string& inPath, int inPort, const std::string& inInfo)
+{
+	std::string port = std::to_string(inPort);
+	mPid = fork();
+	if (mPid == 0) {
+		execl(inPath.c_str(), inPath.c_str(),
+			kESDSDKPortParameter, port.c_str(),
+			kESDSDKPluginUUIDParameter, kPluginUUID,
+			kESDSDKRegisterEventParameter, kESDSDKRegisterPlugin,
+			kESDSDKInfoParameter, inInfo.c_str(),
+			static_cast<char*>(nullptr));
+		_exit(127);
+	}
+	mRunning = mPid > 0;
+	return mRunning;
+}
+
+double PluginProcess::Terminate()
+{
+	if (!mRunning) {
+		return 0;
+	}
+	mRunning = false;
+
+	kill(mPid, SIGTERM);
+	int status = 0;
+	struct rusage usage = {};
+	wait4(mPid, &status, 0, &usage);
+	return usage.ru_utime.tv_sec + usage.ru_utime.tv_usec / 1e6 + usage.ru_stime.tv_sec + usage.ru_stime.tv_usec / 1e6;
+}
+
+#endif
+
+//-------------------------------------------------------------------
+// The fake Stream Deck application
+//-------------------------------------------------------------------
+
+class LoadGenerator
+{
+public:
+	explicit LoadGenerator(const Options& inOptions);
+
+	void Run();
+
+private:
+	void OnMessage(websocketpp::connection_hdl inConnection, WebsocketServer::message_ptr inMessage);
+	void OnClose(websocketpp::connection_hdl inConnection);
+
+	void Send(const json& inMessage);
+	void SendKeyEvent(const char* inEvent, size_t inKey, json inPayload);
+	void Appear(size_t inKey);
+	void Disappear(size_t inKey);
+	void SendTitleParameters(size_t inKey, int inFontSize);
+	void SendSettings(size_t inKey, int inRefreshMs);
+	void RestartPacing(size_t inKey);
+	json Settings(int inRefreshMs) const;
+
+	void ScheduleChurn();
+	void Churn();
+	void Record(const std::string& inEvent, const std::string& inContext, size_t inBytes);
+	void Finish();
+	void Report(double inPluginSeconds);
+
+	Options mOptions;
+	WebsocketServer mServer;
+	websocketpp::connection_hdl mPlugin;
+	bool mRegistered = false;
+	std::unique_ptr<asio::steady_timer> mChurnTimer;
+	std::unique_ptr<asio::steady_timer> mEndTimer;
+	std::mt19937 mRandom{ 187 };
+
+	PluginProcess mProcess;
+
+	std::vector<std::string> mContexts;
+	std::map<std::string, ContextStats> mStats;
+	Clock::time_point mStart;
+	Clock::time_point mEnd;
+	unsigned long long mEventsSent = 0;
+	std::ofstream mRecord;
+};
+
+LoadGenerator::LoadGenerator(const Options& inOptions) :
+	mOptions(inOptions)
+{
+	for (int i = 0; i < mOptions.keys; ++i) {
+		mContexts.push_back("LOADGENERATOR-CONTEXT-" + std::to_string(i));
+	}
+
+	if (!mOptions.recordPath.empty()) {
+		mRecord.open(mOptions.recordPath);
+		mRecord << "microseconds,event,context,bytes\n";
+	}
+}
+
+void LoadGenerator::Run()
+{
+	mServer.clear_access_channels(websocketpp::log::alevel::all);
+	mServer.init_asio();
+	mServer.set_reuse_addr(true);
+	mServer.set_message_handler([this](websocketpp::connection_hdl inConnection, WebsocketServer::message_ptr inMessage) { OnMessage(inConnection, inMessage); });
+	mServer.set_close_handler([this](websocketpp::connection_hdl inConnection) { OnClose(inConnection); });
+	mServer.listen(asio::ip::tcp::endpoint(asio::ip::address_v4::loopback(), static_cast<unsigned short>(mOptions.port)));
+	mServer.start_accept();
+
+	mChurnTimer = std::make_unique<asio::steady_timer>(mServer.get_io_service());
+	mEndTimer = std::make_unique<asio::steady_timer>(mServer.get_io_service());
+
+	json info;
+	info[kESDSDKApplicationInfo] = { { kESDSDKApplicationInfoLanguage, "en" }, { kESDSDKApplicationInfoPlatform, "windows" }, { kESDSDKApplicationInfoVersion, "4.9" } };
+	info[kESDSDKPluginInfo] = { { kESDSDKApplicationInfoVersion, "1.0" } };
+	info[kESDSDKDevicePixelRatio] = 1;
+	info[kESDSDKDevicesInfo] = json::array({ { { kESDSDKDeviceInfoID, kDeviceID }, { kESDSDKDeviceInfoName, "Load generator" }, { kESDSDKDeviceInfoType, 0 },
+		{ kESDSDKDeviceInfoSize, { { kESDSDKDeviceInfoSizeColumns, 8 }, { kESDSDKDeviceInfoSizeRows, 4 } } } } });
+
+	if (!mOptions.pluginPath.empty()) {
+		if (!mProcess.Launch(mOptions.pluginPath, mOptions.port, info.dump())) {
+			std::fprintf(stderr, "Could not start %s\n", mOptions.pluginPath.c_str());
+			return;
+		}
+	}
+	else {
+		std::printf("Waiting for a plugin started with:\n  " kESDSDKPortParameter " %d " kESDSDKPluginUUIDParameter " %s " kESDSDKRegisterEventParameter " " kESDSDKRegisterPlugin " " kESDSDKInfoParameter " '%s'\n",
+			mOptions.port, kPluginUUID, info.dump().c_str());
+	}
+
+	mServer.run();
+}
+
+void LoadGenerator::OnMessage(websocketpp::connection_hdl inConnection, WebsocketServer::message_ptr inMessage)
+{
+	const auto& payload = inMessage->get_payload();
+	json message = json::parse(payload, nullptr, false);
+	if (message.is_discarded() || !message.is_object()) {
+		return;
+	}
+	std::string event = message.value(kESDSDKCommonEvent, "");
+
+	if (!mRegistered) {
+		if (event != kESDSDKRegisterPlugin || message.value(kESDSDKRegisterUUID, "") != kPluginUUID) {
+			return;
+		}
+		mRegistered = true;
+		mPlugin = inConnection;
+		mStart = Clock::now();
+
+		// The opening storm: every key appears at once, like switching to a profile full of them.
+		for (size_t key = 0; key < mContexts.size(); ++key) {
+			Appear(key);
+		}
+
+		ScheduleChurn();
+		mEndTimer->expires_after(std::chrono::seconds(mOptions.durationSeconds));
+		mEndTimer->async_wait([this](const asio::error_code& ec) {
+			if (!ec) {
+				Finish();
+			}
+		});
+		return;
+	}
+
+	if (event == kESDSDKEventSetTitle || event == kESDSDKEventSetImage) {
+		Record(event, message.value(kESDSDKCommonContext, ""), payload.size());
+	}
+}
+
+void LoadGenerator::OnClose(websocketpp::connection_hdl inConnection)
+{
+	if (mRegistered && !mPlugin.owner_before(inConnection) && !inConnection.owner_before(mPlugin)) {
+		std::fprintf(stderr, "The plugin disconnected early\n");
+		Finish();
+	}
+}
+
+void LoadGenerator::Send(const json& inMessage)
+{
+	asio::error_code ec;
+	mServer.send(mPlugin, inMessage.dump(), websocketpp::frame::opcode::text, ec);
+	++mEventsSent;
+}
+
+void LoadGenerator::SendKeyEvent(const char* inEvent, size_t inKey, json inPayload)
+{
+	json message;
+	message[kESDSDKCommonAction] = kAction;
+	message[kESDSDKCommonEvent] = inEvent;
+	message[kESDSDKCommonContext] = mContexts[inKey];
+	message[kESDSDKCommonDevice] = kDeviceID;
+	inPayload[kESDSDKPayloadCoordinates] = { { kESDSDKPayloadCoordinatesColumn, inKey % 8 }, { kESDSDKPayloadCoordinatesRow, inKey / 8 } };
+	message[kESDSDKCommonPayload] = std::move(inPayload);
+	Send(message);
+}
+
+json LoadGenerator::Settings(int inRefreshMs) const
+{
+	return { { "refresh_time", inRefreshMs } };
+}
+
+void LoadGenerator::Appear(size_t inKey)
+{
+	SendKeyEvent(kESDSDKEventWillAppear, inKey, { { kESDSDKPayloadSettings, Settings(mOptions.refreshMs) }, { kESDSDKPayloadIsInMultiAction, false } });
+	auto& stats = mStats[mContexts[inKey]];
+	stats.visible = true;
+	stats.periodMs = mOptions.refreshMs;
+	RestartPacing(inKey);
+
+	// The application follows up every willAppear with the title parameters.
+	SendTitleParameters(inKey, 12);
+}
+
+void LoadGenerator::Disappear(size_t inKey)
+{
+	SendKeyEvent(kESDSDKEventWillDisappear, inKey, { { kESDSDKPayloadSettings, Settings(mOptions.refreshMs) }, { kESDSDKPayloadIsInMultiAction, false } });
+	mStats[mContexts[inKey]].visible = false;
+
+	// The gap until the key reappears isn't jitter.
+	RestartPacing(inKey);
+}
+
+void LoadGenerator::SendTitleParameters(size_t inKey, int inFontSize)
+{
+	json parameters = {
+		{ kESDSDKTitleParametersFontFamily, "" },
+		{ kESDSDKTitleParametersFontSize, inFontSize },
+		{ kESDSDKTitleParametersFontStyle, "" },
+		{ kESDSDKTitleParametersFontUnderline, false },
+		{ kESDSDKTitleParametersShowTitle, true },
+		{ kESDSDKTitleParametersTitleAlignment, "bottom" },
+		{ kESDSDKTitleParametersTitleColor, "#ffffff" }
+	};
+	SendKeyEvent(kESDSDKEventTitleParametersDidChange, inKey, { { kESDSDKPayloadSettings, Settings(mOptions.refreshMs) }, { kESDSDKPayloadState, 0 }, { kESDSDKPayloadTitle, "" }, { kESDSDKPayloadTitleParameters, parameters } });
+
+	// A new font wakes a parked key, due right away.
+	RestartPacing(inKey);
+}
+
+void LoadGenerator::SendSettings(size_t inKey, int inRefreshMs)
+{
+	SendKeyEvent(kESDSDKEventDidReceiveSettings, inKey, { { kESDSDKPayloadSettings, Settings(inRefreshMs) }, { kESDSDKPayloadIsInMultiAction, false } });
+
+	// The key is rescheduled on the new period, due right away.
+	mStats[mContexts[inKey]].periodMs = inRefreshMs;
+	RestartPacing(inKey);
+}
+
+// The key starts over on a new deadline grid, so the gap to its next frame says nothing about pacing.
+void LoadGenerator::RestartPacing(size_t inKey)
+{
+	mStats[mContexts[inKey]].hasGrid = false;
+}
+
+void LoadGenerator::ScheduleChurn()
+{
+	if (mOptions.churnIntervalMs <= 0 || mOptions.churnKeys <= 0) {
+		return;
+	}
+	mChurnTimer->expires_after(std::chrono::milliseconds(mOptions.churnIntervalMs));
+	mChurnTimer->async_wait([this](const asio::error_code& ec) {
+		if (!ec) {
+			Churn();
+			ScheduleChurn();
+		}
+	});
+}
+
+// One storm: a random handful of keys each get one of the things that happen to keys in real use.
+void LoadGenerator::Churn()
+{
+	static const int kFontSizes[] = { 9, 12, 16, 24 };
+	static const int kRefreshTimes[] = { 100, 250, 500 };
+
+	std::uniform_int_distribution<size_t> pickKey(0, mContexts.size() - 1);
+	std::uniform_int_distribution<int> pickAction(0, 2);
+	std::uniform_int_distribution<int> pickOption(0, 2);
+	for (int i = 0; i < mOptions.churnKeys && !mContexts.empty(); ++i) {
+		auto key = pickKey(mRandom);
+		switch (pickAction(mRandom)) {
+		case 0:
+			// Switching away from the profile and back
+			if (mStats[mContexts[key]].visible) {
+				Disappear(key);
+			}
+			Appear(key);
+			break;
+		case 1:
+			SendTitleParameters(key, kFontSizes[pickOption(mRandom)]);
+			break;
+		case 2:
+			SendSettings(key, kRefreshTimes[pickOption(mRandom)]);
+			break;
+		}
+	}
+}
+
+void LoadGenerator::Record(const std::string& inEvent, const std::string& inContext, size_t inBytes)
+{
+	auto now = Clock::now();
+	auto& stats = mStats[inContext];
+	stats.bytes += inBytes;
+	if (!stats.visible) {
+		++stats.hiddenFrames;
+	}
+	else if (inEvent == kESDSDKEventSetTitle) {
+		++stats.titles;
+	}
+	else {
+		++stats.images;
+	}
+
+	// Only the scroll frames of visible keys are paced.
+	if (inEvent == kESDSDKEventSetTitle && stats.visible && stats.periodMs > 0) {
+		std::chrono::duration<double, std::milli> period(stats.periodMs);
+		auto step = std::chrono::duration_cast<Clock::duration>(period);
+		if (!stats.hasGrid || now < stats.nextDeadline) {
+			// The first frame on a new grid, or one that comes before its deadline, which means the frame that laid
+			// the grid down was late. Either way the grid starts over from this one.
+			stats.hasGrid = true;
+			stats.nextDeadline = now + step;
+		}
+		else {
+			// Frames that are the same as the one before weren't sent, so this is due on the last deadline it
+			// has reached.
+			auto skipped = (now - stats.nextDeadline) / step;
+			auto deadline = stats.nextDeadline + skipped * step;
+			double lateness = std::chrono::duration<double, std::milli>(now - deadline).count();
+			++stats.pacedFrames;
+			double delta = lateness - stats.meanLateness;
+			stats.meanLateness += delta / stats.pacedFrames;
+			stats.m2 += delta * (lateness - stats.meanLateness);
+			stats.maxLateness = std::max(stats.maxLateness, lateness);
+			stats.nextDeadline = deadline + step;
+		}
+	}
+
+	if (mRecord.is_open()) {
+		mRecord << std::chrono::duration_cast<std::chrono::microseconds>(now - mStart).count() << ',' << inEvent << ',' << inContext << ',' << inBytes << '\n';
+	}
+}
+
+void LoadGenerator::Finish()
+{
+	if (mEnd != Clock::time_point()) {
+		return;
+	}
+	mEnd = Clock::now();
+
+	asio::error_code ec;
+	mChurnTimer->cancel(ec);
+	mEndTimer->cancel(ec);
+
+	// The plugin's CPU time is taken before it gets to react to the connection going away.
+	auto pluginSeconds = mProcess.Terminate();
+	Report(pluginSeconds);
+
+	mServer.stop_listening(ec);
+	mServer.stop();
+}
+
+void LoadGenerator::Report(double inPluginSeconds)
+{
+	double seconds = std::chrono::duration<double>(mEnd - mStart).count();
+	unsigned long long titles = 0;
+	unsigned long long images = 0;
+	unsigned long long bytes = 0;
+	unsigned long long hiddenFrames = 0;
+	double jitterSum = 0;
+	size_t jitterContexts = 0;
+	std::vector<std::pair<double, std::string>> worst;
+	for (const auto& context : mStats) {
+		titles += context.second.titles;
+		images += context.second.images;
+		bytes += context.second.bytes;
+		hiddenFrames += context.second.hiddenFrames;
+		if (context.second.pacedFrames > 1) {
+			jitterSum += context.second.Jitter();
+			++jitterContexts;
+			worst.emplace_back(context.second.Jitter(), context.first);
+		}
+	}
+	std::sort(worst.rbegin(), worst.rend());
+
+	std::printf("%d keys, %.1f s, %llu events sent\n", mOptions.keys, seconds, mEventsSent);
+	std::printf("setTitle: %llu (%.1f/s)  setImage: %llu (%.1f/s)  %.1f KB/s\n", titles, titles / seconds, images, images / seconds, bytes / seconds / 1024);
+	std::printf("frames after willDisappear: %llu\n", hiddenFrames);
+	std::printf("mean lateness jitter: %.2f ms over %zu contexts\n", jitterContexts > 0 ? jitterSum / jitterContexts : 0.0, jitterContexts);
+	for (size_t i = 0; i < worst.size() && i < 5; ++i) {
+		const auto& stats = mStats[worst[i].second];
+		std::printf("  %s: %llu frames, period %.0f ms, mean lateness %.1f ms, jitter %.2f ms, max lateness %.1f ms\n",
+			worst[i].second.c_str(), stats.titles, stats.periodMs, stats.meanLateness, worst[i].first, stats.maxLateness);
+	}
+	if (!mOptions.pluginPath.empty()) {
+		std::printf("plugin CPU time: %.2f s (%.1f%% of one core)\n", inPluginSeconds, 100 * inPluginSeconds / seconds);
+	}
+}
+
+int main(int argc, const char* const argv[])
+{
+	Options options;
+	for (int i = 1; i + 1 < argc; i += 2) {
+		std::string parameter(argv[i]);
+		std::string value(argv[i + 1]);
+		if (parameter == "-plugin") {
+			options.pluginPath = value;
+		}
+		else if (parameter == "-port") {
+			options.port = std::atoi(value.c_str());
+		}
+		else if (parameter == "-keys") {
+			options.keys = std::atoi(value.c_str());
+		}
+		else if (parameter == "-duration") {
+			options.durationSeconds = std::atoi(value.c_str());
+		}
+		else if (parameter == "-churn-interval") {
+			options.churnIntervalMs = std::atoi(value.c_str());
+		}
+		else if (parameter == "-churn-keys") {
+			options.churnKeys = std::atoi(value.c_str());
+		}
+		else if (parameter == "-refresh") {
+			options.refreshMs = std::atoi(value.c_str());
+		}
+		else if (parameter == "-record") {
+			options.recordPath = value;
+		}
+		else {
+			std::fprintf(stderr, "Unknown parameter %s\n", parameter.c_str());
+			return 1;
+		}
+	}
+
+	if (options.port == 0 || options.keys <= 0 || options.durationSeconds <= 0) {
+		std::fprintf(stderr, "Invalid parameters\n");
+		return 1;
+	}
+
+	try {
+		LoadGenerator generator(options);
+		generator.Run();
+	}
+	catch (const std::exception& e) {
+		std::fprintf(stderr, "%s\n", e.what());
+		return 1;
+	}
+	return 0;
+}
@@ -0,0 +1,167 @@
+//==============================================================================
+/**
+@file       Logger.cpp
+
+@brief      Leveled, per-category logging, written to a file by a background thread
+
+@copyright  (c) 2021, bionyx187
+			This source code is licensed under the MIT-style license found in the LICENSE file.
+
+**/
+//==============================================================================
+
+#include "Logger.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <fstream>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+static const char* const kLevelNames[] = { "off", "error", "warning", "info", "debug" };
+static const char* const kCategoryNames[] = { "events", "messages", "sessions", "media", "artwork", "ticks", "diagnostics" };
+static_assert(sizeof(kCategoryNames) / sizeof(kCategoryNames[0]) == static_cast<size_t>(LogCategory::Count), "every category needs a name");
+
+// LOG_EVENTS and friends in pch.h pick the categories that start out at Debug. Everything else starts at Warning,
+// apart from Diagnostics, which is only ever written when asked for.
+static constexpr LogLevel InitialLevel(bool inVerbose) { return inVerbose ? LogLevel::Debug : LogLevel::Warning; }
+
+std::atomic<LogLevel> Logger::sLevels[static_cast<int>(LogCategory::Count)] = {
+	{ InitialLevel(LOG_EVENTS) },
+	{ InitialLevel(LOG_MESSAGES) },
+	{ InitialLevel(LOG_SESSIONS) },
+	{ InitialLevel(false) },
+	{ InitialLevel(false) },
+	{ InitialLevel(false) },
+	{ LogLevel::Info }
+};
+
+struct LogEntry
+{
+	std::chrono::steady_clock::time_point time;
+	LogCategory category;
+	LogLevel level;
+	std::string message;
+};
+
+// Up to kQueueSize entries. The writer swaps the whole vector for its empty one under the lock and formats it without.
+static std::mutex sMutex;
+static std::condition_variable sWakeup;
+static std::vector<LogEntry> sQueue;			// protected by sMutex
+static unsigned long long sDropped = 0;			// protected by sMutex
+static bool sStopping = false;					// protected by sMutex
+static std::thread sThread;
+static const auto sStartTime = std::chrono::steady_clock::now();
+
+void Logger::SetLevel(LogCategory inCategory, LogLevel inLevel)
+{
+	sLevels[static_cast<int>(inCategory)].store(inLevel, std::memory_order_relaxed);
+}
+
+void Logger::SetLevel(LogLevel inLevel)
+{
+	for (int category = 0; category < static_cast<int>(LogCategory::Count); ++category) {
+		if (category != static_cast<int>(LogCategory::Diagnostics)) {
+			sLevels[category].store(inLevel, std::memory_order_relaxed);
+		}
+	}
+}
+
+bool Logger::ParseLevel(const std::string& inName, LogLevel& outLevel)
+{
+	for (size_t i = 0; i < sizeof(kLevelNames) / sizeof(kLevelNames[0]); ++i) {
+		if (inName == kLevelNames[i]) {
+			outLevel = static_cast<LogLevel>(i);
+			return true;
+		}
+	}
+	return false;
+}
+
+bool Logger::ParseCategory(const std::string& inName, LogCategory& outCategory)
+{
+	for (size_t i = 0; i < sizeof(kCategoryNames) / sizeof(kCategoryNames[0]); ++i) {
+		if (inName == kCategoryNames[i]) {
+			outCategory = static_cast<LogCategory>(i);
+			return true;
+		}
+	}
+	return false;
+}
+
+void Logger::Write(LogCategory inCategory, LogLevel inLevel, std::string inMessage)
+{
+	auto now = std::chrono::steady_clock::now();
+	{
+		std::lock_guard<std::mutex> lock(sMutex);
+		if (sQueue.size() >= kQueueSize) {
+			++sDropped;
+			return;
+		}
+		sQueue.push_back({ now, inCategory, inLevel, std::move(inMessage) });
+	}
+	sWakeup.notify_one();
+}
+
+static void WriteEntries(std::ofstream& ioFile, const std::vector<LogEntry>& inEntries, unsigned long long inDropped)
+{
+	char prefix[64];
+	for (const auto& entry : inEntries) {
+		auto seconds = std::chrono::duration<double>(entry.time - sStartTime).count();
+		std::snprintf(prefix, sizeof(prefix), "[%10.3f] %-7s %-11s ", seconds, kLevelNames[static_cast<int>(entry.level)], kCategoryNames[static_cast<int>(entry.category)]);
+		ioFile << prefix << entry.message << '\n';
+	}
+	if (inDropped > 0) {
+		ioFile << "(" << inDropped << " messages dropped, the log queue was full)\n";
+	}
+	ioFile.flush();
+}
+
+void Logger::Start(const std::string& inPath)
+{
+	std::lock_guard<std::mutex> lock(sMutex);
+	if (sThread.joinable()) {
+		return;
+	}
+	sStopping = false;
+	sQueue.reserve(kQueueSize);
+
+	sThread = std::thread([path = inPath]() {
+		std::ofstream file(path, std::ios::binary | std::ios::trunc);
+		std::vector<LogEntry> entries;
+		entries.reserve(kQueueSize);
+
+		for (;;) {
+			unsigned long long dropped = 0;
+			bool stopping = false;
+			{
+				std::unique_lock<std::mutex> lock(sMutex);
+				sWakeup.wait(lock, []() { return sStopping || !sQueue.empty(); });
+				entries.swap(sQueue);
+				dropped = sDropped;
+				sDropped = 0;
+				stopping = sStopping;
+			}
+
+			WriteEntries(file, entries, dropped);
+			entries.clear();
+			if (stopping) {
+				break;
+			}
+		}
+	});
+}
+
+void Logger::Stop()
+{
+	{
+		std::lock_guard<std::mutex> lock(sMutex);
+		sStopping = true;
+	}
+	sWakeup.notify_one();
+	if (sThread.joinable()) {
+		sThread.join();
+	}
+}
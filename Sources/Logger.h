@@ -0,0 +1,89 @@
+//==============================================================================
+/**
+@file       Logger.h
+
+@brief      Leveled, per-category logging, written to a file by a background thread
+
+@copyright  (c) 2021, bionyx187
+			This source code is licensed under the MIT-style license found in the LICENSE file.
+
+**/
+//==============================================================================
+
+#pragma once
+
+#include <atomic>
+#include <string>
+
+enum class LogLevel
+{
+	Off,
+	Error,
+	Warning,
+	Info,
+	Debug
+};
+
+enum class LogCategory
+{
+	Events,			// Stream Deck events received by the plugin
+	Messages,		// Every raw message from the Stream Deck application
+	Sessions,		// The media sessions seen on every refresh
+	Media,			// Media state changes and media source errors
+	Artwork,
+	Ticks,
+	Diagnostics,	// Output asked for from the property inspector
+
+	Count
+};
+
+// Messages above this level aren't compiled in at all
+#if DEBUG
+static constexpr LogLevel kLogMaxLevel = LogLevel::Debug;
+#else
+static constexpr LogLevel kLogMaxLevel = LogLevel::Info;
+#endif
+
+// Use LOG rather than calling Write directly: it only builds the message when its category is enabled
+// at that level. Code that does work just to log checks LOG_ENABLED first. Write only queues the
+// message. A background thread writes the queue to the log file, so logging never waits on the disk
+// and never shares the websocket with the keys. When the queue is full, messages are dropped and the
+// drop is counted in the log.
+class Logger
+{
+public:
+	static constexpr size_t kQueueSize = 1024;
+
+	static bool IsEnabled(LogCategory inCategory, LogLevel inLevel)
+	{
+		return inLevel <= kLogMaxLevel && inLevel <= sLevels[static_cast<int>(inCategory)].load(std::memory_order_relaxed);
+	}
+
+	static void SetLevel(LogCategory inCategory, LogLevel inLevel);
+	// Every category but Diagnostics, which is only written when asked for and so isn't turned down with the rest
+	static void SetLevel(LogLevel inLevel);
+
+	// Names as used by the property inspector: "off", "error", "warning", "info", "debug", and the
+	// category names in lower case. Return false for anything else.
+	static bool ParseLevel(const std::string& inName, LogLevel& outLevel);
+	static bool ParseCategory(const std::string& inName, LogCategory& outCategory);
+
+	static void Write(LogCategory inCategory, LogLevel inLevel, std::string inMessage);
+
+	// Starts the writer thread on the given file, replacing what was in it. Messages queued before
+	// this are kept. Stop writes out what is left in the queue.
+	static void Start(const std::string& inPath);
+	static void Stop();
+
+private:
+	static std::atomic<LogLevel> sLevels[static_cast<int>(LogCategory::Count)];
+};
+
+#define LOG(category, level, ...) \
+	do { \
+		if (Logger::IsEnabled(LogCategory::category, LogLevel::level)) { \
+			Logger::Write(LogCategory::category, LogLevel::level, __VA_ARGS__); \
+		} \
+	} while (0)
+
+#define LOG_ENABLED(category, level) Logger::IsEnabled(LogCategory::category, LogLevel::level)
@@ -0,0 +1,48 @@
+//==============================================================================
+/**
+@file       MappedFile.h
+
+@brief      A fixed-size file mapped read/write into memory
+
+@copyright  (c) 2021, bionyx187
+			This source code is licensed under the MIT-style license found in the LICENSE file.
+
+**/
+//==============================================================================
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+class MappedFile
+{
+public:
+	MappedFile() { }
+	~MappedFile() { Close(); }
+
+	MappedFile(const MappedFile&) = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+
+	// Open or create the file at inPath, sized to exactly inSize bytes, and map all of it. outCreated is set
+	// when the file didn't exist or had a different size, in which case its contents are meaningless.
+	bool Open(const std::string& inPath, size_t inSize, bool& outCreated);
+	void Close();
+
+	// Write a range of the mapping through to disk before returning
+	void Flush(size_t inOffset, size_t inLength);
+
+	unsigned char* Data() const { return mData; }
+	size_t Size() const { return mSize; }
+
+private:
+	unsigned char* mData = nullptr;
+	size_t mSize = 0;
+
+#ifdef _WIN32
+	HANDLE mFile = INVALID_HANDLE_VALUE;
+	HANDLE mMapping = NULL;
+#else
+	int mFile = -1;
+#endif
+};
@@ -0,0 +1,74 @@
+//==============================================================================
+/**
+@file       MappedFilePosix.cpp
+
+@brief      A fixed-size file mapped read/write into memory
+
+@copyright  (c) 2021, bionyx187
+			This source code is licensed under the MIT-style license found in the LICENSE file.
+
+**/
+//==============================================================================
+
+#include "MappedFile.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+bool MappedFile::Open(const std::string& inPath, size_t inSize, bool& outCreated)
+{
+	Close();
+	outCreated = false;
+
+	mFile = open(inPath.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+	if (mFile < 0) {
+		return false;
+	}
+
+	struct stat info;
+	if (fstat(mFile, &info) != 0 || static_cast<size_t>(info.st_size) != inSize) {
+		if (ftruncate(mFile, static_cast<off_t>(inSize)) != 0) {
+			Close();
+			return false;
+		}
+		outCreated = true;
+	}
+
+	void* data = mmap(nullptr, inSize, PROT_READ | PROT_WRITE, MAP_SHARED, mFile, 0);
+	if (data == MAP_FAILED) {
+		Close();
+		return false;
+	}
+
+	mData = static_cast<unsigned char*>(data);
+	mSize = inSize;
+	return true;
+}
+
+void MappedFile::Close()
+{
+	if (mData != nullptr) {
+		msync(mData, mSize, MS_SYNC);
+		munmap(mData, mSize);
+		mData = nullptr;
+	}
+	if (mFile >= 0) {
+		close(mFile);
+		mFile = -1;
+	}
+	mSize = 0;
+}
+
+void MappedFile::Flush(size_t inOffset, size_t inLength)
+{
+	if (mData == nullptr) {
+		return;
+	}
+
+	// msync wants a page-aligned start
+	size_t pageSize = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+	size_t start = inOffset - (inOffset % pageSize);
+	msync(mData + start, inLength + (inOffset - start), MS_SYNC);
+}
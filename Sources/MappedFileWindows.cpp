@@ -0,0 +1,79 @@
+//==============================================================================
+/**
+@file       MappedFileWindows.cpp
+
+@brief      A fixed-size file mapped read/write into memory
+
+@copyright  (c) 2021, bionyx187
+			This source code is licensed under the MIT-style license found in the LICENSE file.
+
+**/
+//==============================================================================
+
+#include "MappedFile.h"
+
+bool MappedFile::Open(const std::string& inPath, size_t inSize, bool& outCreated)
+{
+	Close();
+	outCreated = false;
+
+	mFile = CreateFileA(inPath.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ, NULL, OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL);
+	if (mFile == INVALID_HANDLE_VALUE) {
+		return false;
+	}
+
+	LARGE_INTEGER size{};
+	if (!GetFileSizeEx(mFile, &size) || static_cast<unsigned long long>(size.QuadPart) != inSize) {
+		LARGE_INTEGER newSize;
+		newSize.QuadPart = static_cast<LONGLONG>(inSize);
+		if (!SetFilePointerEx(mFile, newSize, NULL, FILE_BEGIN) || !SetEndOfFile(mFile)) {
+			Close();
+			return false;
+		}
+		outCreated = true;
+	}
+
+	unsigned long long mappingSize = inSize;
+	mMapping = CreateFileMappingA(mFile, NULL, PAGE_READWRITE, static_cast<DWORD>(mappingSize >> 32), static_cast<DWORD>(mappingSize & 0xFFFFFFFF), NULL);
+	if (mMapping == NULL) {
+		Close();
+		return false;
+	}
+
+	mData = static_cast<unsigned char*>(MapViewOfFile(mMapping, FILE_MAP_ALL_ACCESS, 0, 0, inSize));
+	if (mData == nullptr) {
+		Close();
+		return false;
+	}
+
+	mSize = inSize;
+	return true;
+}
+
+void MappedFile::Close()
+{
+	if (mData != nullptr) {
+		FlushViewOfFile(mData, 0);
+		UnmapViewOfFile(mData);
+		mData = nullptr;
+	}
+	if (mMapping != NULL) {
+		CloseHandle(mMapping);
+		mMapping = NULL;
+	}
+	if (mFile != INVALID_HANDLE_VALUE) {
+		CloseHandle(mFile);
+		mFile = INVALID_HANDLE_VALUE;
+	}
+	mSize = 0;
+}
+
+void MappedFile::Flush(size_t inOffset, size_t inLength)
+{
+	if (mData == nullptr) {
+		return;
+	}
+
+	FlushViewOfFile(mData + inOffset, inLength);
+	FlushFileBuffers(mFile);
+}
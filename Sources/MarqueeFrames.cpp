@@ -0,0 +1,257 @@
+//==============================================================================
+/**
+@file       MarqueeFrames.cpp
+
+@brief      Precomputed scroll frames for a title in a given font
+
+@copyright  (c) 2021, bionyx187
+			This source code is licensed under the MIT-style license found in the LICENSE file.
+
+**/
+//==============================================================================
+
+#include "MarqueeFrames.h"
+#include "Trace.h"
+
+#include <algorithm>
+
+ScrollMode ParseScrollMode(const std::string& inName)
+{
+	if (inName == "bounce") {
+		return ScrollMode::Bounce;
+	}
+	if (inName == "page") {
+		return ScrollMode::PageFlip;
+	}
+	if (inName == "ellipsis") {
+		return ScrollMode::Ellipsis;
+	}
+	return ScrollMode::Marquee;
+}
+
+// Room for the title on a key, in the thousandths of a pixel GlyphAdvance measures in
+static constexpr int kTitleBudget = kKeyTitleWidth * 1000;
+
+// The end of the clusters from inFirst on that fit. A cluster wider than the key gets a frame to itself.
+static size_t FitClusters(const std::vector<int>& inWidths, size_t inFirst, int inBudget = kTitleBudget)
+{
+	size_t end = inFirst;
+	int width = 0;
+	while (end < inWidths.size() && (end == inFirst || width + inWidths[end] <= inBudget)) {
+		width += inWidths[end++];
+	}
+	return end;
+}
+
+size_t MarqueeFrames::Dwell(ScrollMode inMode, std::chrono::milliseconds inPeriod)
+{
+	std::chrono::milliseconds hold{ 0 };
+	switch (inMode) {
+	case ScrollMode::Bounce: hold = kBounceHold; break;
+	case ScrollMode::PageFlip: hold = kPageHold; break;
+	default: return 0;
+	}
+
+	// A key without a period ticks as fast as it can, so there's no time to fill.
+	if (inPeriod.count() <= 0) {
+		return 1;
+	}
+	return std::max<size_t>(1, static_cast<size_t>((hold + inPeriod / 2) / inPeriod));
+}
+
+MarqueeFrames::MarqueeFrames(std::string_view inTitle, const std::vector<Grapheme>& inGraphemes, const TitleFont& inFont, ScrollMode inMode, std::chrono::milliseconds inPeriod)
+{
+	TRACE_SCOPE("title", "frame build");
+	if (inTitle.empty() || !inFont.IsKnown()) {
+		return;
+	}
+
+	// Measure the clusters in this font. The offsets come straight from the index, which ends in one at the end of
+	// the title.
+	Clusters clusters;
+	clusters.offsets.reserve(inGraphemes.size());
+	clusters.widths.reserve(inGraphemes.size() - 1);
+	long long width = 0;
+	for (const auto& grapheme : inGraphemes) {
+		clusters.offsets.push_back(grapheme.offset);
+		if (clusters.offsets.size() < inGraphemes.size()) {
+			clusters.widths.push_back(GlyphAdvance(inFont, grapheme));
+			width += clusters.widths.back();
+		}
+	}
+	mArena = inTitle;
+
+	// A title that fits is shown as it is, whatever the mode.
+	if (width <= kTitleBudget) {
+		mFrames.push_back({ 0, mArena.size() });
+		return;
+	}
+
+	switch (inMode) {
+	case ScrollMode::Marquee: BuildMarquee(clusters, inFont); break;
+	case ScrollMode::Bounce: BuildBounce(clusters, Dwell(inMode, inPeriod)); break;
+	case ScrollMode::PageFlip: BuildPages(clusters, Dwell(inMode, inPeriod)); break;
+	case ScrollMode::Ellipsis: BuildEllipsis(clusters, inFont); break;
+	}
+}
+
+// Clusters inFirst up to inEnd, shown for inRepeat ticks
+void MarqueeFrames::AddFrame(const Clusters& inClusters, size_t inFirst, size_t inEnd, size_t inRepeat)
+{
+	mFrames.insert(mFrames.end(), inRepeat, { inClusters.offsets[inFirst], inClusters.offsets[inEnd] });
+}
+
+// Pad the title with a key's width of spaces on both sides, so it enters from the right and leaves on the left, and
+// move one cluster per frame.
+void MarqueeFrames::BuildMarquee(const Clusters& inClusters, const TitleFont& inFont)
+{
+	auto space = GlyphAdvance(inFont, U' ');
+	size_t padding = (kTitleBudget + space - 1) / space;
+	size_t count = inClusters.widths.size();
+	size_t titleSize = mArena.size();
+	mArena.insert(0, padding, ' ');
+	mArena.append(padding, ' ');
+
+	Clusters padded;
+	padded.offsets.reserve(count + 2 * padding + 1);
+	padded.widths.reserve(count + 2 * padding);
+	for (size_t i = 0; i < padding; ++i) {
+		padded.offsets.push_back(i);
+		padded.widths.push_back(space);
+	}
+	for (size_t i = 0; i < count; ++i) {
+		padded.offsets.push_back(padding + inClusters.offsets[i]);
+		padded.widths.push_back(inClusters.widths[i]);
+	}
+	for (size_t i = 0; i < padding; ++i) {
+		padded.offsets.push_back(padding + titleSize + i);
+		padded.widths.push_back(space);
+	}
+	padded.offsets.push_back(mArena.size());
+
+	// The last frame is the first one that is all trailing spaces.
+	size_t last = padding + count;
+	mFrames.reserve(last + 1);
+	for (size_t first = 0; first <= last; ++first) {
+		AddFrame(padded, first, FitClusters(padded.widths, first));
+	}
+}
+
+// Start, pause, slide to the end, pause, slide back. The cycle ends one step short of the start, where it begins again.
+void MarqueeFrames::BuildBounce(const Clusters& inClusters, size_t inDwell)
+{
+	auto count = inClusters.widths.size();
+	std::vector<size_t> ends;
+	for (size_t first = 0; ends.empty() || ends.back() < count; ++first) {
+		ends.push_back(FitClusters(inClusters.widths, first));
+	}
+
+	// A title that fits has nowhere to bounce, and counting back from last would wrap around.
+	size_t last = ends.size() - 1;
+	if (last == 0) {
+		AddFrame(inClusters, 0, ends[0]);
+		return;
+	}
+	mFrames.reserve(2 * last + 2 * inDwell);
+	AddFrame(inClusters, 0, ends[0], inDwell);
+	for (size_t first = 1; first < last; ++first) {
+		AddFrame(inClusters, first, ends[first]);
+	}
+	AddFrame(inClusters, last, ends[last], inDwell);
+	for (size_t first = last - 1; first > 0; --first) {
+		AddFrame(inClusters, first, ends[first]);
+	}
+}
+
+// Fills each page with as many whole words as fit. A word wider than the key is cut into pieces that do.
+void MarqueeFrames::BuildPages(const Clusters& inClusters, size_t inDwell)
+{
+	auto count = inClusters.widths.size();
+	auto isSpace = [&](size_t inCluster) { return mArena[inClusters.offsets[inCluster]] == ' '; };
+
+	size_t pageFirst = 0;
+	size_t pageEnd = 0; // an empty page
+	int pageWidth = 0;
+	size_t i = 0;
+	while (i < count) {
+		if (isSpace(i)) {
+			++i;
+			continue;
+		}
+
+		// The word, and the width of the page if it were added, spaces before it included
+		size_t wordFirst = i;
+		int wordWidth = 0;
+		while (i < count && !isSpace(i)) {
+			wordWidth += inClusters.widths[i++];
+		}
+		int gapWidth = 0;
+		for (size_t gap = pageEnd; pageEnd > pageFirst && gap < wordFirst; ++gap) {
+			gapWidth += inClusters.widths[gap];
+		}
+
+		if (pageEnd > pageFirst && pageWidth + gapWidth + wordWidth <= kTitleBudget) {
+			pageEnd = i;
+			pageWidth += gapWidth + wordWidth;
+			continue;
+		}
+		if (pageEnd > pageFirst) {
+			AddFrame(inClusters, pageFirst, pageEnd, inDwell);
+		}
+
+		// Cut a long word. What is left of it starts the next page.
+		while (wordWidth > kTitleBudget) {
+			size_t cut = FitClusters(inClusters.widths, wordFirst);
+			AddFrame(inClusters, wordFirst, cut, inDwell);
+			for (; wordFirst < cut; ++wordFirst) {
+				wordWidth -= inClusters.widths[wordFirst];
+			}
+		}
+		pageFirst = wordFirst;
+		pageEnd = i;
+		pageWidth = wordWidth;
+	}
+	if (pageEnd > pageFirst) {
+		AddFrame(inClusters, pageFirst, pageEnd, inDwell);
+	}
+}
+
+// As many clusters as fit beside the ellipsis, and always the first, like any other frame
+void MarqueeFrames::BuildEllipsis(const Clusters& inClusters, const TitleFont& inFont)
+{
+	size_t end = FitClusters(inClusters.widths, 0, kTitleBudget - GlyphAdvance(inFont, U'\u2026'));
+	size_t cut = inClusters.offsets[end];
+	while (cut > 0 && mArena[cut - 1] == ' ') {
+		--cut;
+	}
+
+	mArena.resize(cut);
+	mArena += "\xE2\x80\xA6"; // U+2026 in UTF-8
+	mFrames.push_back({ 0, mArena.size() });
+}
+
+std::string_view MarqueeFrames::Frame(size_t inIndex) const
+{
+	if (inIndex >= mFrames.size()) {
+		return std::string_view();
+	}
+	const auto& frame = mFrames[inIndex];
+	return std::string_view(mArena.data() + frame.begin, frame.end - frame.begin);
+}
+
+MarqueeFrameCache::MarqueeFrameCache(std::string inTitle) : mTitle(std::move(inTitle))
+{
+	RepairUTF8(mTitle);
+	IndexGraphemes(mTitle, mGraphemes);
+}
+
+// Keys whose periods come to the same dwell share frames, and the period doesn't matter at all to modes without one.
+std::shared_ptr<const MarqueeFrames> MarqueeFrameCache::Get(const TitleFont& inFont, ScrollMode inMode, std::chrono::milliseconds inPeriod)
+{
+	std::lock_guard<std::mutex> lock(mMutex);
+	auto& table = mTables[{ inMode, inFont, MarqueeFrames::Dwell(inMode, inPeriod) }];
+	if (table == nullptr) {
+		table = std::make_shared<const MarqueeFrames>(mTitle, mGraphemes, inFont, inMode, inPeriod);
+	}
+	return table;
+}
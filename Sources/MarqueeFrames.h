@@ -0,0 +1,107 @@
+//==============================================================================
+/**
+@file       MarqueeFrames.h
+
+@brief      Precomputed scroll frames for a title in a given font
+
+@copyright  (c) 2021, bionyx187
+			This source code is licensed under the MIT-style license found in the LICENSE file.
+
+**/
+//==============================================================================
+
+#pragma once
+
+#include "FontMetrics.h"
+
+#include <chrono>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <vector>
+
+// How a title that doesn't fit on the key is shown
+enum class ScrollMode
+{
+	Marquee,	// Scrolls in from the right and out on the left, one character per tick
+	Bounce,		// Slides from the start of the title to its end and back, pausing at each end
+	PageFlip,	// Shows as many whole words as fit, page by page, each page for a while
+	Ellipsis	// Doesn't move: the start of the title with an ellipsis
+};
+
+// "marquee", "bounce", "page" and "ellipsis", as used by the property inspector. Anything else is Marquee.
+ScrollMode ParseScrollMode(const std::string& inName);
+
+// Every frame of one title in one scroll mode and title font. Frames are slices of a single UTF-8 arena
+// holding the (padded) title, so a tick is an index lookup and nothing is transcoded after the title
+// changes. Frames are cut between grapheme clusters and hold as many as fit in kKeyTitleWidth pixels
+// by the font's metrics. A mode holds a view for a while by repeating its frame for as many of the
+// key's ticks as that takes; the keys only send a frame that differs from the one before, so a repeat
+// costs a tick but no message. A title that fits doesn't scroll in any mode: it is a single, unpadded
+// frame. Instances are immutable and shared between all buttons with the same mode, font and dwell.
+class MarqueeFrames
+{
+public:
+	// How long a page or an end of the title is held for
+	static constexpr std::chrono::milliseconds kPageHold{ 1500 };
+	static constexpr std::chrono::milliseconds kBounceHold{ 1000 };
+
+	// Ticks inMode holds a view for on a key that ticks every inPeriod: the whole number closest to its hold, and at
+	// least one. 0 for the modes that don't hold anything.
+	static size_t Dwell(ScrollMode inMode, std::chrono::milliseconds inPeriod);
+
+	// inGraphemes is IndexGraphemes of inTitle. inPeriod is the refresh time of the keys the frames are for.
+	MarqueeFrames(std::string_view inTitle, const std::vector<Grapheme>& inGraphemes, const TitleFont& inFont, ScrollMode inMode, std::chrono::milliseconds inPeriod);
+
+	size_t FrameCount() const { return mFrames.size(); }
+	std::string_view Frame(size_t inIndex) const;
+
+	// There is only one frame, so it only needs to be sent once
+	bool IsStatic() const { return mFrames.size() == 1; }
+
+private:
+	// The clusters of mArena: where each starts in bytes, plus the end, and how wide each is in thousandths of
+	// a pixel
+	struct Clusters
+	{
+		std::vector<size_t> offsets;
+		std::vector<int> widths;
+	};
+
+	void AddFrame(const Clusters& inClusters, size_t inFirst, size_t inEnd, size_t inRepeat = 1);
+
+	void BuildMarquee(const Clusters& inClusters, const TitleFont& inFont);
+	void BuildBounce(const Clusters& inClusters, size_t inDwell);
+	void BuildPages(const Clusters& inClusters, size_t inDwell);
+	void BuildEllipsis(const Clusters& inClusters, const TitleFont& inFont);
+
+	struct Span
+	{
+		size_t begin;
+		size_t end;
+	};
+
+	std::string mArena;
+	std::vector<Span> mFrames; // byte ranges in mArena
+};
+
+// A title and its frame tables, built on demand the first time a mode, font and dwell are asked for. The title is split
+// into grapheme clusters once, when it changes, for all of them.
+class MarqueeFrameCache
+{
+public:
+	// inTitle is UTF-8. Invalid sequences are replaced with U+FFFD.
+	explicit MarqueeFrameCache(std::string inTitle);
+
+	const std::string& Title() const { return mTitle; }
+	std::shared_ptr<const MarqueeFrames> Get(const TitleFont& inFont, ScrollMode inMode, std::chrono::milliseconds inPeriod);
+
+private:
+	std::string mTitle;
+	std::vector<Grapheme> mGraphemes;
+	std::map<std::tuple<ScrollMode, TitleFont, size_t>, std::shared_ptr<const MarqueeFrames>> mTables; // by mode, font and dwell
+	std::mutex mMutex; // protects mTables
+};
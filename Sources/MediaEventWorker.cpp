@@ -0,0 +1,168 @@
+//==============================================================================
+/**
+@file       MediaEventWorker.cpp
+
+@brief      Collects media change notifications and handles them on one dedicated thread
+
+@copyright  (c) 2021, bionyx187
+			This source code is licensed under the MIT-style license found in the LICENSE file.
+
+**/
+//==============================================================================
+
+#include "MediaEventWorker.h"
+#include "Trace.h"
+
+#include <algorithm>
+
+MediaEventWorker::MediaEventWorker(std::chrono::milliseconds inDebounce, RefreshFunction inRefresh, PlaybackFunction inPlayback) :
+	mDebounce(inDebounce),
+	mRefresh(std::move(inRefresh)),
+	mPlayback(std::move(inPlayback))
+{
+	mThread = std::thread([this]() { Run(); });
+}
+
+MediaEventWorker::MediaEventWorker(VirtualClock& inClock, std::chrono::milliseconds inDebounce, RefreshFunction inRefresh, PlaybackFunction inPlayback) :
+	mDebounce(inDebounce),
+	mRefresh(std::move(inRefresh)),
+	mPlayback(std::move(inPlayback)),
+	mVirtualClock(&inClock)
+{
+}
+
+MediaEventWorker::~MediaEventWorker()
+{
+	{
+		std::lock_guard<std::mutex> lock(mWakeMutex);
+		mStop = true;
+	}
+	mWakeup.notify_one();
+	if (mThread.joinable()) {
+		mThread.join();
+	}
+
+	auto node = mHead.exchange(nullptr);
+	while (node != nullptr) {
+		auto next = node->next;
+		delete node;
+		node = next;
+	}
+}
+
+void MediaEventWorker::Push(Event inEvent, const std::wstring& inSessionId)
+{
+	auto node = new Node{ inEvent, inSessionId, Now() };
+
+	// The node goes on the stack and is counted in one step. Otherwise the worker could take a batch that
+	// already holds it, and the late count would mark that batch's work stale with no batch left to redo it.
+	{
+		std::lock_guard<std::mutex> lock(mWakeMutex);
+		node->next = mHead.load(std::memory_order_relaxed);
+		while (!mHead.compare_exchange_weak(node->next, node, std::memory_order_release, std::memory_order_relaxed)) {
+		}
+		if (mGeneration.fetch_add(1, std::memory_order_acq_rel) == mHandled) {
+			mWindowStart = node->time;
+		}
+	}
+	mWakeup.notify_one();
+}
+
+MediaEventWorker::Clock::time_point MediaEventWorker::Now() const
+{
+	return mVirtualClock != nullptr ? mVirtualClock->Now() : Clock::now();
+}
+
+MediaEventWorker::Clock::time_point MediaEventWorker::NextDue()
+{
+	std::lock_guard<std::mutex> lock(mWakeMutex);
+	if (mGeneration.load(std::memory_order_acquire) == mHandled) {
+		return Clock::time_point::max();
+	}
+	return mWindowStart + mDebounce;
+}
+
+void MediaEventWorker::RunUntil(VirtualClock::time_point inTime)
+{
+	for (;;) {
+		Clock::time_point due;
+		Node* head;
+		{
+			std::lock_guard<std::mutex> lock(mWakeMutex);
+			if (mGeneration.load(std::memory_order_acquire) == mHandled || mWindowStart + mDebounce > inTime) {
+				break;
+			}
+			due = mWindowStart + mDebounce;
+			head = TakeBatch();
+		}
+		mVirtualClock->AdvanceTo(due);
+		HandleBatch(head);
+	}
+	mVirtualClock->AdvanceTo(inTime);
+}
+
+void MediaEventWorker::Run()
+{
+	Trace::SetThreadName("media worker");
+	for (;;) {
+		Node* head;
+		{
+			std::unique_lock<std::mutex> lock(mWakeMutex);
+			mWakeup.wait(lock, [&]() { return mStop || mGeneration.load(std::memory_order_acquire) != mHandled; });
+
+			// Let the burst finish before looking at it, unless stopping. The source may be stopped by then.
+			if (mStop || mWakeup.wait_until(lock, mWindowStart + mDebounce, [&]() { return mStop; })) {
+				break;
+			}
+			head = TakeBatch();
+		}
+		HandleBatch(head);
+	}
+}
+
+MediaEventWorker::Node* MediaEventWorker::TakeBatch()
+{
+	mHandled = mGeneration.load(std::memory_order_acquire);
+	return mHead.exchange(nullptr, std::memory_order_acquire);
+}
+
+void MediaEventWorker::HandleBatch(Node* inHead)
+{
+	// The stack is newest first; turn it around so the batch is in arrival order.
+	std::vector<Node*> batch;
+	for (auto node = inHead; node != nullptr; node = node->next) {
+		batch.push_back(node);
+	}
+	std::reverse(batch.begin(), batch.end());
+
+	Handle(batch);
+	for (auto node : batch) {
+		delete node;
+	}
+}
+
+void MediaEventWorker::Handle(std::vector<Node*>& batch)
+{
+	if (batch.empty()) {
+		return;
+	}
+	auto eventTime = batch.front()->time;
+
+	// Anything other than playback changes needs the full refresh, which covers playback too.
+	bool refresh = std::any_of(batch.begin(), batch.end(), [](const Node* node) { return node->event != Event::PlaybackChanged; });
+	if (refresh) {
+		mRefresh(eventTime);
+		return;
+	}
+
+	// Otherwise only the last playback change of each session matters.
+	std::vector<std::wstring> sessions;
+	for (auto node = batch.rbegin(); node != batch.rend(); ++node) {
+		if (std::find(sessions.begin(), sessions.end(), (*node)->sessionId) == sessions.end()) {
+			sessions.push_back((*node)->sessionId);
+		}
+	}
+	for (auto session = sessions.rbegin(); session != sessions.rend(); ++session) {
+		mPlayback(*session, eventTime);
+	}
+}
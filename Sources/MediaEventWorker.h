@@ -0,0 +1,99 @@
+//==============================================================================
+/**
+@file       MediaEventWorker.h
+
+@brief      Collects media change notifications and handles them on one dedicated thread
+
+@copyright  (c) 2021, bionyx187
+			This source code is licensed under the MIT-style license found in the LICENSE file.
+
+**/
+//==============================================================================
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "VirtualClock.h"
+
+// Notifications are pushed from whatever thread the media API calls back on, onto a lock-free
+// stack. Pushing only takes a lock for as long as it takes to push and count the event and wake
+// the worker, and never waits on the worker's work. The worker wakes on the first one, waits out the debounce window so
+// bursts (a title change arrives as two MediaPropertiesChanged events, seeking in a browser
+// sends dozens) land in the same batch, and then handles the whole batch with at most one
+// full refresh.
+class MediaEventWorker
+{
+public:
+	enum class Event
+	{
+		SessionsChanged,
+		PropertiesChanged,
+		PlaybackChanged
+	};
+
+	using Clock = std::chrono::steady_clock;
+
+	// Full refresh, for anything but pure playback changes. eventTime is when the oldest event of the
+	// batch was pushed, so the time until the result reaches the keys can be measured from it.
+	using RefreshFunction = std::function<void(Clock::time_point eventTime)>;
+	// Playback of one session changed; receives its session id
+	using PlaybackFunction = std::function<void(const std::wstring& sessionId, Clock::time_point eventTime)>;
+
+	MediaEventWorker(std::chrono::milliseconds inDebounce, RefreshFunction inRefresh, PlaybackFunction inPlayback);
+
+	// Runs on virtual time instead. No thread is started; RunUntil handles the batches whose debounce
+	// window closed by then on the calling thread.
+	MediaEventWorker(VirtualClock& inClock, std::chrono::milliseconds inDebounce, RefreshFunction inRefresh, PlaybackFunction inPlayback);
+	~MediaEventWorker();
+
+	void Push(Event inEvent, const std::wstring& inSessionId = std::wstring());
+
+	// Only for the virtual clock: when the pending batch is due, or time_point::max() if nothing is pending
+	Clock::time_point NextDue();
+
+	// Only for the virtual clock: handle every batch due up to and including inTime.
+	void RunUntil(VirtualClock::time_point inTime);
+
+	// Number of events pushed so far. Work that started at generation g is stale once this moved past g,
+	// since a newer batch is coming that will redo it.
+	unsigned long long Generation() const { return mGeneration.load(std::memory_order_acquire); }
+	bool IsStale(unsigned long long inGeneration) const { return Generation() != inGeneration; }
+
+private:
+	struct Node
+	{
+		Event event;
+		std::wstring sessionId;
+		Clock::time_point time;
+		Node* next = nullptr;
+	};
+
+	Clock::time_point Now() const;
+	void Run();
+	// Called with mWakeMutex held: marks everything pushed so far handled and takes it off the stack
+	Node* TakeBatch();
+	void HandleBatch(Node* inHead);
+	void Handle(std::vector<Node*>& batch);
+
+	std::chrono::milliseconds mDebounce;
+	RefreshFunction mRefresh;
+	PlaybackFunction mPlayback;
+
+	std::atomic<Node*> mHead{ nullptr };
+	std::atomic<unsigned long long> mGeneration{ 0 };
+	unsigned long long mHandled = 0; // the generation the last batch was taken at
+	Clock::time_point mWindowStart; // when the first event after it was pushed
+	bool mStop = false;
+	std::mutex mWakeMutex; // protects mHandled, mWindowStart, mStop, and keeps pushes and their mGeneration count together
+	VirtualClock* mVirtualClock = nullptr;
+	std::condition_variable mWakeup;
+	std::thread mThread;
+};
@@ -0,0 +1,92 @@
+//==============================================================================
+/**
+@file       MediaSource.h
+
+@brief      Platform media sessions behind one asynchronous interface
+
+@copyright  (c) 2021, bionyx187
+			This source code is licensed under the MIT-style license found in the LICENSE file.
+
+**/
+//==============================================================================
+
+#pragma once
+
+#include "MediaState.h"
+
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// Thrown by the getters when the platform media API fails. The message is already UTF-8.
+class MediaSourceError : public std::runtime_error
+{
+public:
+	explicit MediaSourceError(const std::string& inMessage) : std::runtime_error(inMessage) { }
+};
+
+// Artwork as the player published it. Reading it is deferred, since most of the time the
+// artwork turns out to be the same as the last one.
+class MediaArtwork
+{
+public:
+	virtual ~MediaArtwork() { }
+
+	// True if inOther refers to the same published artwork, so it needs no reading at all
+	virtual bool IsSame(const MediaArtwork& inOther) const = 0;
+
+	// The raw image bytes, usually PNG or JPEG
+	virtual bool Read(std::string& outBytes) = 0;
+
+	// Decode inBytes, scale to inSize x inSize and encode the result as PNG
+	virtual bool RenderPng(const std::string& inBytes, int inSize, std::string& outPng) = 0;
+};
+
+struct MediaSessionInfo
+{
+	std::wstring id;
+	MediaPlaybackStatus status = MediaPlaybackStatus::Closed;
+};
+
+struct MediaProperties
+{
+	std::string title; // UTF-8, which is what the keys are sent
+	std::wstring artist;
+	std::shared_ptr<MediaArtwork> artwork; // nullptr when there is none
+};
+
+// One backend per platform. Events are delivered on whatever thread the platform calls back on
+// and only say what changed; the getters are then used to find out the details. Getters may be
+// called from any thread.
+class MediaSource
+{
+public:
+	enum class Event
+	{
+		SessionAdded,
+		SessionRemoved,
+		PropertiesChanged,
+		PlaybackChanged
+	};
+
+	using EventFunction = std::function<void(Event event, const std::wstring& sessionId)>;
+
+	virtual ~MediaSource() { }
+
+	// Subscribe to the platform. No events are delivered after Stop returns.
+	virtual void Start(EventFunction inEventFunction) = 0;
+	virtual void Stop() = 0;
+
+	// The session the platform considers current, or an empty id if there is none
+	virtual std::wstring GetCurrentSessionId() = 0;
+	virtual std::vector<MediaSessionInfo> GetSessions() = 0;
+
+	// Return false if the session went away
+	virtual bool GetPlaybackStatus(const std::wstring& inSessionId, MediaPlaybackStatus& outStatus) = 0;
+	virtual bool GetProperties(const std::wstring& inSessionId, MediaProperties& outProperties) = 0;
+};
+
+// Implemented once per platform: SMTC on Windows, MPRIS over D-Bus on Linux.
+std::unique_ptr<MediaSource> CreateMediaSource();
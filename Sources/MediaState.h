@@ -0,0 +1,89 @@
+//==============================================================================
+/**
+@file       MediaState.h
+
+@brief      Immutable snapshot of the media shown on the buttons
+
+@copyright  (c) 2021, bionyx187
+			This source code is licensed under the MIT-style license found in the LICENSE file.
+
+**/
+//==============================================================================
+
+#pragma once
+
+#include "ArtworkCache.h"
+#include "MarqueeFrames.h"
+
+#include <chrono>
+#include <memory>
+#include <string>
+
+// Mirrors GlobalSystemMediaTransportControlsSessionPlaybackStatus
+enum class MediaPlaybackStatus
+{
+	Closed = 0,
+	Opened = 1,
+	Changing = 2,
+	Stopped = 3,
+	Playing = 4,
+	Paused = 5
+};
+
+// A published state is never modified. Writers build a new one with a higher generation and
+// swap it in with std::atomic_store; buttons pick it up with std::atomic_load and compare the
+// generation against the one they last drew. Unchanged parts are shared with the previous
+// state instead of copied.
+struct MediaState
+{
+	// Starts at 1; 0 is what the tick scheduler hands out for buttons that haven't drawn anything yet.
+	unsigned long long generation = 1;
+
+	// The generation in which the visible title (text or playing/not playing) and the artwork last
+	// changed. A button that last drew generation g only redoes the parts newer than g.
+	unsigned long long titleGeneration = 1;
+	unsigned long long imageGeneration = 1;
+
+	// When titleGeneration and imageGeneration were published, to measure how long they take to reach each key
+	std::chrono::steady_clock::time_point titlePublished;
+	std::chrono::steady_clock::time_point imagePublished;
+
+	std::wstring sessionId;
+	MediaPlaybackStatus status = MediaPlaybackStatus::Closed;
+	std::wstring artist;
+
+	// The key background, with an empty data URI when there is no artwork
+	std::shared_ptr<const KeyImage> image = std::make_shared<const KeyImage>();
+
+	// The title and its scroll frames. The title is kept while paused but only shown while playing.
+	std::shared_ptr<MarqueeFrameCache> frames = std::make_shared<MarqueeFrameCache>(std::string());
+
+	bool IsPlaying() const { return status == MediaPlaybackStatus::Playing; }
+};
+
+// What differs between two media states
+enum MediaChange : unsigned
+{
+	kMediaChange_None = 0,
+	kMediaChange_Title = 1 << 0,
+	kMediaChange_Artist = 1 << 1,
+	kMediaChange_Artwork = 1 << 2,
+	kMediaChange_Playback = 1 << 3,
+	kMediaChange_Session = 1 << 4
+};
+
+inline unsigned DiffMediaState(const MediaState& inPrevious, const MediaState& inNext)
+{
+	unsigned changes = kMediaChange_None;
+	if (inPrevious.sessionId != inNext.sessionId)
+		changes |= kMediaChange_Session;
+	if (inPrevious.frames != inNext.frames && inPrevious.frames->Title() != inNext.frames->Title())
+		changes |= kMediaChange_Title;
+	if (inPrevious.artist != inNext.artist)
+		changes |= kMediaChange_Artist;
+	if (inPrevious.image != inNext.image && inPrevious.image->dataUri != inNext.image->dataUri)
+		changes |= kMediaChange_Artwork;
+	if (inPrevious.status != inNext.status)
+		changes |= kMediaChange_Playback;
+	return changes;
+}
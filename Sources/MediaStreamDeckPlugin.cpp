@@ -16,425 +16,556 @@
 
 #include "Common/ESDConnectionManager.h"
 #include "Common/EPLJSONUtils.h"
-
-#include <winrt/Windows.Storage.Streams.h>
-#include <winrt/Windows.Graphics.Imaging.h>
-#include <winrt/Windows.Security.Cryptography.h>
-
-using namespace winrt;
-using namespace Windows::Graphics::Imaging;
-using namespace Windows::Media::Control;
-using namespace Windows::Security::Cryptography;
-using namespace Windows::Storage::Streams;
-
-class ButtonHandler
+#include "Common/ESDUtilities.h"
+#include "Logger.h"
+#include "Metrics.h"
+#include "Trace.h"
+#include "UTFTranscode.h"
+
+// Latency budgets, checked when the latency histograms are logged. A title change has to be on the keys within
+// the debounce, the artwork and one refresh period of the slowest setting we expect.
+static constexpr std::chrono::milliseconds kEventToPublishBudget{ 250 };
+static constexpr std::chrono::milliseconds kArtworkBudget{ 150 };
+static constexpr std::chrono::milliseconds kFrameBuildBudget{ 2 };
+static constexpr std::chrono::milliseconds kPublishToKeyBudget{ 500 };
+static constexpr std::chrono::milliseconds kSendBudget{ 50 };
+
+// This isn't caught by an exception handler because if creating the media source fails, the plugin
+// is not going to work, so might as well just crash then and there.
+MediaStreamDeckPlugin::MediaStreamDeckPlugin() : MediaStreamDeckPlugin(CreateMediaSource())
 {
-public:
-    ButtonHandler() :_execute(false), textWidth(0), currentTick(0), doRefresh(false) { }
-
-    ~ButtonHandler()
-    {
-        if( _execute.load(std::memory_order_acquire) )
-        {
-            stop();
-        };
-    }
-
-    void stop()
-    {
-        _execute.store(false, std::memory_order_release);
-        if(_thd.joinable())
-            _thd.join();
-    }
-
-	void set_refresh(bool refresh) {
-		std::lock_guard<std::mutex> lock(mutex);
-		doRefresh = refresh;
-	}
-
-	void set_text_width(int newWidth) {
-		std::lock_guard<std::mutex> lock(mutex);
-		textWidth = newWidth;
-	}
-
-	bool refresh() {
-		std::lock_guard<std::mutex> lock(mutex);
-		return doRefresh;
-	}
-
-	int text_width() {
-		std::lock_guard<std::mutex> lock(mutex);
-		return textWidth;
-	}
-
-    void start(int interval, std::function<int(int)> func)
-    {
-        if(_execute.load(std::memory_order_acquire))
-        {
-            stop();
-        };
-        _execute.store(true, std::memory_order_release);
-        _thd = std::thread([this, interval, func]()
-        {
-            while (_execute.load(std::memory_order_acquire))
-            {
-				// Refresh requires we reset the animation or we'll
-				// draw new text into an existing scroll.
-				if (refresh()) {
-					currentTick = 0;
-				}
-                currentTick = func(currentTick);
+}
 
-				// If we actually drew something, mark the refresh as done,
-				// otherwise it stays set until a draw happens.
-				if (currentTick > 0) {
-					set_refresh(false);
-				}
+// The plugin folder, or when not running from one, a folder of the user's own rather than wherever it was started from
+static std::string DefaultDataPath()
+{
+	auto path = ESDUtilities::GetPluginPath();
+	return !path.empty() ? path : ESDUtilities::GetUserDataPath("com.bionyx187.media");
+}
 
-				std::this_thread::sleep_for(std::chrono::milliseconds(interval));
-            }
-        });
-    }
+MediaStreamDeckPlugin::MediaStreamDeckPlugin(std::unique_ptr<MediaSource> inMediaSource) : MediaStreamDeckPlugin(std::move(inMediaSource), nullptr, DefaultDataPath())
+{
+}
 
-    bool is_running() const noexcept
-    {
-        return (_execute.load(std::memory_order_acquire) && _thd.joinable());
-    }
+MediaStreamDeckPlugin::MediaStreamDeckPlugin(std::unique_ptr<MediaSource> inMediaSource, VirtualClock& inClock, const std::string& inDataPath) :
+	MediaStreamDeckPlugin(std::move(inMediaSource), &inClock, inDataPath)
+{
+}
 
+MediaStreamDeckPlugin::MediaStreamDeckPlugin(std::unique_ptr<MediaSource> inMediaSource, VirtualClock* inClock, const std::string& inDataPath) :
+	mVirtualClock(inClock),
+	mDataPath(inDataPath),
+	mArtworkDiskCache(mDataPath, kArtworkDiskCacheBudget),
+	mMediaSource(std::move(inMediaSource))
+{
+	if (!mDataPath.empty()) {
+		Logger::Start(ESDUtilities::AddPathComponent(mDataPath, "media.log"));
+	}
 
-private:
-    std::atomic<bool> _execute;
-	int textWidth;
-	int currentTick;
-	bool doRefresh;
+	// Media events are only queued by the media source callbacks and handled on the worker thread. The worker exists
+	// before the source starts, since a source can call back from Start itself, and it is never reassigned, so the
+	// callback threads read it without a lock.
+	auto refresh = [this](std::chrono::steady_clock::time_point eventTime) { CheckMedia(eventTime); };
+	auto playback = [this](const std::wstring& sessionId, std::chrono::steady_clock::time_point eventTime) { CheckPlayback(sessionId, eventTime); };
+	if (mVirtualClock != nullptr) {
+		mMediaWorker = std::make_unique<MediaEventWorker>(*mVirtualClock, kMediaEventDebounce, refresh, playback);
+	}
+	else {
+		mMediaWorker = std::make_unique<MediaEventWorker>(kMediaEventDebounce, refresh, playback);
+	}
+	mMediaSource->Start([this](MediaSource::Event event, const std::wstring& sessionId) { MediaSourceHandler(event, sessionId); });
 
-    std::thread _thd;
-	std::mutex mutex;
-};
+	// Perform initial setup through the worker too, so it never runs alongside a refresh an early event started.
+	mMediaWorker->Push(MediaEventWorker::Event::SessionsChanged);
+}
 
-MediaStreamDeckPlugin::MediaStreamDeckPlugin()
+MediaStreamDeckPlugin::~MediaStreamDeckPlugin()
 {
-	// This isn't caught by an exception handler because if this fails, the plugin is not going
-	// to work, so might as well just crash then and there.
-	mMgr = GlobalSystemMediaTransportControlsSessionManager::RequestAsync().get();
-
-	mMgr.SessionsChanged([this](GlobalSystemMediaTransportControlsSessionManager const& sender, SessionsChangedEventArgs const& args) {
-		if (this != nullptr) {
-			LogEvent("Sessions Changed detected");
-			// If the sessions have changed, just cancel all our existing handlers and register new ones. This is infrequent
-			// and simplifies keeping everything in sync.
-
-			auto sessions = sender.GetSessions();
-			for (const auto& session : sessions) {
-				std::string key = UTF8Encode(session.SourceAppUserModelId().c_str());
-				auto session_handler = mSessionHandlers.find(key);
-				if (session_handler != mSessionHandlers.end()) {
-					auto handlers = std::move(session_handler->second);
-					auto [media_revoker, properties_revoker] = std::move(handlers);
-					media_revoker.revoke();
-					properties_revoker.revoke();
-					mSessionHandlers.erase(session_handler);
-				}
+	// The endpoint renders from plugin state on its own thread.
+	mMetricsServer.reset();
 
-				LogEvent("Added handler for " + key);
-				auto media_revoker = session.MediaPropertiesChanged(winrt::auto_revoke, { this, &MediaStreamDeckPlugin::MediaChangedHandler });
-				auto properties_revoker = session.PlaybackInfoChanged(winrt::auto_revoke, { this, &MediaStreamDeckPlugin::PlaybackChangedHandler });
-				auto handlers = std::make_tuple(std::move(media_revoker), std::move(properties_revoker));
-				mSessionHandlers.emplace(key, std::move(handlers));
-			}
-		}
-	});
+	// Stop handling media events before anything they use goes away.
+	mMediaSource->Stop();
+	mMediaWorker.reset();
 
-	// Perform initial setup. If there's no active session now, our first hooks will be registered by the event handler
-	// above.
-	auto currentSession = mMgr.GetCurrentSession();
-	if (currentSession != nullptr) {
-		currentSession.MediaPropertiesChanged({ this, &MediaStreamDeckPlugin::MediaChangedHandler });
-		currentSession.PlaybackInfoChanged({ this, &MediaStreamDeckPlugin::PlaybackChangedHandler });
+	// A trace that was never saved is saved on the way out, so a session that ended with the problem isn't lost.
+	if (Trace::IsEnabled()) {
+		Trace::Stop();
+		Trace::Write(GetTracePath());
 	}
-	// If there's no session, we can't log that fact since we don't have a logger yet.
+	Logger::Stop();
+}
 
-	CheckMedia();
+std::chrono::steady_clock::time_point MediaStreamDeckPlugin::Now() const
+{
+	return mVirtualClock != nullptr ? mVirtualClock->Now() : std::chrono::steady_clock::now();
 }
 
-MediaStreamDeckPlugin::~MediaStreamDeckPlugin()
+void MediaStreamDeckPlugin::RunUntil(VirtualClock::time_point inTime)
 {
-	for (const auto& [_, value] : mContextHandlers) {
-		if (value != nullptr) {
-			delete value;
+	// The scheduler is created with the first key. It ticks on this thread, so the lock isn't held while it does.
+	auto tickUntil = [this](VirtualClock::time_point time) {
+		TickScheduler* scheduler = nullptr;
+		{
+			std::lock_guard<std::mutex> lock(mSchedulerMutex);
+			scheduler = mScheduler.get();
+		}
+		if (scheduler != nullptr) {
+			scheduler->RunUntil(time);
+		}
+	};
+
+	// A handled batch wakes the keys, so the keys are ticked up to each batch before it is handled, and once more
+	// afterwards for the keys it woke.
+	for (;;) {
+		auto due = std::min(mMediaWorker->NextDue(), inTime);
+		tickUntil(due);
+		mMediaWorker->RunUntil(due);
+		tickUntil(due);
+		if (due == inTime && mMediaWorker->NextDue() > inTime) {
+			break;
 		}
 	}
 }
 
-// Convert a wide Unicode string to an UTF8 string
-std::string MediaStreamDeckPlugin::UTF8Encode(const std::wstring& wstr)
+size_t MediaStreamDeckPlugin::ParkedKeyCount()
 {
-	if (wstr.empty()) return std::string();
-	int size_needed = WideCharToMultiByte(CP_UTF8, 0, &wstr[0], (int)wstr.size(), NULL, 0, NULL, NULL);
-	std::string strTo(size_needed, 0);
-	WideCharToMultiByte(CP_UTF8, 0, &wstr[0], (int)wstr.size(), &strTo[0], size_needed, NULL, NULL);
-	return strTo;
+	std::lock_guard<std::mutex> lock(mSchedulerMutex);
+	return mScheduler != nullptr ? mScheduler->ParkedCount() : 0;
 }
 
-
-void MediaStreamDeckPlugin::MediaChangedHandler(GlobalSystemMediaTransportControlsSession const& sender, MediaPropertiesChangedEventArgs const& args)
+void MediaStreamDeckPlugin::MediaSourceHandler(MediaSource::Event event, const std::wstring& sessionId)
 {
-	// Since this are running in separate threads, it's possible the plugin could be destructed before they execute, so it must
-	// verify 'this' is valid.
-	if (this != nullptr) {
-		CheckMedia();
+	// This runs on whatever thread the media source calls back on, so it only queues the event for the worker.
+	switch (event) {
+	case MediaSource::Event::SessionAdded:
+	case MediaSource::Event::SessionRemoved:
+		LOG(Media, Debug, "Sessions Changed detected for " + ToUTF8(sessionId));
+		mMediaWorker->Push(MediaEventWorker::Event::SessionsChanged);
+		break;
+	case MediaSource::Event::PropertiesChanged:
+		mMediaWorker->Push(MediaEventWorker::Event::PropertiesChanged, sessionId);
+		break;
+	case MediaSource::Event::PlaybackChanged:
+		mMediaWorker->Push(MediaEventWorker::Event::PlaybackChanged, sessionId);
+		break;
 	}
 }
 
-void MediaStreamDeckPlugin::PlaybackChangedHandler(GlobalSystemMediaTransportControlsSession const& sender, PlaybackInfoChangedEventArgs const& args)
+int MediaStreamDeckPlugin::HandleButton(int tick, const std::string& context, unsigned long long& generation, const TitleFont& font, ScrollMode mode, std::chrono::milliseconds period)
 {
-	// Since this are running in separate threads, it's possible the plugin could be destructed before they execute, so it must
-	// verify 'this' is valid.
-	if (this != nullptr) {
-		CheckMedia();
+	//
+	// This is running on the websocket io thread, driven by the tick scheduler. The button is initialized in multiple steps.
+	// The test below is verifying that all the invariants are established.
+	//
+	TRACE_SCOPE("scheduler", "HandleButton");
+	if(mConnectionManager != nullptr && font.IsKnown())
+	{
+		// One atomic load gets the whole media state. Nothing below holds a lock while sending.
+		auto state = std::atomic_load(&mMediaState);
+
+		// Only redo what changed since the generation this button last drew. A new title requires we reset the
+		// animation or we'll draw new text into an existing scroll. Buttons that are drawing for the first time
+		// (generation 0) show whatever is there, which says nothing about media latency, so they aren't measured.
+		bool newTitle = false;
+		bool titleDirty = false;
+		if (state->generation != generation) {
+			if (state->imageGeneration > generation) {
+				mConnectionManager->SetImage(state->image->dataUri, context, kESDSDKTarget_HardwareAndSoftware);
+				if (generation != 0) {
+					mPublishToImageLatency.Record(Now() - state->imagePublished);
+				}
+			}
+			if (state->titleGeneration > generation) {
+				tick = 0;
+				titleDirty = true;
+				newTitle = generation != 0;
+			}
+			generation = state->generation;
+		}
+
+		// Only draw the title if media is actually playing. The frames for this mode, font and period are built by the
+		// first button that needs them and shared by every other button that would hold its frames as long.
+		std::string_view text;
+		std::shared_ptr<const MarqueeFrames> frames;
+		if (state->IsPlaying()) {
+			auto start = newTitle ? Now() : std::chrono::steady_clock::time_point();
+			frames = state->frames->Get(font, mode, period);
+			if (newTitle) {
+				mFrameBuildLatency.Record(Now() - start);
+			}
+		}
+		std::string_view previous;
+		if (frames != nullptr && frames->FrameCount() > 0) {
+			if (tick >= static_cast<int>(frames->FrameCount())) {
+				tick = 0;
+			}
+			text = frames->Frame(tick);
+			previous = frames->Frame(tick > 0 ? tick - 1 : frames->FrameCount() - 1);
+		}
+
+		// Apply the scrolling version of the title text. Unless the title just changed, the key already shows the
+		// previous frame, so a frame that is the same (the blank ends of the marquee, a page or end being held, or
+		// no title at all) isn't sent.
+		if (titleDirty || text != previous) {
+			mConnectionManager->SetTitle(text, context, kESDSDKTarget_HardwareAndSoftware);
+			if (newTitle) {
+				mPublishToTitleLatency.Record(Now() - state->titlePublished);
+			}
+		}
+
+		// With nothing playing, no title, or a title that fits, there is nothing more to show until the media state or the
+		// title font changes. Both wake the key, so it parks instead of waiting on the timer, and an idle plugin doesn't
+		// wake up at all.
+		if (frames == nullptr || frames->FrameCount() == 0 || frames->IsStatic()) {
+			return TickScheduler::kParked;
+		}
+		return ++tick;
 	}
+
+	// The title font arrives with titleParametersDidChange, which wakes the key.
+	return TickScheduler::kParked;
 }
 
-int MediaStreamDeckPlugin::HandleButton(int tick, const std::string& context, bool refresh, int textWidth)
+void MediaStreamDeckPlugin::PublishMediaState(std::shared_ptr<MediaState> state, std::chrono::steady_clock::time_point eventTime)
 {
-	//
-	// This is running in an independent thread. The object calling this is initialized in multiple steps.
-	// The test below is verifying that all the invariants are established.
-	//
-	if(mConnectionManager != nullptr && textWidth != 0)
+	// Callers hold mMediaStateWriteMutex, so generations are published in order.
+	auto previous = std::atomic_load(&mMediaState);
+	auto changes = DiffMediaState(*previous, *state);
+	if (changes == kMediaChange_None) {
+		return;
+	}
+
+	// Share what didn't change so buttons and frame tables built for it stay valid.
+	if (!(changes & kMediaChange_Title)) {
+		state->frames = previous->frames;
+	}
+	if (!(changes & kMediaChange_Artwork)) {
+		state->image = previous->image;
+	}
+
+	state->generation = previous->generation + 1;
+	bool titleChanged = (changes & kMediaChange_Title) || previous->IsPlaying() != state->IsPlaying();
+	state->titleGeneration = titleChanged ? state->generation : previous->titleGeneration;
+	state->imageGeneration = (changes & kMediaChange_Artwork) ? state->generation : previous->imageGeneration;
+
+	auto now = Now();
+	state->titlePublished = titleChanged ? now : previous->titlePublished;
+	state->imagePublished = (changes & kMediaChange_Artwork) ? now : previous->imagePublished;
+	auto generation = state->generation;
+	bool playing = state->IsPlaying();
+	std::atomic_store(&mMediaState, std::shared_ptr<const MediaState>(std::move(state)));
+	if (playing != previous->IsPlaying()) {
+		LOG(Media, Info, playing ? "Playback started, keys scroll again" : "Nothing playing, keys park after clearing their titles");
+	}
+
+	// Keys that have nothing to scroll, which is all of them while nothing plays, are parked. They pick up the new
+	// state like the others once woken.
 	{
-		std::string text;
-		std::wstring wtitle;
+		std::lock_guard<std::mutex> lock(mSchedulerMutex);
+		if (mScheduler != nullptr) {
+			mScheduler->WakeAll();
+		}
+	}
+
+	// The state published at startup doesn't come from an event.
+	if (eventTime != std::chrono::steady_clock::time_point()) {
+		auto latency = now - eventTime;
+		mEventToPublishLatency.Record(latency);
+		LOG(Media, Debug, "Published generation " + std::to_string(generation) + " " +
+			std::to_string(std::chrono::duration_cast<std::chrono::microseconds>(latency).count()) + "us after the media event");
+	}
+}
 
-		// Read the global media data
+// Fast path for play/pause of the session on the buttons. Only the playback status changes, so there is no need
+// to look at media properties or artwork. Anything that might switch to another session goes through CheckMedia.
+void MediaStreamDeckPlugin::CheckPlayback(const std::wstring& sessionId, std::chrono::steady_clock::time_point eventTime)
+{
+	TRACE_SCOPE("media", "CheckPlayback");
+	try {
 		{
-			std::lock_guard<std::mutex> lock(mButtonDataMutex);
-			if (refresh) {
-				mConnectionManager->SetImage(mImage, context, kESDSDKTarget_HardwareAndSoftware);
+			std::lock_guard<std::mutex> lock(mMediaStateWriteMutex);
+			auto previous = std::atomic_load(&mMediaState);
+
+			// The session went away since the event was queued. The sessions change event takes care of that.
+			auto status = MediaPlaybackStatus::Closed;
+			if (!mMediaSource->GetPlaybackStatus(sessionId, status)) {
+				return;
 			}
-			wtitle = mTitle;
-		}
 
-		// Only draw the title if set (i.e. media is actually playing)
-		if (wtitle.length() > 0) {
-			// Pad the string for scrolling.
-			wtitle.insert(0, textWidth, ' ');
-			wtitle.append(textWidth, ' ');
+			bool shownSession = sessionId == previous->sessionId;
+			bool toggle = (status == MediaPlaybackStatus::Playing || status == MediaPlaybackStatus::Paused) &&
+				(previous->status == MediaPlaybackStatus::Playing || previous->status == MediaPlaybackStatus::Paused);
 
+			// A session we aren't showing stopped playing: nothing on the buttons changes.
+			if (!shownSession && status != MediaPlaybackStatus::Playing) {
+				return;
+			}
 
-			if (tick > (wtitle.length() - textWidth)) {
-				tick = 0;
+			// Pausing the shown session only stays on it if nothing else is playing.
+			if (shownSession && toggle && status == MediaPlaybackStatus::Paused) {
+				for (const auto& other : mMediaSource->GetSessions()) {
+					if (other.status == MediaPlaybackStatus::Playing) {
+						toggle = false;
+						break;
+					}
+				}
 			}
 
-			auto substring = wtitle.substr(tick, textWidth);
-			text = UTF8Encode(substring);
+			if (shownSession && toggle) {
+				auto state = std::make_shared<MediaState>(*previous);
+				state->status = status;
+				PublishMediaState(std::move(state), eventTime);
+				return;
+			}
 		}
 
-		// Apply the scrolling version of the title text
-		mConnectionManager->SetTitle(text, context, kESDSDKTarget_HardwareAndSoftware);
-		return ++tick;
+		CheckMedia(eventTime);
+	}
+	catch (const MediaSourceError& e) {
+		LOG(Media, Error, "Media source exception " + std::string(e.what()));
+	}
+
+	catch (...) {
+		LOG(Media, Error, "CheckPlayback recovered from exception");
 	}
-	return 0;
 }
 
+// Work started at generation is stale once the media worker has received newer events, since it will run again.
+bool MediaStreamDeckPlugin::IsMediaWorkStale(unsigned long long generation)
+{
+	return mMediaWorker != nullptr && mMediaWorker->IsStale(generation);
+}
+
+// Turn the session artwork into the key image: scaled to 72x72, PNG-encoded and base64-encoded into a data URI.
+// Artwork seen before comes straight from the artwork cache. Returns false without an image if newer media
+// events arrived in the meantime. A render that finished is cached either way, so the run that replaces this one
+// finds it instead of decoding again.
+bool MediaStreamDeckPlugin::FetchArtwork(MediaArtwork& artwork, unsigned long long generation, std::shared_ptr<const KeyImage>& image)
+{
+	TRACE_SCOPE("artwork", "FetchArtwork");
+	auto start = Now();
+	std::string bytes;
+	if (!TRACE_CALL("artwork", "read", artwork.Read(bytes))) {
+		image = std::make_shared<const KeyImage>();
+		return true;
+	}
+	if (IsMediaWorkStale(generation)) {
+		return false;
+	}
+
+	// Hash the raw artwork before doing any decoding. Tracks from the same album usually share identical artwork.
+	auto hash = HashArtworkBytes(bytes.data(), bytes.size());
+	if (auto cached = mArtworkCache.Find(hash)) {
+		image = cached;
+		return true;
+	}
+	if (auto cached = mArtworkDiskCache.Find(hash)) {
+		mArtworkCache.Insert(hash, cached);
+		image = cached;
+		return true;
+	}
+	if (IsMediaWorkStale(generation)) {
+		return false;
+	}
+
+	std::string png;
+	if (!artwork.RenderPng(bytes, 72, png)) {
+		image = std::make_shared<const KeyImage>();
+		return true;
+	}
+
+	auto keyImage = MakeKeyImage(std::move(png));
+	mArtworkLatency.Record(Now() - start);
+	LOG(Artwork, Debug, "Fetched background image size: " + std::to_string(keyImage->png.size()) + " encoded length: " + std::to_string(keyImage->dataUri.size()));
+
+	mArtworkCache.Insert(hash, keyImage);
+	mArtworkDiskCache.Insert(hash, *keyImage);
+	if (IsMediaWorkStale(generation)) {
+		return false;
+	}
+	image = std::move(keyImage);
+	return true;
+}
 
-// CheckMedia is called at initial plugin startup to sample the media state
-// and then called in event handlers to sample media changes.
+// CheckMedia is called on the media worker thread, once at startup to sample the media state
+// and then to sample media changes.
 // Nothing in CheckMedia should depend on the plugin infra running. Calling Log and friends
-// is OK, but this shouldn't assume the connection manager is up, since it's being called
+// is OK, but this shouldn't assume the connection manager is up, since the first call is queued
 // at object construction.
-void MediaStreamDeckPlugin::CheckMedia() {
+void MediaStreamDeckPlugin::CheckMedia(std::chrono::steady_clock::time_point eventTime) {
+	TRACE_SCOPE("media", "CheckMedia");
+	ScopedLatency duration(mCheckMediaDuration);
+	Metrics::Add(MetricCounter::CheckMediaCalls);
 	LogSessions();
 
-	std::wstring currentTitle;
-	GlobalSystemMediaTransportControlsSessionMediaProperties properties{ nullptr };
+	auto generation = mMediaWorker != nullptr ? mMediaWorker->Generation() : 0;
 
-	try {
-		// Get the current session. There may not be one at startup or we just happen to catch them switching apps.
-		auto currentSession = mMgr.GetCurrentSession();
-		if (currentSession != nullptr) {
-			properties = currentSession.TryGetMediaPropertiesAsync().get();
+	std::wstring shownSession;
+	auto status = MediaPlaybackStatus::Closed;
 
-			if (properties != nullptr) {
-				auto info = currentSession.GetPlaybackInfo();
-				if (info != nullptr) {
-					auto status = info.PlaybackStatus();
+	try {
+		std::lock_guard<std::mutex> lock(mMediaStateWriteMutex);
 
-					if (status == GlobalSystemMediaTransportControlsSessionPlaybackStatus::Playing) {
-						currentTitle = properties.Title();
-					}
-				}
-			}
+		// Get the current session. There may not be one at startup or we just happen to catch them switching apps.
+		auto currentSession = mMediaSource->GetCurrentSessionId();
+		if (!currentSession.empty() && mMediaSource->GetPlaybackStatus(currentSession, status)) {
+			shownSession = currentSession;
 		}
 
 		// If the current session isn't playing (or doesn't exist), let's see if they have something playing somewhere else. 
 		// This isn't perfect because Chrome will hide multiple playing videos behind a single session and only report
 		// focused tabs, so we may not get anything if that playing tab isn't active.
-		if (currentTitle.empty()) {
-			auto sessions = mMgr.GetSessions();
-
-			for (const auto& session : sessions) {
-				properties = session.TryGetMediaPropertiesAsync().get();
-				if (properties != nullptr) {
-					auto info = session.GetPlaybackInfo();
-					if (info != nullptr) {
-						auto status = info.PlaybackStatus();
-
-						if (status == GlobalSystemMediaTransportControlsSessionPlaybackStatus::Playing) {
-							currentTitle = properties.Title();
-							currentSession = session;
-							break;
-						}
-					}
+		if (status != MediaPlaybackStatus::Playing) {
+			for (const auto& session : mMediaSource->GetSessions()) {
+				if (session.status == MediaPlaybackStatus::Playing) {
+					status = MediaPlaybackStatus::Playing;
+					shownSession = session.id;
+					break;
 				}
 			}
 		}
 
-		std::string currentImage;
-
-		if (!currentTitle.empty()) {
-			// We need to try drawing whenever we have a title. I'm seeing two MediaPropertiesChangedEvents. The first one covers the title and what not,
-			// the second one is the thumbnail. I don't want to have to rely on that always being the case, so I just fetch the thumbnail every time
-			// and it all ends up eventually correct.
-
-			// This should always be the case.
-			if (properties != nullptr) {
-				auto thumbnail = properties.Thumbnail();
-
-				if (thumbnail != nullptr) {
-					// The decoder is auto-configuring so it'll read the input data (which has always been PNG so far)
-					// but it needs to be encoded as a base64-encoded string of PNG data.
-					auto stream = thumbnail.OpenReadAsync().get();
-					auto decoder = BitmapDecoder::CreateAsync(stream).get();
-
-					// Scale the image down to 72x72 for the button by applying the transform here and requesting 72x72 on the encoder.
-					BitmapTransform transform;
-					transform.ScaledHeight(72);
-					transform.ScaledWidth(72);
-					auto pixels = decoder.GetPixelDataAsync(BitmapPixelFormat::Bgra8, BitmapAlphaMode::Straight, transform, ExifOrientationMode::RespectExifOrientation, ColorManagementMode::ColorManageToSRgb).get();
-					InMemoryRandomAccessStream outStream;
-					auto encoder = BitmapEncoder::CreateAsync(BitmapEncoder::PngEncoderId(), outStream).get();
-					auto dpiX = decoder.DpiX();
-					auto dpiY = decoder.DpiY();
-					auto pixelData = pixels.DetachPixelData();
-					encoder.SetPixelData(decoder.BitmapPixelFormat(), BitmapAlphaMode::Ignore, 72, 72, dpiX, dpiY, pixelData);
-					encoder.FlushAsync().get();
-
-					// At this point outStream has the PNG-encoded data. We reset the stream for reading, create a buffer to hold the data
-					// and read into the buffer.
-					outStream.Seek(0);
-					auto size = static_cast<uint32_t>(outStream.Size());
-					auto buffer = Buffer(size);
-					outStream.ReadAsync(buffer, size, InputStreamOptions::None).get();
-
-					// Finally we generate the base64-encoded string, UTF8Encode that to convert from wstring to string and we're done!
-					auto encoded = CryptographicBuffer::EncodeToBase64String(buffer);
-					currentImage = UTF8Encode(encoded.c_str());
-					LogEvent("Fetched background image for " + UTF8Encode(currentTitle) + " size: " + std::to_string(outStream.Size()) + " encoded length: " + std::to_string(currentImage.size()));
+		// A paused current session stays on the buttons, with its title hidden. Anything else not playing clears them.
+		if (status != MediaPlaybackStatus::Playing && status != MediaPlaybackStatus::Paused) {
+			shownSession.clear();
+		}
+
+		auto previous = std::atomic_load(&mMediaState);
+		auto state = std::make_shared<MediaState>();
+		state->status = !shownSession.empty() ? status : MediaPlaybackStatus::Closed;
+
+		MediaProperties properties;
+		if (!shownSession.empty() && mMediaSource->GetProperties(shownSession, properties)) {
+			state->sessionId = shownSession;
+			state->artist = properties.artist;
+			state->frames = previous->frames->Title() == properties.title ? previous->frames : std::make_shared<MarqueeFrameCache>(properties.title);
+
+			// I'm seeing two MediaPropertiesChangedEvents. The first one covers the title and what not, the second one
+			// is the thumbnail, so the artwork can change without anything else changing. It is only decoded again if
+			// the artwork is a new one or the media itself changed.
+			bool sameMedia = state->sessionId == previous->sessionId && state->frames == previous->frames && state->artist == previous->artist;
+			if (properties.artwork == nullptr) {
+				mLastArtwork = nullptr;
+			}
+			else if (sameMedia && mLastArtwork != nullptr && properties.artwork->IsSame(*mLastArtwork)) {
+				state->image = previous->image;
+			}
+			else {
+				// If newer events arrived while decoding, the worker is about to run CheckMedia again and pick the
+				// artwork up from the cache, so only the image is dropped. The title and status are still published,
+				// or a steady stream of events would keep anything from reaching the keys.
+				std::shared_ptr<const KeyImage> image;
+				if (FetchArtwork(*properties.artwork, generation, image)) {
+					state->image = std::move(image);
+					mLastArtwork = std::move(properties.artwork);
+				}
+				else {
+					LOG(Artwork, Debug, "Dropped stale artwork");
+					if (sameMedia) {
+						state->image = previous->image;
+					}
+					mLastArtwork = nullptr;
 				}
 			}
 		}
-
-		// Update the variables to indicate the current title and thumbnail
-		{
-			std::lock_guard<std::mutex> lock(mButtonDataMutex);
-			mImage = currentImage;
-			mTitle = currentTitle;
+		else {
+			mLastArtwork = nullptr;
 		}
 
-		// Tell all buttons we have new data and go get it!
-		RefreshAllHandlers();
-
+		// Publish the new state. Buttons notice the new generation on their next tick and go get what changed!
+		PublishMediaState(std::move(state), eventTime);
 	}
-	catch (winrt::hresult_error e) {
-		LogException("WinRT exception " + UTF8Encode(e.message().c_str()));
+	catch (const MediaSourceError& e) {
+		LOG(Media, Error, "Media source exception " + std::string(e.what()));
 	}
 
 	catch (...) {
-		LogException("CheckMedia recovered from exception");
+		LOG(Media, Error, "CheckMedia recovered from exception");
 	}
 }
 
-void MediaStreamDeckPlugin::RefreshAllHandlers()
+void MediaStreamDeckPlugin::LogSessions()
 {
-	std::lock_guard<std::mutex> lock(mContextHandlersMutex);
-	for (const auto& [context, handler] : mContextHandlers) {
-		handler->set_refresh(true);
+	// This asks the media source for everything, so it isn't even started unless it is going to be logged.
+	if (!LOG_ENABLED(Sessions, Debug)) {
+		return;
 	}
-}
 
-void MediaStreamDeckPlugin::LogSessions()
-{
-#if LOG_SESSIONS
 	try {
-		auto cur = mMgr.GetCurrentSession();
-		if (cur != nullptr) {
-			Log("CurrentSession: " + UTF8Encode(cur.SourceAppUserModelId().c_str()));
+		auto cur = mMediaSource->GetCurrentSessionId();
+		if (!cur.empty()) {
+			LOG(Sessions, Debug, "CurrentSession: " + ToUTF8(cur));
 		}
 		else {
-			Log("No CurrentSession");
+			LOG(Sessions, Debug, "No CurrentSession");
 		}
-		auto sessions = mMgr.GetSessions();
+		auto sessions = mMediaSource->GetSessions();
 
-		if (sessions.Size() == 0) {
-			Log("No Sessions");
+		if (sessions.empty()) {
+			LOG(Sessions, Debug, "No Sessions");
 			return;
 		}
 
 		auto i = 0;
 		for (const auto& session : sessions) {
 			++i;
-			auto properties = session.TryGetMediaPropertiesAsync().get();
+			MediaProperties properties;
 			auto message = "Session #" + std::to_string(i) + " ";
-			if (properties != nullptr) {
-				message += "App: " + UTF8Encode(session.SourceAppUserModelId().c_str()) + " ";
-				auto title = properties.Title();
-				message += winrt::to_string(title);
-				auto info = session.GetPlaybackInfo();
-				if (info != nullptr) {
-					auto status = info.PlaybackStatus();
-					message += " (" + std::to_string(static_cast<int>(status)) + ")";
-				}
+			if (mMediaSource->GetProperties(session.id, properties)) {
+				message += "App: " + ToUTF8(session.id) + " ";
+				message += properties.title;
+				message += " (" + std::to_string(static_cast<int>(session.status)) + ")";
 			}
-			Log(message);
+			LOG(Sessions, Debug, std::move(message));
 		}
 	}
-	catch (winrt::hresult_error e) {
-		Log("WinRT exception " + UTF8Encode(e.message().c_str()));
+	catch (const MediaSourceError& e) {
+		LOG(Sessions, Error, "Media source exception " + std::string(e.what()));
 	}
 
 	catch (...) {
-		Log("LogSessions recovered from exception");
+		LOG(Sessions, Error, "LogSessions recovered from exception");
 	}
-#endif
 }
 
-void MediaStreamDeckPlugin::Log(const std::string& message)
+// Reports how well a button kept up with its refresh time. Callers hold mSchedulerMutex.
+void MediaStreamDeckPlugin::LogTickStats(const std::string& context)
 {
-#if DEBUG
-	if (mConnectionManager != nullptr) {
-		mConnectionManager->LogMessage(message);
+	if (!LOG_ENABLED(Ticks, Debug)) {
+		return;
 	}
-#endif
-}
 
-void MediaStreamDeckPlugin::LogEvent(const std::string& message)
-{
-#if LOG_EVENTS
-	Log(message);
-#endif
+	TickScheduler::TickStats stats;
+	if (mScheduler->GetStats(context, stats) && stats.ticks > 0) {
+		Logger::Write(LogCategory::Ticks, LogLevel::Debug, "Tick stats for " + context + ": ticks: " + std::to_string(stats.ticks) +
+			" missed: " + std::to_string(stats.missedFrames) +
+			" mean late (us): " + std::to_string(stats.totalLateness.count() / static_cast<long long>(stats.ticks)) +
+			" max late (us): " + std::to_string(stats.maxLateness.count()) +
+			" superseded frames (all buttons): " + std::to_string(mConnectionManager->GetSupersededFrameCount()));
+	}
 }
 
-void MediaStreamDeckPlugin::LogException(const std::string& message)
+// Writes the latency of every stage to the log. This is asked for explicitly, so it goes out as Diagnostics,
+// which is on at the Info level unless turned off.
+void MediaStreamDeckPlugin::LogLatency()
 {
-#if LOG_EXCEPTIONS
-	Log(message);
-#endif
+	LOG(Diagnostics, Info, mEventToPublishLatency.Format("Latency event to state published", kEventToPublishBudget));
+	LOG(Diagnostics, Info, mArtworkLatency.Format("Latency artwork decode and encode", kArtworkBudget));
+	LOG(Diagnostics, Info, mFrameBuildLatency.Format("Latency title frame build", kFrameBuildBudget));
+	LOG(Diagnostics, Info, mPublishToTitleLatency.Format("Latency state published to setTitle queued", kPublishToKeyBudget));
+	LOG(Diagnostics, Info, mPublishToImageLatency.Format("Latency state published to setImage queued", kPublishToKeyBudget));
+	if (auto titleSend = mConnectionManager->GetSendLatency(ESDOutboundQueue::Kind::Title)) {
+		LOG(Diagnostics, Info, titleSend->Format("Latency setTitle queued to sent", kSendBudget));
+	}
+	if (auto imageSend = mConnectionManager->GetSendLatency(ESDOutboundQueue::Kind::Image)) {
+		LOG(Diagnostics, Info, imageSend->Format("Latency setImage queued to sent", kSendBudget));
+	}
 }
 
 void MediaStreamDeckPlugin::WillAppearForAction(const std::string& inAction, const std::string& inContext, const json &inPayload, const std::string& inDeviceID)
 {
-	LogEvent("WillAppearForAction: " + inAction + " context: " + inContext + " payload: " + inPayload.dump());
+	LOG(Events, Debug, "WillAppearForAction: " + inAction + " context: " + inContext + " payload: " + inPayload.dump());
 	// Since ReceiveSettings is called when a button is reconfigured, and receives the same payload, just delegate to that function
 	// to configure the button.
 	ReceiveSettings(inAction, inContext, inPayload, inDeviceID);
@@ -442,27 +573,61 @@ void MediaStreamDeckPlugin::WillAppearForAction(const std::string& inAction, con
 
 void MediaStreamDeckPlugin::WillDisappearForAction(const std::string& inAction, const std::string& inContext, const json &inPayload, const std::string& inDeviceID)
 {
-	LogEvent("WillDisappearForAction: " + inAction + " payload: " + inPayload.dump());
-	// Remove the context and its associated timer
-
-	// Since the worker thread acquires the lock to figure out if it's getting removed, we acquire the lock
-	// to remove its entry, then delete the object so it can run to completion and properly terminate.
-	// Holding the lock for too long here results in deadlock.
-	auto target = mContextHandlers.find(inContext);
-	if (target != mContextHandlers.end()) {
-		auto timer = target->second;
-		{
-			std::lock_guard<std::mutex> lock(mContextHandlersMutex);
-			mContextHandlers.erase(inContext);
-		}
+	LOG(Events, Debug, "WillDisappearForAction: " + inAction + " payload: " + inPayload.dump());
+	// Runs on the websocket thread, once per key when a page is switched. Cancel only marks the context, and its
+	// state is freed by the scheduler's next wakeup, so this costs a hash lookup per key.
+	std::lock_guard<std::mutex> lock(mSchedulerMutex);
+	if (mScheduler != nullptr) {
+		LogTickStats(inContext);
+		mScheduler->Cancel(inContext);
+	}
+	mConnectionManager->DiscardPending(inContext);
+}
+
+void MediaStreamDeckPlugin::SendToPlugin(const std::string& inAction, const std::string& inContext, const json& inPayload, const std::string& inDeviceID)
+{
+	LOG(Events, Debug, "SendToPlugin: " + inAction + " context: " + inContext + " payload: " + inPayload.dump());
+	if (EPLJSONUtils::GetBoolByName(inPayload, "dump_latency")) {
+		LogLatency();
+	}
 
-		delete timer;
+	// "log_level" on its own applies to every category but Diagnostics, with "log_category" only to that one.
+	LogLevel level;
+	if (Logger::ParseLevel(EPLJSONUtils::GetStringByName(inPayload, "log_level"), level)) {
+		LogCategory category;
+		auto categoryName = EPLJSONUtils::GetStringByName(inPayload, "log_category");
+		if (categoryName.empty()) {
+			Logger::SetLevel(level);
+		}
+		else if (Logger::ParseCategory(categoryName, category)) {
+			Logger::SetLevel(category, level);
+		}
+	}
+	if (EPLJSONUtils::GetBoolByName(inPayload, "start_trace")) {
+		Trace::Start();
+		LOG(Diagnostics, Info, "Tracing started");
+	}
+	if (EPLJSONUtils::GetBoolByName(inPayload, "save_trace")) {
+		auto path = GetTracePath();
+		Trace::Stop();
+		if (Trace::Write(path)) {
+			LOG(Diagnostics, Info, "Trace saved to " + path);
+		}
+		else {
+			LOG(Diagnostics, Warning, "Could not save the trace to " + path);
+		}
 	}
 }
 
+// In the data folder, where the disk cache is as well. Each save replaces the previous trace.
+std::string MediaStreamDeckPlugin::GetTracePath()
+{
+	return ESDUtilities::AddPathComponent(mDataPath, "trace.json");
+}
+
 void MediaStreamDeckPlugin::ReceiveSettings(const std::string& inAction, const std::string& inContext, const json& inPayload, const std::string& inDeviceID)
 {
-	LogEvent("ReceiveSettings: " + inAction + " context: " + inContext + " payload: " + inPayload.dump());
+	LOG(Events, Debug, "ReceiveSettings: " + inAction + " context: " + inContext + " payload: " + inPayload.dump());
 	json settings;
 	EPLJSONUtils::GetObjectByName(inPayload, "settings", settings);
 	auto refresh_time = EPLJSONUtils::GetIntByName(settings, "refresh_time");
@@ -474,41 +639,97 @@ void MediaStreamDeckPlugin::ReceiveSettings(const std::string& inAction, const s
 	mConnectionManager->SetTitle("", inContext, kESDSDKTarget_HardwareAndSoftware);
 
 	// This resets the display timer for the settings for this view.
-	StartButtonHandler(refresh_time, inContext);
+	auto mode = ParseScrollMode(EPLJSONUtils::GetStringByName(settings, "scroll_mode"));
+	StartButtonHandler(refresh_time, inContext, mode);
+
+	auto metrics_port = EPLJSONUtils::GetIntByName(settings, "metrics_port");
+	if (metrics_port > 0) {
+		StartMetricsServer(metrics_port);
+	}
 }
 
-void MediaStreamDeckPlugin::StartButtonHandler(int period, const std::string& context)
+// Any button can carry the setting. The endpoint then stays up, on the port last set, until the plugin exits.
+void MediaStreamDeckPlugin::StartMetricsServer(int port)
 {
-	std::lock_guard<std::mutex> lock(mContextHandlersMutex);
+	if (mMetricsServer != nullptr && mMetricsServer->Port() == port) {
+		return;
+	}
 
-	// Reuse existing handlers if possible
-	auto handler = mContextHandlers[context];
-	if (handler == nullptr) {
-		handler = new ButtonHandler();
-		mContextHandlers[context] = handler;
+	mMetricsServer.reset();
+	try {
+		mMetricsServer = std::make_unique<MetricsServer>(static_cast<unsigned short>(port), [this]() { return RenderMetrics(); });
+		LOG(Diagnostics, Info, "Metrics at http://127.0.0.1:" + std::to_string(port) + "/metrics");
+	}
+	catch (const std::exception& e) {
+		LOG(Diagnostics, Warning, "Could not serve metrics on port " + std::to_string(port) + ": " + e.what());
 	}
+}
 
-	handler->set_refresh(true);
-	handler->start(period, [this, context, handler](int tick)
+std::string MediaStreamDeckPlugin::RenderMetrics()
+{
+	size_t contexts = 0;
 	{
-		return this->HandleButton(tick, context, handler->refresh(), handler->text_width());
-	});
+		std::lock_guard<std::mutex> lock(mSchedulerMutex);
+		if (mScheduler != nullptr) {
+			contexts = mScheduler->ContextCount();
+		}
+	}
+	auto parked = ParkedKeyCount();
+
+	std::string text;
+	AppendPrometheusGauge(text, "media_plugin_active_contexts", "Buttons being ticked", static_cast<double>(contexts));
+	AppendPrometheusGauge(text, "media_plugin_parked_contexts", "Buttons waiting for a media state change instead of the timer", static_cast<double>(parked));
+	AppendPrometheusCounter(text, "media_plugin_ticks_total", "Button ticks run", Metrics::Value(MetricCounter::Ticks));
+	AppendPrometheusCounter(text, "media_plugin_set_title_calls_total", "SetTitle calls, including ones superseded before sending", Metrics::Value(MetricCounter::TitleCalls));
+	AppendPrometheusCounter(text, "media_plugin_set_image_calls_total", "SetImage calls, including ones superseded before sending", Metrics::Value(MetricCounter::ImageCalls));
+	AppendPrometheusCounter(text, "media_plugin_title_messages_sent_total", "setTitle messages sent", Metrics::Value(MetricCounter::TitleMessagesSent));
+	AppendPrometheusCounter(text, "media_plugin_title_bytes_sent_total", "Bytes of setTitle messages sent", Metrics::Value(MetricCounter::TitleBytesSent));
+	AppendPrometheusCounter(text, "media_plugin_image_messages_sent_total", "setImage messages sent", Metrics::Value(MetricCounter::ImageMessagesSent));
+	AppendPrometheusCounter(text, "media_plugin_image_bytes_sent_total", "Bytes of setImage messages sent", Metrics::Value(MetricCounter::ImageBytesSent));
+	AppendPrometheusCounter(text, "media_plugin_check_media_total", "Full media state refreshes", Metrics::Value(MetricCounter::CheckMediaCalls));
+	AppendPrometheusHistogram(text, "media_plugin_check_media_duration_seconds", "Time spent in a full media state refresh", mCheckMediaDuration);
+	AppendPrometheusHistogram(text, "media_plugin_artwork_processing_seconds", "Artwork read, decoded, scaled and encoded, when not cached", mArtworkLatency);
+	AppendPrometheusGauge(text, "media_plugin_websocket_buffered_bytes", "Bytes waiting in the websocket send buffer at the last flush", static_cast<double>(Metrics::BufferedBytes()));
+	AppendPrometheusGauge(text, "process_resident_memory_bytes", "Resident memory size in bytes", static_cast<double>(ESDUtilities::GetResidentMemory()));
+	return text;
+}
+
+void MediaStreamDeckPlugin::StartButtonHandler(int period, const std::string& context, ScrollMode mode)
+{
+	std::lock_guard<std::mutex> lock(mSchedulerMutex);
+
+	// The scheduler runs on the websocket's io_service, which only exists once the connection manager is running,
+	// so it is created with the first button.
+	if (mScheduler == nullptr) {
+		auto tickFunction = [this](const std::string& context, int tick, unsigned long long& generation, const TitleFont& font, ScrollMode mode, std::chrono::milliseconds period)
+		{
+			return this->HandleButton(tick, context, generation, font, mode, period);
+		};
+		if (mVirtualClock != nullptr) {
+			mScheduler = std::make_unique<TickScheduler>(*mVirtualClock, tickFunction);
+		}
+		else {
+			mScheduler = std::make_unique<TickScheduler>(mConnectionManager->GetIOService(), tickFunction);
+		}
+	}
+
+	mScheduler->Schedule(context, period, mode);
 }
 
 void MediaStreamDeckPlugin::TitleParametersDidChange(const std::string& inAction, const std::string& inContext, const json& inPayload, const std::string& inDeviceID)
 {
-	// We use this event to fish out the title text size and adjust the handler's text width based on it.
-	LogEvent("TitleParametersDidChange: " + inAction + " context: " + inContext + " payload: " + inPayload.dump());
+	// We use this event to fish out the title font, which the handler measures titles with to fit them to the key.
+	LOG(Events, Debug, "TitleParametersDidChange: " + inAction + " context: " + inContext + " payload: " + inPayload.dump());
 	json params;
 	EPLJSONUtils::GetObjectByName(inPayload, "titleParameters", params);
-	auto font_size = EPLJSONUtils::GetIntByName(params, "fontSize");
+	auto font = LookupTitleFont(EPLJSONUtils::GetStringByName(params, "fontFamily"),
+		EPLJSONUtils::GetStringByName(params, "fontStyle"), EPLJSONUtils::GetIntByName(params, "fontSize"));
 
 	// Although this should exist, if the user went through profiles really quickly, we could get the deletion message
 	// before the font response, so we don't want to crash in that case.
-	std::lock_guard<std::mutex> lock(mContextHandlersMutex);
-	auto existing = mContextHandlers.find(inContext);
-	if (existing != mContextHandlers.end()) {
-		existing->second->set_text_width(72 / (font_size / 2));
+	std::lock_guard<std::mutex> lock(mSchedulerMutex);
+	if (mScheduler != nullptr) {
+		mScheduler->SetTitleFont(inContext, font);
 	}
 }
 
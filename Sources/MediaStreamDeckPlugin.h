@@ -12,21 +12,30 @@
 //==============================================================================
 
 #include "Common/ESDBasePlugin.h"
-
+#include "ArtworkDiskCache.h"
+#include "LatencyHistogram.h"
+#include "MediaEventWorker.h"
+#include "MediaSource.h"
+#include "MediaState.h"
+#include "MetricsServer.h"
+#include "TickScheduler.h"
+
+#include <memory>
 #include <mutex>
 #include <set>
 #include <map>
 
-#include <winrt/base.h>
-#include <winrt/Windows.Media.Control.h>
-#include <winrt/Windows.Foundation.Collections.h>
-
-class ButtonHandler;
-
 class MediaStreamDeckPlugin : public ESDBasePlugin
 {
 public:
 	MediaStreamDeckPlugin();
+
+	// Runs on the given media source instead of the platform's, such as a ScriptedMediaSource
+	explicit MediaStreamDeckPlugin(std::unique_ptr<MediaSource> inMediaSource);
+
+	// Runs the media worker and the key ticks on virtual time too, keeping the log and the artwork cache in
+	// inDataPath. Nothing happens by itself; RunUntil handles media events and ticks the keys on the calling thread.
+	MediaStreamDeckPlugin(std::unique_ptr<MediaSource> inMediaSource, VirtualClock& inClock, const std::string& inDataPath);
 	virtual ~MediaStreamDeckPlugin();
 
 	void WillAppearForAction(const std::string& inAction, const std::string& inContext, const json &inPayload, const std::string& inDeviceID);
@@ -38,36 +47,74 @@ public:
 	void DeviceDidDisconnect(const std::string& inDeviceID) {};
 	void KeyDownForAction(const std::string& inAction, const std::string& inContext, const json& inPayload, const std::string& inDeviceID) {};
 	void KeyUpForAction(const std::string& inAction, const std::string& inContext, const json& inPayload, const std::string& inDeviceID) {};
-	void SendToPlugin(const std::string& inAction, const std::string& inContext, const json& inPayload, const std::string& inDeviceID) {};
+	void SendToPlugin(const std::string& inAction, const std::string& inContext, const json& inPayload, const std::string& inDeviceID);
+
+	// Only for the virtual clock: everything due up to and including inTime, in time order.
+	void RunUntil(VirtualClock::time_point inTime);
+
+	// Keys waiting for a media state change instead of the timer
+	size_t ParkedKeyCount();
 
 private:
-	void StartButtonHandler(int period, const std::string& context);
-	int HandleButton(int tick, const std::string& context, bool refresh, int textWidth);
-	void CheckMedia();
+	MediaStreamDeckPlugin(std::unique_ptr<MediaSource> inMediaSource, VirtualClock* inClock, const std::string& inDataPath);
 
-	void RefreshAllHandlers();
+	std::chrono::steady_clock::time_point Now() const;
+	void StartButtonHandler(int period, const std::string& context, ScrollMode mode);
+	int HandleButton(int tick, const std::string& context, unsigned long long& generation, const TitleFont& font, ScrollMode mode, std::chrono::milliseconds period);
+	void CheckMedia(std::chrono::steady_clock::time_point eventTime = {});
+	void CheckPlayback(const std::wstring& sessionId, std::chrono::steady_clock::time_point eventTime);
+	bool FetchArtwork(MediaArtwork& artwork, unsigned long long generation, std::shared_ptr<const KeyImage>& image);
+	bool IsMediaWorkStale(unsigned long long generation);
+
+	void PublishMediaState(std::shared_ptr<MediaState> state, std::chrono::steady_clock::time_point eventTime);
 
 	void LogSessions();
-	void Log(const std::string& message);
-	void LogEvent(const std::string& message);
-	void LogException(const std::string& message);
+	void LogTickStats(const std::string& context);
+	void LogLatency();
+	std::string GetTracePath();
+
+	void StartMetricsServer(int port);
+	std::string RenderMetrics();
+
+	void MediaSourceHandler(MediaSource::Event event, const std::wstring& sessionId);
+
+	VirtualClock* mVirtualClock = nullptr;
+
+	// Where the log, the artwork cache and saved traces go
+	std::string mDataPath;
+
+	std::unique_ptr<TickScheduler> mScheduler;
+	std::mutex mSchedulerMutex; // protects mScheduler
+
+	// Only accessed through std::atomic_load/std::atomic_store
+	std::shared_ptr<const MediaState> mMediaState = std::make_shared<const MediaState>();
+	std::mutex mMediaStateWriteMutex; // serializes writers of mMediaState, protects mLastArtwork
 
-	void MediaChangedHandler(winrt::Windows::Media::Control::GlobalSystemMediaTransportControlsSession const& sender, winrt::Windows::Media::Control::MediaPropertiesChangedEventArgs  const& args);
-	void PlaybackChangedHandler(winrt::Windows::Media::Control::GlobalSystemMediaTransportControlsSession const& sender, winrt::Windows::Media::Control::PlaybackInfoChangedEventArgs const& args);
+	// The artwork the current key image was made from
+	std::shared_ptr<MediaArtwork> mLastArtwork;
 
-	std::string UTF8Encode(const std::wstring& wstr);
+	// Finished key images by thumbnail hash, so repeated artwork is only decoded once
+	static constexpr size_t kArtworkCacheBudget = 4 * 1024 * 1024;
+	ArtworkCache mArtworkCache{ kArtworkCacheBudget };
 
-	std::map<std::string, ButtonHandler*> mContextHandlers;
-	std::mutex mContextHandlersMutex; // protects mContextHandlers
+	// The same images on disk in the data folder, so a restarted plugin doesn't decode anything it has seen before
+	static constexpr size_t kArtworkDiskCacheBudget = 8 * 1024 * 1024;
+	ArtworkDiskCache mArtworkDiskCache;
 
-	std::wstring mTitle;
-	std::string mImage;
-	std::mutex mButtonDataMutex; // protects mTitle, mImage
+	// How long the media worker waits for a burst of events to settle before handling it
+	static constexpr std::chrono::milliseconds kMediaEventDebounce{ 75 };
+	std::unique_ptr<MediaEventWorker> mMediaWorker;
 
-	using MediaPropertiesChanged_revoker = winrt::Windows::Media::Control::GlobalSystemMediaTransportControlsSession::MediaPropertiesChanged_revoker;
-	using PlaybackInfoChanged_revoker = winrt::Windows::Media::Control::GlobalSystemMediaTransportControlsSession::PlaybackInfoChanged_revoker;
+	std::unique_ptr<MediaSource> mMediaSource;
 
-	std::map<std::string, std::tuple<MediaPropertiesChanged_revoker, PlaybackInfoChanged_revoker>> mSessionHandlers;
+	// How long each stage between a media event and the keys takes, logged on request from the property inspector
+	LatencyHistogram mEventToPublishLatency;	// oldest media event of a batch -> new state published
+	LatencyHistogram mArtworkLatency;			// artwork read, decoded and encoded, only when not cached
+	LatencyHistogram mFrameBuildLatency;		// scroll frames for a new title fetched or built
+	LatencyHistogram mPublishToTitleLatency;	// new title published -> its first setTitle queued, per context
+	LatencyHistogram mPublishToImageLatency;	// new artwork published -> its setImage queued, per context
+	LatencyHistogram mCheckMediaDuration;
 
-	winrt::Windows::Media::Control::IGlobalSystemMediaTransportControlsSessionManager mMgr{ nullptr };
+	// Opt-in loopback endpoint for Prometheus, started by the metrics_port setting. Only touched on the websocket io thread.
+	std::unique_ptr<MetricsServer> mMetricsServer;
 };
@@ -0,0 +1,96 @@
+//==============================================================================
+/**
+@file       Metrics.cpp
+
+@brief      Process-wide counters for the metrics endpoint, and the Prometheus text format
+
+@copyright  (c) 2021, bionyx187
+			This source code is licensed under the MIT-style license found in the LICENSE file.
+
+**/
+//==============================================================================
+
+#include "Metrics.h"
+
+#include <algorithm>
+#include <cstdio>
+
+struct alignas(64) MetricShard
+{
+	std::atomic<unsigned long long> values[static_cast<int>(MetricCounter::Count)] = {};
+};
+
+static MetricShard sShards[Metrics::kShards];
+static std::atomic<unsigned> sNextShard{ 0 };
+
+// Threads are handed shards round robin. With more threads than shards, some share, which is still correct.
+static thread_local unsigned sThreadShard = sNextShard.fetch_add(1, std::memory_order_relaxed) % Metrics::kShards;
+
+void Metrics::Add(MetricCounter inCounter, unsigned long long inAmount)
+{
+	sShards[sThreadShard].values[static_cast<int>(inCounter)].fetch_add(inAmount, std::memory_order_relaxed);
+}
+
+unsigned long long Metrics::Value(MetricCounter inCounter)
+{
+	unsigned long long value = 0;
+	for (const auto& shard : sShards) {
+		value += shard.values[static_cast<int>(inCounter)].load(std::memory_order_relaxed);
+	}
+	return value;
+}
+
+static void AppendHeader(std::string& outText, const char* inName, const char* inHelp, const char* inType)
+{
+	outText += "# HELP ";
+	outText += inName;
+	outText += ' ';
+	outText += inHelp;
+	outText += "\n# TYPE ";
+	outText += inName;
+	outText += ' ';
+	outText += inType;
+	outText += '\n';
+}
+
+void AppendPrometheusCounter(std::string& outText, const char* inName, const char* inHelp, unsigned long long inValue)
+{
+	AppendHeader(outText, inName, inHelp, "counter");
+	outText += inName;
+	outText += ' ';
+	outText += std::to_string(inValue);
+	outText += '\n';
+}
+
+void AppendPrometheusGauge(std::string& outText, const char* inName, const char* inHelp, double inValue)
+{
+	char number[32];
+	std::snprintf(number, sizeof(number), "%.17g", inValue);
+
+	AppendHeader(outText, inName, inHelp, "gauge");
+	outText += inName;
+	outText += ' ';
+	outText += number;
+	outText += '\n';
+}
+
+void AppendPrometheusHistogram(std::string& outText, const char* inName, const char* inHelp, const LatencyHistogram& inHistogram)
+{
+	AppendHeader(outText, inName, inHelp, "histogram");
+
+	// Bucket i holds latencies below 2^i microseconds. The last one is open ended and only shows up as +Inf.
+	char line[160];
+	unsigned long long cumulative = 0;
+	for (int bucket = 0; bucket < LatencyHistogram::kBuckets - 1; ++bucket) {
+		cumulative += inHistogram.BucketCount(bucket);
+		std::snprintf(line, sizeof(line), "%s_bucket{le=\"%.9g\"} %llu\n", inName, static_cast<double>(1ULL << bucket) / 1e6, cumulative);
+		outText += line;
+	}
+
+	// A Record racing with this can leave Count and the buckets one apart. The larger keeps +Inf at or above every bucket.
+	cumulative += inHistogram.BucketCount(LatencyHistogram::kBuckets - 1);
+	auto count = std::max(cumulative, inHistogram.Count());
+	std::snprintf(line, sizeof(line), "%s_bucket{le=\"+Inf\"} %llu\n%s_sum %.6f\n%s_count %llu\n",
+		inName, count, inName, static_cast<double>(inHistogram.TotalMicros()) / 1e6, inName, count);
+	outText += line;
+}
@@ -0,0 +1,58 @@
+//==============================================================================
+/**
+@file       Metrics.h
+
+@brief      Process-wide counters for the metrics endpoint, and the Prometheus text format
+
+@copyright  (c) 2021, bionyx187
+			This source code is licensed under the MIT-style license found in the LICENSE file.
+
+**/
+//==============================================================================
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <string>
+
+#include "LatencyHistogram.h"
+
+enum class MetricCounter
+{
+	Ticks,
+	TitleCalls,			// SetTitle calls, including ones superseded before they were sent
+	ImageCalls,
+	TitleMessagesSent,
+	TitleBytesSent,
+	ImageMessagesSent,
+	ImageBytesSent,
+	CheckMediaCalls,
+
+	Count
+};
+
+// Each thread adds to its own shard, a cache line of its own, so the tick path never fights another
+// thread over a counter. Reading sums the shards, which only the metrics endpoint does.
+class Metrics
+{
+public:
+	static constexpr int kShards = 16;
+
+	static void Add(MetricCounter inCounter, unsigned long long inAmount = 1);
+	static unsigned long long Value(MetricCounter inCounter);
+
+	// Bytes waiting in websocketpp's send buffer, sampled whenever the outbound queue flushes
+	static void SetBufferedBytes(size_t inBytes) { sBufferedBytes.store(inBytes, std::memory_order_relaxed); }
+	static size_t BufferedBytes() { return sBufferedBytes.load(std::memory_order_relaxed); }
+
+private:
+	static inline std::atomic<size_t> sBufferedBytes{ 0 };
+};
+
+// Prometheus text exposition format. Names should carry the unit, e.g. _seconds, _bytes or _total.
+void AppendPrometheusCounter(std::string& outText, const char* inName, const char* inHelp, unsigned long long inValue);
+void AppendPrometheusGauge(std::string& outText, const char* inName, const char* inHelp, double inValue);
+
+// The histogram's buckets become cumulative le buckets in seconds
+void AppendPrometheusHistogram(std::string& outText, const char* inName, const char* inHelp, const LatencyHistogram& inHistogram);
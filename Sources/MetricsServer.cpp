@@ -0,0 +1,161 @@
+//==============================================================================
+/**
+@file       MetricsServer.cpp
+
+@brief      Loopback-only HTTP endpoint that serves the plugin's metrics
+
+@copyright  (c) 2021, bionyx187
+			This source code is licensed under the MIT-style license found in the LICENSE file.
+
+**/
+//==============================================================================
+
+#include "MetricsServer.h"
+#include "Trace.h"
+
+#include <array>
+#include <memory>
+
+#include <asio/steady_timer.hpp>
+#include <asio/write.hpp>
+
+// Anything longer isn't a scrape
+static constexpr size_t kMaxRequestSize = 8 * 1024;
+
+// A client that connects and then says nothing is dropped after this long
+static constexpr std::chrono::seconds kRequestTimeout(5);
+
+class MetricsConnection : public std::enable_shared_from_this<MetricsConnection>
+{
+public:
+	MetricsConnection(asio::ip::tcp::socket inSocket, const MetricsServer::RenderFunction& inRender) :
+		mSocket(std::move(inSocket)),
+		mTimer(mSocket.get_executor().context()),
+		mRender(inRender)
+	{
+	}
+
+	void Start()
+	{
+		auto self(shared_from_this());
+		mTimer.expires_after(kRequestTimeout);
+		mTimer.async_wait([this, self](const asio::error_code& ec) {
+			if (ec != asio::error::operation_aborted) {
+				asio::error_code ignored;
+				mSocket.close(ignored);
+			}
+		});
+		Read();
+	}
+
+private:
+	void Read()
+	{
+		auto self(shared_from_this());
+		mSocket.async_read_some(asio::buffer(mBuffer), [this, self](const asio::error_code& ec, size_t inBytes) {
+			if (ec) {
+				return;
+			}
+			mRequest.append(mBuffer.data(), inBytes);
+			if (mRequest.find("\r\n\r\n") != std::string::npos) {
+				Respond();
+			}
+			else if (mRequest.size() > kMaxRequestSize) {
+				Reply("400 Bad Request", "text/plain", "Bad request\n");
+			}
+			else {
+				Read();
+			}
+		});
+	}
+
+	void Respond()
+	{
+		// Only the request line matters: "GET /metrics HTTP/1.1"
+		auto lineEnd = mRequest.find("\r\n");
+		auto methodEnd = mRequest.find(' ');
+		auto targetEnd = methodEnd != std::string::npos ? mRequest.find(' ', methodEnd + 1) : std::string::npos;
+		if (methodEnd == std::string::npos || targetEnd == std::string::npos || targetEnd > lineEnd) {
+			Reply("400 Bad Request", "text/plain", "Bad request\n");
+			return;
+		}
+
+		auto method = mRequest.substr(0, methodEnd);
+		auto target = mRequest.substr(methodEnd + 1, targetEnd - methodEnd - 1);
+		target = target.substr(0, target.find('?'));
+		if (method != "GET") {
+			Reply("405 Method Not Allowed", "text/plain", "Only GET is supported\n");
+		}
+		else if (target != "/metrics") {
+			Reply("404 Not Found", "text/plain", "Metrics are at /metrics\n");
+		}
+		else {
+			TRACE_SCOPE("metrics", "render");
+			Reply("200 OK", "text/plain; version=0.0.4; charset=utf-8", mRender());
+		}
+	}
+
+	void Reply(const char* inStatus, const char* inContentType, const std::string& inBody)
+	{
+		mReply = std::string("HTTP/1.1 ") + inStatus + "\r\n" +
+			"Content-Type: " + inContentType + "\r\n" +
+			"Content-Length: " + std::to_string(inBody.size()) + "\r\n" +
+			"Connection: close\r\n\r\n" + inBody;
+
+		auto self(shared_from_this());
+		asio::async_write(mSocket, asio::buffer(mReply), [this, self](const asio::error_code& ec, size_t) {
+			asio::error_code ignored;
+			if (!ec) {
+				mSocket.shutdown(asio::ip::tcp::socket::shutdown_both, ignored);
+			}
+			mSocket.close(ignored);
+			mTimer.cancel(ignored);
+		});
+	}
+
+	asio::ip::tcp::socket mSocket;
+	asio::steady_timer mTimer;
+	const MetricsServer::RenderFunction& mRender;
+
+	std::array<char, 1024> mBuffer;
+	std::string mRequest;
+	std::string mReply;
+};
+
+MetricsServer::MetricsServer(unsigned short inPort, RenderFunction inRender) :
+	mPort(inPort),
+	mRender(std::move(inRender))
+{
+	asio::ip::tcp::endpoint endpoint(asio::ip::address_v4::loopback(), inPort);
+	mAcceptor.open(endpoint.protocol());
+	mAcceptor.bind(endpoint);
+	mAcceptor.listen();
+
+	Accept();
+	mThread = std::thread([this]() {
+		Trace::SetThreadName("metrics");
+		mIOContext.run();
+	});
+}
+
+MetricsServer::~MetricsServer()
+{
+	// Connections still in flight are dropped along with their handlers when the io_context goes away.
+	mIOContext.stop();
+	if (mThread.joinable()) {
+		mThread.join();
+	}
+}
+
+void MetricsServer::Accept()
+{
+	mAcceptor.async_accept([this](const asio::error_code& ec, asio::ip::tcp::socket inSocket) {
+		if (!mAcceptor.is_open()) {
+			return;
+		}
+		if (!ec) {
+			std::make_shared<MetricsConnection>(std::move(inSocket), mRender)->Start();
+		}
+		Accept();
+	});
+}
@@ -0,0 +1,46 @@
+//==============================================================================
+/**
+@file       MetricsServer.h
+
+@brief      Loopback-only HTTP endpoint that serves the plugin's metrics
+
+@copyright  (c) 2021, bionyx187
+			This source code is licensed under the MIT-style license found in the LICENSE file.
+
+**/
+//==============================================================================
+
+#pragma once
+
+#include <functional>
+#include <string>
+#include <thread>
+
+#include <asio/io_context.hpp>
+#include <asio/ip/tcp.hpp>
+
+// A cut-down version of asio's HTTP server example: one request per connection, GET /metrics only,
+// and bound to 127.0.0.1 so nothing outside the machine can reach it. It runs its own io_context on
+// its own thread, so a slow scraper can't hold up the keys.
+class MetricsServer
+{
+public:
+	// Renders the response body in the Prometheus text format. Called on the server thread.
+	using RenderFunction = std::function<std::string()>;
+
+	// Throws asio::system_error if the port can't be bound
+	MetricsServer(unsigned short inPort, RenderFunction inRender);
+	~MetricsServer();
+
+	unsigned short Port() const { return mPort; }
+
+private:
+	void Accept();
+
+	unsigned short mPort;
+	RenderFunction mRender;
+
+	asio::io_context mIOContext{ 1 };
+	asio::ip::tcp::acceptor mAcceptor{ mIOContext };
+	std::thread mThread;
+};
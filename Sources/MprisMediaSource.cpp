@@ -0,0 +1,421 @@
+//==============================================================================
+/**
+@file       MprisMediaSource.cpp
+
+@brief      Media sessions from MPRIS players on the D-Bus session bus
+
+@copyright  (c) 2021, bionyx187
+			This source code is licensed under the MIT-style license found in the LICENSE file.
+
+**/
+//==============================================================================
+
+#include "MprisMediaSource.h"
+#include "Trace.h"
+#include "UTFTranscode.h"
+
+#include <cstring>
+
+#include <gdk-pixbuf/gdk-pixbuf.h>
+
+static const char kPlayerPrefix[] = "org.mpris.MediaPlayer2.";
+static const char kPlayerInterface[] = "org.mpris.MediaPlayer2.Player";
+static const char kPlayerPath[] = "/org/mpris/MediaPlayer2";
+static const int kCallTimeoutMs = 1000;
+
+static MediaPlaybackStatus ParsePlaybackStatus(const char* inStatus)
+{
+	if (std::strcmp(inStatus, "Playing") == 0) {
+		return MediaPlaybackStatus::Playing;
+	}
+	if (std::strcmp(inStatus, "Paused") == 0) {
+		return MediaPlaybackStatus::Paused;
+	}
+	if (std::strcmp(inStatus, "Stopped") == 0) {
+		return MediaPlaybackStatus::Stopped;
+	}
+	return MediaPlaybackStatus::Closed;
+}
+
+class MprisArtwork : public MediaArtwork
+{
+public:
+	explicit MprisArtwork(std::string inUrl) : mUrl(std::move(inUrl)) { }
+
+	// Players publish a new mpris:artUrl when the artwork changes
+	bool IsSame(const MediaArtwork& inOther) const override
+	{
+		auto other = dynamic_cast<const MprisArtwork*>(&inOther);
+		return other != nullptr && other->mUrl == mUrl;
+	}
+
+	// A missing or unreadable file is treated as no artwork rather than an error
+	bool Read(std::string& outBytes) override
+	{
+		GFile* file = g_file_new_for_uri(mUrl.c_str());
+		gchar* contents = nullptr;
+		gsize length = 0;
+		bool ok = TRACE_CALL("mpris", "load artwork", g_file_load_contents(file, nullptr, &contents, &length, nullptr, nullptr));
+		g_object_unref(file);
+		if (!ok) {
+			return false;
+		}
+		outBytes.assign(contents, length);
+		g_free(contents);
+		return true;
+	}
+
+	bool RenderPng(const std::string& inBytes, int inSize, std::string& outPng) override
+	{
+		GdkPixbufLoader* loader = gdk_pixbuf_loader_new();
+		bool ok = false;
+		{
+			TRACE_SCOPE("artwork", "decode");
+			ok = gdk_pixbuf_loader_write(loader, reinterpret_cast<const guchar*>(inBytes.data()), inBytes.size(), nullptr);
+			ok = gdk_pixbuf_loader_close(loader, nullptr) && ok;
+		}
+
+		// The loader owns the decoded image
+		GdkPixbuf* image = ok ? gdk_pixbuf_loader_get_pixbuf(loader) : nullptr;
+		GdkPixbuf* scaled = image != nullptr ? TRACE_CALL("artwork", "scale", gdk_pixbuf_scale_simple(image, inSize, inSize, GDK_INTERP_BILINEAR)) : nullptr;
+		g_object_unref(loader);
+		if (scaled == nullptr) {
+			return false;
+		}
+
+		gchar* buffer = nullptr;
+		gsize size = 0;
+		ok = TRACE_CALL("artwork", "encode", gdk_pixbuf_save_to_buffer(scaled, &buffer, &size, "png", nullptr, nullptr));
+		g_object_unref(scaled);
+		if (!ok) {
+			return false;
+		}
+		outPng.assign(buffer, size);
+		g_free(buffer);
+		return true;
+	}
+
+private:
+	std::string mUrl;
+};
+
+std::unique_ptr<MediaSource> CreateMediaSource()
+{
+	return std::make_unique<MprisMediaSource>();
+}
+
+MprisMediaSource::MprisMediaSource(const std::string& inBusAddress)
+{
+	GError* error = nullptr;
+	if (inBusAddress.empty()) {
+		mConnection = g_bus_get_sync(G_BUS_TYPE_SESSION, nullptr, &error);
+	}
+	else {
+		auto flags = static_cast<GDBusConnectionFlags>(G_DBUS_CONNECTION_FLAGS_AUTHENTICATION_CLIENT | G_DBUS_CONNECTION_FLAGS_MESSAGE_BUS_CONNECTION);
+		mConnection = g_dbus_connection_new_for_address_sync(inBusAddress.c_str(), flags, nullptr, nullptr, &error);
+	}
+
+	if (mConnection == nullptr) {
+		std::string message = error != nullptr ? error->message : "no D-Bus connection";
+		g_clear_error(&error);
+		throw MediaSourceError(message);
+	}
+}
+
+MprisMediaSource::~MprisMediaSource()
+{
+	Stop();
+	g_object_unref(mConnection);
+}
+
+void MprisMediaSource::Start(EventFunction inEventFunction)
+{
+	mEventFunction = std::move(inEventFunction);
+	mContext = g_main_context_new();
+	mLoop = g_main_loop_new(mContext, FALSE);
+
+	// Signal callbacks are dispatched on the main context that is the thread default at subscription time.
+	g_main_context_push_thread_default(mContext);
+	mNameOwnerSubscription = g_dbus_connection_signal_subscribe(mConnection, "org.freedesktop.DBus", "org.freedesktop.DBus", "NameOwnerChanged",
+		"/org/freedesktop/DBus", "org.mpris.MediaPlayer2", G_DBUS_SIGNAL_FLAGS_MATCH_ARG0_NAMESPACE, &MprisMediaSource::OnNameOwnerChanged, this, nullptr);
+	mPropertiesSubscription = g_dbus_connection_signal_subscribe(mConnection, nullptr, "org.freedesktop.DBus.Properties", "PropertiesChanged",
+		kPlayerPath, kPlayerInterface, G_DBUS_SIGNAL_FLAGS_NONE, &MprisMediaSource::OnPropertiesChanged, this, nullptr);
+	g_main_context_pop_thread_default(mContext);
+
+	// Players that are already running don't show up in NameOwnerChanged. Anything that starts in the meantime is
+	// reported by both, which AddPlayer tolerates.
+	GVariant* names = TRACE_CALL("mpris", "ListNames", g_dbus_connection_call_sync(mConnection, "org.freedesktop.DBus", "/org/freedesktop/DBus", "org.freedesktop.DBus", "ListNames",
+		nullptr, G_VARIANT_TYPE("(as)"), G_DBUS_CALL_FLAGS_NONE, kCallTimeoutMs, nullptr, nullptr));
+	if (names != nullptr) {
+		GVariantIter* iter = nullptr;
+		const gchar* name = nullptr;
+		g_variant_get(names, "(as)", &iter);
+		while (g_variant_iter_loop(iter, "&s", &name)) {
+			if (std::strncmp(name, kPlayerPrefix, sizeof(kPlayerPrefix) - 1) != 0) {
+				continue;
+			}
+			GVariant* owner = TRACE_CALL("mpris", "GetNameOwner", g_dbus_connection_call_sync(mConnection, "org.freedesktop.DBus", "/org/freedesktop/DBus", "org.freedesktop.DBus", "GetNameOwner",
+				g_variant_new("(s)", name), G_VARIANT_TYPE("(s)"), G_DBUS_CALL_FLAGS_NONE, kCallTimeoutMs, nullptr, nullptr));
+			if (owner != nullptr) {
+				const gchar* ownerName = nullptr;
+				g_variant_get(owner, "(&s)", &ownerName);
+				AddPlayer(name, ownerName);
+				g_variant_unref(owner);
+			}
+		}
+		g_variant_iter_free(iter);
+		g_variant_unref(names);
+	}
+
+	mThread = std::thread([this]() {
+		Trace::SetThreadName("mpris");
+		g_main_context_push_thread_default(mContext);
+		g_main_loop_run(mLoop);
+		g_main_context_pop_thread_default(mContext);
+	});
+}
+
+void MprisMediaSource::Stop()
+{
+	if (!mThread.joinable()) {
+		return;
+	}
+
+	// Once the loop thread is gone nothing dispatches the callbacks anymore. Whatever is still queued on the
+	// context is dropped with it.
+	g_main_loop_quit(mLoop);
+	mThread.join();
+	g_dbus_connection_signal_unsubscribe(mConnection, mNameOwnerSubscription);
+	g_dbus_connection_signal_unsubscribe(mConnection, mPropertiesSubscription);
+	g_main_loop_unref(mLoop);
+	g_main_context_unref(mContext);
+	mLoop = nullptr;
+	mContext = nullptr;
+	mEventFunction = nullptr;
+}
+
+void MprisMediaSource::OnNameOwnerChanged(GDBusConnection*, const gchar*, const gchar*, const gchar*, const gchar*, GVariant* inParameters, gpointer inUserData)
+{
+	auto source = static_cast<MprisMediaSource*>(inUserData);
+	const gchar* name = nullptr;
+	const gchar* oldOwner = nullptr;
+	const gchar* newOwner = nullptr;
+	g_variant_get(inParameters, "(&s&s&s)", &name, &oldOwner, &newOwner);
+
+	// The namespace match also lets through org.mpris.MediaPlayer2 itself, which isn't a player.
+	if (std::strncmp(name, kPlayerPrefix, sizeof(kPlayerPrefix) - 1) != 0) {
+		return;
+	}
+
+	if (*oldOwner != '\0') {
+		source->RemovePlayer(name);
+	}
+	if (*newOwner != '\0') {
+		source->AddPlayer(name, newOwner);
+	}
+}
+
+void MprisMediaSource::OnPropertiesChanged(GDBusConnection*, const gchar* inSender, const gchar*, const gchar*, const gchar*, GVariant* inParameters, gpointer inUserData)
+{
+	auto source = static_cast<MprisMediaSource*>(inUserData);
+	const gchar* interfaceName = nullptr;
+	GVariant* changed = nullptr;
+	const gchar** invalidated = nullptr;
+	g_variant_get(inParameters, "(&s@a{sv}^a&s)", &interfaceName, &changed, &invalidated);
+
+	// Players that only invalidate a property expect it to be fetched.
+	bool refetch = false;
+	for (auto property = invalidated; *property != nullptr; ++property) {
+		refetch = refetch || std::strcmp(*property, "PlaybackStatus") == 0 || std::strcmp(*property, "Metadata") == 0;
+	}
+	g_free(invalidated);
+
+	std::string name;
+	std::string owner;
+	bool metadataChanged = false;
+	bool playbackChanged = false;
+	{
+		std::lock_guard<std::mutex> lock(source->mMutex);
+		for (auto& player : source->mPlayers) {
+			if (player.second.owner == inSender) {
+				name = player.first;
+				owner = player.second.owner;
+				source->ApplyProperties(name, player.second, changed, metadataChanged, playbackChanged);
+				break;
+			}
+		}
+	}
+	g_variant_unref(changed);
+
+	if (name.empty()) {
+		return;
+	}
+
+	if (refetch) {
+		GVariant* reply = source->GetAllProperties(owner);
+		if (reply != nullptr) {
+			GVariant* properties = g_variant_get_child_value(reply, 0);
+			std::lock_guard<std::mutex> lock(source->mMutex);
+			auto player = source->mPlayers.find(name);
+			if (player != source->mPlayers.end()) {
+				source->ApplyProperties(name, player->second, properties, metadataChanged, playbackChanged);
+			}
+			g_variant_unref(properties);
+			g_variant_unref(reply);
+		}
+	}
+
+	if (metadataChanged) {
+		source->Notify(Event::PropertiesChanged, name);
+	}
+	if (playbackChanged) {
+		source->Notify(Event::PlaybackChanged, name);
+	}
+}
+
+GVariant* MprisMediaSource::GetAllProperties(const std::string& inOwner)
+{
+	TRACE_SCOPE("mpris", "GetAll");
+	return g_dbus_connection_call_sync(mConnection, inOwner.c_str(), kPlayerPath, "org.freedesktop.DBus.Properties", "GetAll",
+		g_variant_new("(s)", kPlayerInterface), G_VARIANT_TYPE("(a{sv})"), G_DBUS_CALL_FLAGS_NONE, kCallTimeoutMs, nullptr, nullptr);
+}
+
+void MprisMediaSource::AddPlayer(const std::string& inName, const std::string& inOwner)
+{
+	// Fetched without holding the lock; the getters shouldn't wait on a slow player.
+	GVariant* reply = GetAllProperties(inOwner);
+
+	bool added = false;
+	{
+		std::lock_guard<std::mutex> lock(mMutex);
+		auto& player = mPlayers[inName];
+		added = player.owner != inOwner;
+		player.owner = inOwner;
+		if (reply != nullptr) {
+			bool metadataChanged = false;
+			bool playbackChanged = false;
+			GVariant* properties = g_variant_get_child_value(reply, 0);
+			ApplyProperties(inName, player, properties, metadataChanged, playbackChanged);
+			g_variant_unref(properties);
+		}
+	}
+	if (reply != nullptr) {
+		g_variant_unref(reply);
+	}
+
+	if (added) {
+		Notify(Event::SessionAdded, inName);
+	}
+}
+
+void MprisMediaSource::RemovePlayer(const std::string& inName)
+{
+	{
+		std::lock_guard<std::mutex> lock(mMutex);
+		if (mPlayers.erase(inName) == 0) {
+			return;
+		}
+		if (mCurrent == inName) {
+			mCurrent.clear();
+		}
+	}
+	Notify(Event::SessionRemoved, inName);
+}
+
+void MprisMediaSource::ApplyProperties(const std::string& inName, Player& ioPlayer, GVariant* inProperties, bool& outMetadataChanged, bool& outPlaybackChanged)
+{
+	const gchar* statusName = nullptr;
+	if (g_variant_lookup(inProperties, "PlaybackStatus", "&s", &statusName)) {
+		auto status = ParsePlaybackStatus(statusName);
+		if (status != ioPlayer.status) {
+			ioPlayer.status = status;
+			outPlaybackChanged = true;
+		}
+		if (status == MediaPlaybackStatus::Playing) {
+			mCurrent = inName;
+		}
+	}
+
+	// Metadata always comes as a whole, so anything missing from it is gone.
+	GVariant* metadata = g_variant_lookup_value(inProperties, "Metadata", G_VARIANT_TYPE_VARDICT);
+	if (metadata == nullptr) {
+		return;
+	}
+
+	const gchar* value = nullptr;
+	std::string title = g_variant_lookup(metadata, "xesam:title", "&s", &value) ? value : "";
+	std::string artUrl = g_variant_lookup(metadata, "mpris:artUrl", "&s", &value) ? value : "";
+
+	std::wstring artist;
+	GVariant* artists = g_variant_lookup_value(metadata, "xesam:artist", G_VARIANT_TYPE_STRING_ARRAY);
+	if (artists != nullptr) {
+		gsize count = 0;
+		const gchar** names = g_variant_get_strv(artists, &count);
+		for (gsize i = 0; i < count; ++i) {
+			if (i > 0) {
+				artist += L", ";
+			}
+			artist += ToWide(names[i]);
+		}
+		g_free(names);
+		g_variant_unref(artists);
+	}
+	g_variant_unref(metadata);
+
+	if (title != ioPlayer.title || artist != ioPlayer.artist || artUrl != ioPlayer.artUrl) {
+		ioPlayer.title = std::move(title);
+		ioPlayer.artist = std::move(artist);
+		ioPlayer.artUrl = std::move(artUrl);
+		outMetadataChanged = true;
+	}
+}
+
+void MprisMediaSource::Notify(Event inEvent, const std::string& inName)
+{
+	if (mEventFunction != nullptr) {
+		mEventFunction(inEvent, ToWide(inName));
+	}
+}
+
+std::wstring MprisMediaSource::GetCurrentSessionId()
+{
+	std::lock_guard<std::mutex> lock(mMutex);
+	return ToWide(mCurrent);
+}
+
+std::vector<MediaSessionInfo> MprisMediaSource::GetSessions()
+{
+	std::lock_guard<std::mutex> lock(mMutex);
+	std::vector<MediaSessionInfo> sessions;
+	for (const auto& player : mPlayers) {
+		MediaSessionInfo info;
+		info.id = ToWide(player.first);
+		info.status = player.second.status;
+		sessions.push_back(std::move(info));
+	}
+	return sessions;
+}
+
+bool MprisMediaSource::GetPlaybackStatus(const std::wstring& inSessionId, MediaPlaybackStatus& outStatus)
+{
+	std::lock_guard<std::mutex> lock(mMutex);
+	auto player = mPlayers.find(ToUTF8(inSessionId));
+	if (player == mPlayers.end()) {
+		return false;
+	}
+	outStatus = player->second.status;
+	return true;
+}
+
+bool MprisMediaSource::GetProperties(const std::wstring& inSessionId, MediaProperties& outProperties)
+{
+	std::lock_guard<std::mutex> lock(mMutex);
+	auto player = mPlayers.find(ToUTF8(inSessionId));
+	if (player == mPlayers.end()) {
+		return false;
+	}
+	outProperties.title = player->second.title;
+	outProperties.artist = player->second.artist;
+	outProperties.artwork = player->second.artUrl.empty() ? nullptr : std::make_shared<MprisArtwork>(player->second.artUrl);
+	return true;
+}
@@ -0,0 +1,79 @@
+//==============================================================================
+/**
+@file       MprisMediaSource.h
+
+@brief      Media sessions from MPRIS players on the D-Bus session bus
+
+@copyright  (c) 2021, bionyx187
+			This source code is licensed under the MIT-style license found in the LICENSE file.
+
+**/
+//==============================================================================
+
+#pragma once
+
+#include "MediaSource.h"
+
+#include <map>
+#include <mutex>
+#include <thread>
+
+#include <gio/gio.h>
+
+// Every org.mpris.MediaPlayer2.* name on the bus is a session, with the well-known name as its id.
+// Nothing is polled: players coming and going are followed through NameOwnerChanged and their
+// state through PropertiesChanged, both dispatched on a GLib main loop on a thread of our own.
+// The state from the signals is kept here, so the getters never go to the bus.
+class MprisMediaSource : public MediaSource
+{
+public:
+	// An empty address means the session bus. Anything else is a D-Bus address, such as the one a
+	// private dbus-daemon prints.
+	explicit MprisMediaSource(const std::string& inBusAddress = std::string());
+	virtual ~MprisMediaSource();
+
+	void Start(EventFunction inEventFunction) override;
+	void Stop() override;
+
+	// MPRIS has no notion of a current player, so this is the one that most recently started playing
+	std::wstring GetCurrentSessionId() override;
+	std::vector<MediaSessionInfo> GetSessions() override;
+	bool GetPlaybackStatus(const std::wstring& inSessionId, MediaPlaybackStatus& outStatus) override;
+	bool GetProperties(const std::wstring& inSessionId, MediaProperties& outProperties) override;
+
+private:
+	struct Player
+	{
+		std::string owner; // unique bus name, which is what signals come from
+		MediaPlaybackStatus status = MediaPlaybackStatus::Closed;
+		std::string title;
+		std::wstring artist;
+		std::string artUrl;
+	};
+
+	static void OnNameOwnerChanged(GDBusConnection* inConnection, const gchar* inSender, const gchar* inPath, const gchar* inInterface, const gchar* inSignal, GVariant* inParameters, gpointer inUserData);
+	static void OnPropertiesChanged(GDBusConnection* inConnection, const gchar* inSender, const gchar* inPath, const gchar* inInterface, const gchar* inSignal, GVariant* inParameters, gpointer inUserData);
+
+	void AddPlayer(const std::string& inName, const std::string& inOwner);
+	void RemovePlayer(const std::string& inName);
+	GVariant* GetAllProperties(const std::string& inOwner);
+
+	// Applies a PlaybackStatus/Metadata dictionary. Callers hold mMutex.
+	void ApplyProperties(const std::string& inName, Player& ioPlayer, GVariant* inProperties, bool& outMetadataChanged, bool& outPlaybackChanged);
+
+	void Notify(Event inEvent, const std::string& inName);
+
+	GDBusConnection* mConnection = nullptr;
+	GMainContext* mContext = nullptr;
+	GMainLoop* mLoop = nullptr;
+	guint mNameOwnerSubscription = 0;
+	guint mPropertiesSubscription = 0;
+	std::thread mThread;
+
+	// Set before the loop thread starts and cleared after it stopped
+	EventFunction mEventFunction;
+
+	std::map<std::string, Player> mPlayers;
+	std::string mCurrent;
+	std::mutex mMutex; // protects mPlayers, mCurrent
+};
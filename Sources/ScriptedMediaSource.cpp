@@ -0,0 +1,205 @@
+//==============================================================================
+/**
+@file       ScriptedMediaSource.cpp
+
+@brief      A media source that plays back a scripted timeline instead of a real player
+
+@copyright  (c) 2021, bionyx187
+			This source code is licensed under the MIT-style license found in the LICENSE file.
+
+**/
+//==============================================================================
+
+#include "ScriptedMediaSource.h"
+
+class ScriptedArtwork : public MediaArtwork
+{
+public:
+	explicit ScriptedArtwork(std::shared_ptr<const std::string> inBytes) : mBytes(std::move(inBytes)) { }
+
+	// Steps that reuse the same bytes object publish the same artwork
+	bool IsSame(const MediaArtwork& inOther) const override
+	{
+		auto other = dynamic_cast<const ScriptedArtwork*>(&inOther);
+		return other != nullptr && other->mBytes == mBytes;
+	}
+
+	bool Read(std::string& outBytes) override
+	{
+		outBytes = *mBytes;
+		return true;
+	}
+
+	bool RenderPng(const std::string& inBytes, int, std::string& outPng) override
+	{
+		outPng = inBytes;
+		return true;
+	}
+
+private:
+	std::shared_ptr<const std::string> mBytes;
+};
+
+void ScriptedMediaSource::AddStep(duration inAt, Step inStep)
+{
+	std::lock_guard<std::mutex> lock(mMutex);
+	mSteps.emplace(inAt, std::move(inStep));
+}
+
+void ScriptedMediaSource::AddSession(duration inAt, const std::wstring& inSessionId)
+{
+	Step step;
+	step.action = Action::AddSession;
+	step.sessionId = inSessionId;
+	AddStep(inAt, std::move(step));
+}
+
+void ScriptedMediaSource::RemoveSession(duration inAt, const std::wstring& inSessionId)
+{
+	Step step;
+	step.action = Action::RemoveSession;
+	step.sessionId = inSessionId;
+	AddStep(inAt, std::move(step));
+}
+
+void ScriptedMediaSource::SetCurrentSession(duration inAt, const std::wstring& inSessionId)
+{
+	Step step;
+	step.action = Action::SetCurrentSession;
+	step.sessionId = inSessionId;
+	AddStep(inAt, std::move(step));
+}
+
+void ScriptedMediaSource::SetTrack(duration inAt, const std::wstring& inSessionId, const std::string& inTitle, const std::wstring& inArtist, std::shared_ptr<const std::string> inArtwork)
+{
+	Step step;
+	step.action = Action::SetTrack;
+	step.sessionId = inSessionId;
+	step.title = inTitle;
+	step.artist = inArtist;
+	step.artwork = std::move(inArtwork);
+	AddStep(inAt, std::move(step));
+}
+
+void ScriptedMediaSource::SetPlayback(duration inAt, const std::wstring& inSessionId, MediaPlaybackStatus inStatus)
+{
+	Step step;
+	step.action = Action::SetPlayback;
+	step.sessionId = inSessionId;
+	step.status = inStatus;
+	AddStep(inAt, std::move(step));
+}
+
+void ScriptedMediaSource::RunUntil(duration inTime)
+{
+	for (;;) {
+		Event event{};
+		std::wstring sessionId;
+		EventFunction eventFunction;
+		{
+			std::lock_guard<std::mutex> lock(mMutex);
+			auto next = mSteps.begin();
+			if (next == mSteps.end() || next->first > inTime) {
+				return;
+			}
+			auto step = std::move(next->second);
+			mSteps.erase(next);
+
+			// Steps for sessions that don't exist are dropped, as a real player's events would be.
+			auto session = mSessions.find(step.sessionId);
+			if (step.action != Action::AddSession && session == mSessions.end()) {
+				continue;
+			}
+
+			sessionId = step.sessionId;
+			switch (step.action) {
+			case Action::AddSession:
+				mSessions[sessionId] = Session();
+				event = Event::SessionAdded;
+				break;
+			case Action::RemoveSession:
+				mSessions.erase(session);
+				if (mCurrent == sessionId) {
+					mCurrent.clear();
+				}
+				event = Event::SessionRemoved;
+				break;
+			case Action::SetCurrentSession:
+				// There is no event for this on any platform; the next refresh picks it up.
+				mCurrent = sessionId;
+				continue;
+			case Action::SetTrack:
+				session->second.title = std::move(step.title);
+				session->second.artist = std::move(step.artist);
+				session->second.artwork = std::move(step.artwork);
+				event = Event::PropertiesChanged;
+				break;
+			case Action::SetPlayback:
+				session->second.status = step.status;
+				event = Event::PlaybackChanged;
+				break;
+			}
+			eventFunction = mEventFunction;
+		}
+
+		// Delivered without the lock, so the handler can call the getters.
+		if (eventFunction != nullptr) {
+			eventFunction(event, sessionId);
+		}
+	}
+}
+
+void ScriptedMediaSource::Start(EventFunction inEventFunction)
+{
+	std::lock_guard<std::mutex> lock(mMutex);
+	mEventFunction = std::move(inEventFunction);
+}
+
+void ScriptedMediaSource::Stop()
+{
+	std::lock_guard<std::mutex> lock(mMutex);
+	mEventFunction = nullptr;
+}
+
+std::wstring ScriptedMediaSource::GetCurrentSessionId()
+{
+	std::lock_guard<std::mutex> lock(mMutex);
+	return mCurrent;
+}
+
+std::vector<MediaSessionInfo> ScriptedMediaSource::GetSessions()
+{
+	std::lock_guard<std::mutex> lock(mMutex);
+	std::vector<MediaSessionInfo> sessions;
+	for (const auto& session : mSessions) {
+		MediaSessionInfo info;
+		info.id = session.first;
+		info.status = session.second.status;
+		sessions.push_back(std::move(info));
+	}
+	return sessions;
+}
+
+bool ScriptedMediaSource::GetPlaybackStatus(const std::wstring& inSessionId, MediaPlaybackStatus& outStatus)
+{
+	std::lock_guard<std::mutex> lock(mMutex);
+	auto session = mSessions.find(inSessionId);
+	if (session == mSessions.end()) {
+		return false;
+	}
+	outStatus = session->second.status;
+	return true;
+}
+
+bool ScriptedMediaSource::GetProperties(const std::wstring& inSessionId, MediaProperties& outProperties)
+{
+	std::lock_guard<std::mutex> lock(mMutex);
+	auto session = mSessions.find(inSessionId);
+	if (session == mSessions.end()) {
+		return false;
+	}
+	outProperties.title = session->second.title;
+	outProperties.artist = session->second.artist;
+	outProperties.artwork = session->second.artwork != nullptr ? std::make_shared<ScriptedArtwork>(session->second.artwork) : nullptr;
+	return true;
+}
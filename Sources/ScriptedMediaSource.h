@@ -0,0 +1,84 @@
+//==============================================================================
+/**
+@file       ScriptedMediaSource.h
+
+@brief      A media source that plays back a scripted timeline instead of a real player
+
+@copyright  (c) 2021, bionyx187
+			This source code is licensed under the MIT-style license found in the LICENSE file.
+
+**/
+//==============================================================================
+
+#pragma once
+
+#include "MediaSource.h"
+#include "VirtualClock.h"
+
+#include <map>
+#include <mutex>
+
+// Sessions, tracks, artwork and playback are changed by steps at fixed offsets into the timeline.
+// RunUntil applies the steps up to a point and delivers their events on the calling thread, so a
+// run is the same every time and needs no real time to pass. Artwork is taken to be the finished
+// key PNG, so rendering it costs nothing.
+class ScriptedMediaSource : public MediaSource
+{
+public:
+	using duration = VirtualClock::duration;
+
+	// Timeline steps. Steps at the same offset are applied in the order they were added.
+	void AddSession(duration inAt, const std::wstring& inSessionId);
+	void RemoveSession(duration inAt, const std::wstring& inSessionId);
+	void SetCurrentSession(duration inAt, const std::wstring& inSessionId);
+	void SetTrack(duration inAt, const std::wstring& inSessionId, const std::string& inTitle, const std::wstring& inArtist, std::shared_ptr<const std::string> inArtwork);
+	void SetPlayback(duration inAt, const std::wstring& inSessionId, MediaPlaybackStatus inStatus);
+
+	// Applies every step at or before inTime that hasn't been applied yet
+	void RunUntil(duration inTime);
+
+	void Start(EventFunction inEventFunction) override;
+	void Stop() override;
+
+	std::wstring GetCurrentSessionId() override;
+	std::vector<MediaSessionInfo> GetSessions() override;
+	bool GetPlaybackStatus(const std::wstring& inSessionId, MediaPlaybackStatus& outStatus) override;
+	bool GetProperties(const std::wstring& inSessionId, MediaProperties& outProperties) override;
+
+private:
+	enum class Action
+	{
+		AddSession,
+		RemoveSession,
+		SetCurrentSession,
+		SetTrack,
+		SetPlayback
+	};
+
+	struct Step
+	{
+		Action action;
+		std::wstring sessionId;
+		std::string title;
+		std::wstring artist;
+		std::shared_ptr<const std::string> artwork;
+		MediaPlaybackStatus status = MediaPlaybackStatus::Closed;
+	};
+
+	struct Session
+	{
+		MediaPlaybackStatus status = MediaPlaybackStatus::Opened;
+		std::string title;
+		std::wstring artist;
+		std::shared_ptr<const std::string> artwork;
+	};
+
+	void AddStep(duration inAt, Step inStep);
+
+	std::multimap<duration, Step> mSteps;
+
+	EventFunction mEventFunction;
+	std::map<std::wstring, Session> mSessions;
+	std::wstring mCurrent;
+	std::mutex mMutex; // protects everything above
+};
@@ -0,0 +1,273 @@
+//==============================================================================
+/**
+@file       SmtcMediaSource.cpp
+
+@brief      Media sessions from the Windows System Media Transport Controls
+
+@copyright  (c) 2021, bionyx187
+			This source code is licensed under the MIT-style license found in the LICENSE file.
+
+**/
+//==============================================================================
+
+#include "SmtcMediaSource.h"
+#include "Trace.h"
+#include "UTFTranscode.h"
+
+#include <set>
+
+#include <winrt/Windows.Graphics.Imaging.h>
+
+using namespace winrt;
+using namespace Windows::Graphics::Imaging;
+using namespace Windows::Media::Control;
+using namespace Windows::Storage::Streams;
+
+static MediaSourceError ToMediaSourceError(const winrt::hresult_error& inError)
+{
+	return MediaSourceError(ToUTF8(inError.message()));
+}
+
+class SmtcArtwork : public MediaArtwork
+{
+public:
+	explicit SmtcArtwork(IRandomAccessStreamReference inThumbnail) : mThumbnail(std::move(inThumbnail)) { }
+
+	// The session hands out the same reference until the thumbnail changes
+	bool IsSame(const MediaArtwork& inOther) const override
+	{
+		auto other = dynamic_cast<const SmtcArtwork*>(&inOther);
+		return other != nullptr && other->mThumbnail == mThumbnail;
+	}
+
+	bool Read(std::string& outBytes) override
+	{
+		try {
+			auto stream = TRACE_CALL("smtc", "OpenReadAsync", mThumbnail.OpenReadAsync().get());
+			auto size = static_cast<uint32_t>(stream.Size());
+			auto buffer = TRACE_CALL("smtc", "ReadAsync", stream.ReadAsync(Buffer(size), size, InputStreamOptions::None).get());
+			outBytes.assign(reinterpret_cast<const char*>(buffer.data()), buffer.Length());
+			return true;
+		}
+		catch (winrt::hresult_error e) {
+			throw ToMediaSourceError(e);
+		}
+	}
+
+	bool RenderPng(const std::string& inBytes, int inSize, std::string& outPng) override
+	{
+		try {
+			InMemoryRandomAccessStream inStream;
+			DataWriter writer(inStream);
+			writer.WriteBytes(array_view<const uint8_t>(reinterpret_cast<const uint8_t*>(inBytes.data()), static_cast<uint32_t>(inBytes.size())));
+			TRACE_CALL("smtc", "StoreAsync", writer.StoreAsync().get());
+			writer.DetachStream();
+			inStream.Seek(0);
+
+			// The decoder is auto-configuring so it'll read the input data (which has always been PNG so far).
+			auto decoder = TRACE_CALL("artwork", "open decoder", BitmapDecoder::CreateAsync(inStream).get());
+
+			// Scale the image down for the button by applying the transform here and requesting the same size on the encoder.
+			BitmapTransform transform;
+			transform.ScaledHeight(inSize);
+			transform.ScaledWidth(inSize);
+			auto pixels = TRACE_CALL("artwork", "decode and scale", decoder.GetPixelDataAsync(BitmapPixelFormat::Bgra8, BitmapAlphaMode::Straight, transform, ExifOrientationMode::RespectExifOrientation, ColorManagementMode::ColorManageToSRgb).get());
+			InMemoryRandomAccessStream outStream;
+			{
+				TRACE_SCOPE("artwork", "encode");
+				auto encoder = BitmapEncoder::CreateAsync(BitmapEncoder::PngEncoderId(), outStream).get();
+				auto pixelData = pixels.DetachPixelData();
+				encoder.SetPixelData(decoder.BitmapPixelFormat(), BitmapAlphaMode::Ignore, inSize, inSize, decoder.DpiX(), decoder.DpiY(), pixelData);
+				encoder.FlushAsync().get();
+			}
+
+			// At this point outStream has the PNG-encoded data. We reset the stream for reading, create a buffer to hold the data
+			// and read into the buffer.
+			outStream.Seek(0);
+			auto size = static_cast<uint32_t>(outStream.Size());
+			auto buffer = TRACE_CALL("smtc", "ReadAsync", outStream.ReadAsync(Buffer(size), size, InputStreamOptions::None).get());
+			outPng.assign(reinterpret_cast<const char*>(buffer.data()), buffer.Length());
+			return true;
+		}
+		catch (winrt::hresult_error e) {
+			throw ToMediaSourceError(e);
+		}
+	}
+
+private:
+	IRandomAccessStreamReference mThumbnail;
+};
+
+std::unique_ptr<MediaSource> CreateMediaSource()
+{
+	return std::make_unique<SmtcMediaSource>();
+}
+
+SmtcMediaSource::SmtcMediaSource()
+{
+	mMgr = TRACE_CALL("smtc", "RequestAsync", GlobalSystemMediaTransportControlsSessionManager::RequestAsync().get());
+}
+
+SmtcMediaSource::~SmtcMediaSource()
+{
+	Stop();
+}
+
+void SmtcMediaSource::Start(EventFunction inEventFunction)
+{
+	{
+		std::lock_guard<std::mutex> lock(mMutex);
+		mEventFunction = std::move(inEventFunction);
+	}
+
+	mSessionsChangedRevoker = mMgr.SessionsChanged(winrt::auto_revoke, [this](GlobalSystemMediaTransportControlsSessionManager const&, SessionsChangedEventArgs const&) {
+		SyncSessionHandlers();
+	});
+
+	// Sessions that exist already don't get a sessions changed event, so hook them up now.
+	SyncSessionHandlers();
+}
+
+void SmtcMediaSource::Stop()
+{
+	mSessionsChangedRevoker.revoke();
+
+	// Handlers that are running hold mMutex, so once this has it, none are left and none will start.
+	std::lock_guard<std::mutex> lock(mMutex);
+	mSessionHandlers.clear();
+	mEventFunction = nullptr;
+}
+
+// SessionsChanged doesn't say what changed, so compare the sessions against the ones we have handlers for.
+// Handlers for sessions that stay are left alone.
+void SmtcMediaSource::SyncSessionHandlers()
+{
+	std::lock_guard<std::mutex> lock(mMutex);
+	if (mEventFunction == nullptr) {
+		return;
+	}
+
+	std::set<std::wstring> current;
+	try {
+		for (const auto& session : mMgr.GetSessions()) {
+			std::wstring id(session.SourceAppUserModelId());
+			current.insert(id);
+			if (mSessionHandlers.count(id) != 0) {
+				continue;
+			}
+
+			auto media_revoker = session.MediaPropertiesChanged(winrt::auto_revoke, [this](Session const& sender, MediaPropertiesChangedEventArgs const&) {
+				Notify(Event::PropertiesChanged, std::wstring(sender.SourceAppUserModelId()));
+			});
+			auto playback_revoker = session.PlaybackInfoChanged(winrt::auto_revoke, [this](Session const& sender, PlaybackInfoChangedEventArgs const&) {
+				Notify(Event::PlaybackChanged, std::wstring(sender.SourceAppUserModelId()));
+			});
+			mSessionHandlers.emplace(id, std::make_tuple(std::move(media_revoker), std::move(playback_revoker)));
+			mEventFunction(Event::SessionAdded, id);
+		}
+	}
+	catch (winrt::hresult_error) {
+		// Leave things as they are; the next sessions changed event tries again.
+		return;
+	}
+
+	for (auto handler = mSessionHandlers.begin(); handler != mSessionHandlers.end();) {
+		if (current.count(handler->first) != 0) {
+			++handler;
+			continue;
+		}
+		auto id = handler->first;
+		handler = mSessionHandlers.erase(handler);
+		mEventFunction(Event::SessionRemoved, id);
+	}
+}
+
+void SmtcMediaSource::Notify(Event inEvent, const std::wstring& inSessionId)
+{
+	std::lock_guard<std::mutex> lock(mMutex);
+	if (mEventFunction != nullptr) {
+		mEventFunction(inEvent, inSessionId);
+	}
+}
+
+SmtcMediaSource::Session SmtcMediaSource::FindSession(const std::wstring& inSessionId)
+{
+	for (const auto& session : mMgr.GetSessions()) {
+		if (session.SourceAppUserModelId() == inSessionId) {
+			return session;
+		}
+	}
+	return nullptr;
+}
+
+std::wstring SmtcMediaSource::GetCurrentSessionId()
+{
+	try {
+		auto session = mMgr.GetCurrentSession();
+		return session != nullptr ? std::wstring(session.SourceAppUserModelId()) : std::wstring();
+	}
+	catch (winrt::hresult_error e) {
+		throw ToMediaSourceError(e);
+	}
+}
+
+std::vector<MediaSessionInfo> SmtcMediaSource::GetSessions()
+{
+	try {
+		std::vector<MediaSessionInfo> sessions;
+		for (const auto& session : mMgr.GetSessions()) {
+			MediaSessionInfo info;
+			info.id = session.SourceAppUserModelId();
+			auto playback = session.GetPlaybackInfo();
+			if (playback != nullptr) {
+				info.status = static_cast<MediaPlaybackStatus>(playback.PlaybackStatus());
+			}
+			sessions.push_back(std::move(info));
+		}
+		return sessions;
+	}
+	catch (winrt::hresult_error e) {
+		throw ToMediaSourceError(e);
+	}
+}
+
+bool SmtcMediaSource::GetPlaybackStatus(const std::wstring& inSessionId, MediaPlaybackStatus& outStatus)
+{
+	try {
+		auto session = FindSession(inSessionId);
+		if (session == nullptr) {
+			return false;
+		}
+		auto info = session.GetPlaybackInfo();
+		if (info == nullptr) {
+			return false;
+		}
+		outStatus = static_cast<MediaPlaybackStatus>(info.PlaybackStatus());
+		return true;
+	}
+	catch (winrt::hresult_error e) {
+		throw ToMediaSourceError(e);
+	}
+}
+
+bool SmtcMediaSource::GetProperties(const std::wstring& inSessionId, MediaProperties& outProperties)
+{
+	try {
+		auto session = FindSession(inSessionId);
+		if (session == nullptr) {
+			return false;
+		}
+		auto properties = TRACE_CALL("smtc", "TryGetMediaPropertiesAsync", session.TryGetMediaPropertiesAsync().get());
+		if (properties == nullptr) {
+			return false;
+		}
+		outProperties.title = ToUTF8(properties.Title());
+		outProperties.artist = properties.Artist();
+		auto thumbnail = properties.Thumbnail();
+		outProperties.artwork = thumbnail != nullptr ? std::make_shared<SmtcArtwork>(thumbnail) : nullptr;
+		return true;
+	}
+	catch (winrt::hresult_error e) {
+		throw ToMediaSourceError(e);
+	}
+}
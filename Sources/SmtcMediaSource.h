@@ -0,0 +1,56 @@
+//==============================================================================
+/**
+@file       SmtcMediaSource.h
+
+@brief      Media sessions from the Windows System Media Transport Controls
+
+@copyright  (c) 2021, bionyx187
+			This source code is licensed under the MIT-style license found in the LICENSE file.
+
+**/
+//==============================================================================
+
+#pragma once
+
+#include "MediaSource.h"
+
+#include <map>
+#include <mutex>
+#include <tuple>
+
+#include <winrt/base.h>
+#include <winrt/Windows.Media.Control.h>
+#include <winrt/Windows.Foundation.Collections.h>
+#include <winrt/Windows.Storage.Streams.h>
+
+class SmtcMediaSource : public MediaSource
+{
+public:
+	SmtcMediaSource();
+	virtual ~SmtcMediaSource();
+
+	void Start(EventFunction inEventFunction) override;
+	void Stop() override;
+
+	std::wstring GetCurrentSessionId() override;
+	std::vector<MediaSessionInfo> GetSessions() override;
+	bool GetPlaybackStatus(const std::wstring& inSessionId, MediaPlaybackStatus& outStatus) override;
+	bool GetProperties(const std::wstring& inSessionId, MediaProperties& outProperties) override;
+
+private:
+	using Session = winrt::Windows::Media::Control::GlobalSystemMediaTransportControlsSession;
+
+	void SyncSessionHandlers();
+	Session FindSession(const std::wstring& inSessionId);
+	void Notify(Event inEvent, const std::wstring& inSessionId);
+
+	using MediaPropertiesChanged_revoker = Session::MediaPropertiesChanged_revoker;
+	using PlaybackInfoChanged_revoker = Session::PlaybackInfoChanged_revoker;
+
+	winrt::Windows::Media::Control::IGlobalSystemMediaTransportControlsSessionManager mMgr{ nullptr };
+	winrt::Windows::Media::Control::GlobalSystemMediaTransportControlsSessionManager::SessionsChanged_revoker mSessionsChangedRevoker;
+
+	EventFunction mEventFunction;
+	std::map<std::wstring, std::tuple<MediaPropertiesChanged_revoker, PlaybackInfoChanged_revoker>> mSessionHandlers;
+	std::mutex mMutex; // protects mEventFunction, mSessionHandlers
+};
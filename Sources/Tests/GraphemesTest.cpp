@@ -0,0 +1,1296 @@
+//==============================================================================
+/**
+@file       GraphemesTest.cpp
+
+@brief      IndexGraphemes against UAX #29 test cases, and RepairUTF8
+
+@copyright  (c) 2021, bionyx187
+			This source code is licensed under the MIT-style license found in the LICENSE file.
+
+**/
+//==============================================================================
+
+#include "../Graphemes.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <initializer_list>
+#include <string>
+#include <vector>
+
+// The cases are in the form of GraphemeBreakTest.txt, with / for a break and x for none. The official file can't be
+// shipped with the tests, so they were made the way it is made, and the breaks are from Perl 5.36's \X, which
+// implements UAX #29 on the Unicode 14 UCD, with GB9c from Unicode 15.1 applied on top:
+//
+// - Every pair of one sample per break class, on its own and with U+0308 in between.
+// - The sequences at the end of GraphemeBreakTest.txt: CRLF, Hangul, flags, emoji modifiers and ZWJ sequences,
+//   plus Indic conjuncts for GB9c.
+//
+// The class of every code point where the break class changes, and of the one before it, is checked as well, so a
+// wrong entry in the run tables shows up even where no case above happens to use it.
+
+static const char* const kBreakTests[] = {
+	"/ 0020 / 0020 /",
+	"/ 0020 x 0308 / 0020 /",
+	"/ 0020 / 000D /",
+	"/ 0020 x 0308 / 000D /",
+	"/ 0020 / 000A /",
+	"/ 0020 x 0308 / 000A /",
+	"/ 0020 / 0001 /",
+	"/ 0020 x 0308 / 0001 /",
+	"/ 0020 x 0300 /",
+	"/ 0020 x 0308 x 0300 /",
+	"/ 0020 x 200D /",
+	"/ 0020 x 0308 x 200D /",
+	"/ 0020 / 1F1E6 /",
+	"/ 0020 x 0308 / 1F1E6 /",
+	"/ 0020 / 0600 /",
+	"/ 0020 x 0308 / 0600 /",
+	"/ 0020 x 0903 /",
+	"/ 0020 x 0308 x 0903 /",
+	"/ 0020 / 1100 /",
+	"/ 0020 x 0308 / 1100 /",
+	"/ 0020 / 1160 /",
+	"/ 0020 x 0308 / 1160 /",
+	"/ 0020 / 11A8 /",
+	"/ 0020 x 0308 / 11A8 /",
+	"/ 0020 / AC00 /",
+	"/ 0020 x 0308 / AC00 /",
+	"/ 0020 / AC01 /",
+	"/ 0020 x 0308 / AC01 /",
+	"/ 0020 / 231A /",
+	"/ 0020 x 0308 / 231A /",
+	"/ 0020 x 094D /",
+	"/ 0020 x 0308 x 094D /",
+	"/ 0020 / 0915 /",
+	"/ 0020 x 0308 / 0915 /",
+	"/ 000D / 0020 /",
+	"/ 000D / 0308 / 0020 /",
+	"/ 000D / 000D /",
+	"/ 000D / 0308 / 000D /",
+	"/ 000D x 000A /",
+	"/ 000D / 0308 / 000A /",
+	"/ 000D / 0001 /",
+	"/ 000D / 0308 / 0001 /",
+	"/ 000D / 0300 /",
+	"/ 000D / 0308 x 0300 /",
+	"/ 000D / 200D /",
+	"/ 000D / 0308 x 200D /",
+	"/ 000D / 1F1E6 /",
+	"/ 000D / 0308 / 1F1E6 /",
+	"/ 000D / 0600 /",
+	"/ 000D / 0308 / 0600 /",
+	"/ 000D / 0903 /",
+	"/ 000D / 0308 x 0903 /",
+	"/ 000D / 1100 /",
+	"/ 000D / 0308 / 1100 /",
+	"/ 000D / 1160 /",
+	"/ 000D / 0308 / 1160 /",
+	"/ 000D / 11A8 /",
+	"/ 000D / 0308 / 11A8 /",
+	"/ 000D / AC00 /",
+	"/ 000D / 0308 / AC00 /",
+	"/ 000D / AC01 /",
+	"/ 000D / 0308 / AC01 /",
+	"/ 000D / 231A /",
+	"/ 000D / 0308 / 231A /",
+	"/ 000D / 094D /",
+	"/ 000D / 0308 x 094D /",
+	"/ 000D / 0915 /",
+	"/ 000D / 0308 / 0915 /",
+	"/ 000A / 0020 /",
+	"/ 000A / 0308 / 0020 /",
+	"/ 000A / 000D /",
+	"/ 000A / 0308 / 000D /",
+	"/ 000A / 000A /",
+	"/ 000A / 0308 / 000A /",
+	"/ 000A / 0001 /",
+	"/ 000A / 0308 / 0001 /",
+	"/ 000A / 0300 /",
+	"/ 000A / 0308 x 0300 /",
+	"/ 000A / 200D /",
+	"/ 000A / 0308 x 200D /",
+	"/ 000A / 1F1E6 /",
+	"/ 000A / 0308 / 1F1E6 /",
+	"/ 000A / 0600 /",
+	"/ 000A / 0308 / 0600 /",
+	"/ 000A / 0903 /",
+	"/ 000A / 0308 x 0903 /",
+	"/ 000A / 1100 /",
+	"/ 000A / 0308 / 1100 /",
+	"/ 000A / 1160 /",
+	"/ 000A / 0308 / 1160 /",
+	"/ 000A / 11A8 /",
+	"/ 000A / 0308 / 11A8 /",
+	"/ 000A / AC00 /",
+	"/ 000A / 0308 / AC00 /",
+	"/ 000A / AC01 /",
+	"/ 000A / 0308 / AC01 /",
+	"/ 000A / 231A /",
+	"/ 000A / 0308 / 231A /",
+	"/ 000A / 094D /",
+	"/ 000A / 0308 x 094D /",
+	"/ 000A / 0915 /",
+	"/ 000A / 0308 / 0915 /",
+	"/ 0001 / 0020 /",
+	"/ 0001 / 0308 / 0020 /",
+	"/ 0001 / 000D /",
+	"/ 0001 / 0308 / 000D /",
+	"/ 0001 / 000A /",
+	"/ 0001 / 0308 / 000A /",
+	"/ 0001 / 0001 /",
+	"/ 0001 / 0308 / 0001 /",
+	"/ 0001 / 0300 /",
+	"/ 0001 / 0308 x 0300 /",
+	"/ 0001 / 200D /",
+	"/ 0001 / 0308 x 200D /",
+	"/ 0001 / 1F1E6 /",
+	"/ 0001 / 0308 / 1F1E6 /",
+	"/ 0001 / 0600 /",
+	"/ 0001 / 0308 / 0600 /",
+	"/ 0001 / 0903 /",
+	"/ 0001 / 0308 x 0903 /",
+	"/ 0001 / 1100 /",
+	"/ 0001 / 0308 / 1100 /",
+	"/ 0001 / 1160 /",
+	"/ 0001 / 0308 / 1160 /",
+	"/ 0001 / 11A8 /",
+	"/ 0001 / 0308 / 11A8 /",
+	"/ 0001 / AC00 /",
+	"/ 0001 / 0308 / AC00 /",
+	"/ 0001 / AC01 /",
+	"/ 0001 / 0308 / AC01 /",
+	"/ 0001 / 231A /",
+	"/ 0001 / 0308 / 231A /",
+	"/ 0001 / 094D /",
+	"/ 0001 / 0308 x 094D /",
+	"/ 0001 / 0915 /",
+	"/ 0001 / 0308 / 0915 /",
+	"/ 0300 / 0020 /",
+	"/ 0300 x 0308 / 0020 /",
+	"/ 0300 / 000D /",
+	"/ 0300 x 0308 / 000D /",
+	"/ 0300 / 000A /",
+	"/ 0300 x 0308 / 000A /",
+	"/ 0300 / 0001 /",
+	"/ 0300 x 0308 / 0001 /",
+	"/ 0300 x 0300 /",
+	"/ 0300 x 0308 x 0300 /",
+	"/ 0300 x 200D /",
+	"/ 0300 x 0308 x 200D /",
+	"/ 0300 / 1F1E6 /",
+	"/ 0300 x 0308 / 1F1E6 /",
+	"/ 0300 / 0600 /",
+	"/ 0300 x 0308 / 0600 /",
+	"/ 0300 x 0903 /",
+	"/ 0300 x 0308 x 0903 /",
+	"/ 0300 / 1100 /",
+	"/ 0300 x 0308 / 1100 /",
+	"/ 0300 / 1160 /",
+	"/ 0300 x 0308 / 1160 /",
+	"/ 0300 / 11A8 /",
+	"/ 0300 x 0308 / 11A8 /",
+	"/ 0300 / AC00 /",
+	"/ 0300 x 0308 / AC00 /",
+	"/ 0300 / AC01 /",
+	"/ 0300 x 0308 / AC01 /",
+	"/ 0300 / 231A /",
+	"/ 0300 x 0308 / 231A /",
+	"/ 0300 x 094D /",
+	"/ 0300 x 0308 x 094D /",
+	"/ 0300 / 0915 /",
+	"/ 0300 x 0308 / 0915 /",
+	"/ 200D / 0020 /",
+	"/ 200D x 0308 / 0020 /",
+	"/ 200D / 000D /",
+	"/ 200D x 0308 / 000D /",
+	"/ 200D / 000A /",
+	"/ 200D x 0308 / 000A /",
+	"/ 200D / 0001 /",
+	"/ 200D x 0308 / 0001 /",
+	"/ 200D x 0300 /",
+	"/ 200D x 0308 x 0300 /",
+	"/ 200D x 200D /",
+	"/ 200D x 0308 x 200D /",
+	"/ 200D / 1F1E6 /",
+	"/ 200D x 0308 / 1F1E6 /",
+	"/ 200D / 0600 /",
+	"/ 200D x 0308 / 0600 /",
+	"/ 200D x 0903 /",
+	"/ 200D x 0308 x 0903 /",
+	"/ 200D / 1100 /",
+	"/ 200D x 0308 / 1100 /",
+	"/ 200D / 1160 /",
+	"/ 200D x 0308 / 1160 /",
+	"/ 200D / 11A8 /",
+	"/ 200D x 0308 / 11A8 /",
+	"/ 200D / AC00 /",
+	"/ 200D x 0308 / AC00 /",
+	"/ 200D / AC01 /",
+	"/ 200D x 0308 / AC01 /",
+	"/ 200D / 231A /",
+	"/ 200D x 0308 / 231A /",
+	"/ 200D x 094D /",
+	"/ 200D x 0308 x 094D /",
+	"/ 200D / 0915 /",
+	"/ 200D x 0308 / 0915 /",
+	"/ 1F1E6 / 0020 /",
+	"/ 1F1E6 x 0308 / 0020 /",
+	"/ 1F1E6 / 000D /",
+	"/ 1F1E6 x 0308 / 000D /",
+	"/ 1F1E6 / 000A /",
+	"/ 1F1E6 x 0308 / 000A /",
+	"/ 1F1E6 / 0001 /",
+	"/ 1F1E6 x 0308 / 0001 /",
+	"/ 1F1E6 x 0300 /",
+	"/ 1F1E6 x 0308 x 0300 /",
+	"/ 1F1E6 x 200D /",
+	"/ 1F1E6 x 0308 x 200D /",
+	"/ 1F1E6 x 1F1E6 /",
+	"/ 1F1E6 x 0308 / 1F1E6 /",
+	"/ 1F1E6 / 0600 /",
+	"/ 1F1E6 x 0308 / 0600 /",
+	"/ 1F1E6 x 0903 /",
+	"/ 1F1E6 x 0308 x 0903 /",
+	"/ 1F1E6 / 1100 /",
+	"/ 1F1E6 x 0308 / 1100 /",
+	"/ 1F1E6 / 1160 /",
+	"/ 1F1E6 x 0308 / 1160 /",
+	"/ 1F1E6 / 11A8 /",
+	"/ 1F1E6 x 0308 / 11A8 /",
+	"/ 1F1E6 / AC00 /",
+	"/ 1F1E6 x 0308 / AC00 /",
+	"/ 1F1E6 / AC01 /",
+	"/ 1F1E6 x 0308 / AC01 /",
+	"/ 1F1E6 / 231A /",
+	"/ 1F1E6 x 0308 / 231A /",
+	"/ 1F1E6 x 094D /",
+	"/ 1F1E6 x 0308 x 094D /",
+	"/ 1F1E6 / 0915 /",
+	"/ 1F1E6 x 0308 / 0915 /",
+	"/ 0600 x 0020 /",
+	"/ 0600 x 0308 / 0020 /",
+	"/ 0600 / 000D /",
+	"/ 0600 x 0308 / 000D /",
+	"/ 0600 / 000A /",
+	"/ 0600 x 0308 / 000A /",
+	"/ 0600 / 0001 /",
+	"/ 0600 x 0308 / 0001 /",
+	"/ 0600 x 0300 /",
+	"/ 0600 x 0308 x 0300 /",
+	"/ 0600 x 200D /",
+	"/ 0600 x 0308 x 200D /",
+	"/ 0600 x 1F1E6 /",
+	"/ 0600 x 0308 / 1F1E6 /",
+	"/ 0600 x 0600 /",
+	"/ 0600 x 0308 / 0600 /",
+	"/ 0600 x 0903 /",
+	"/ 0600 x 0308 x 0903 /",
+	"/ 0600 x 1100 /",
+	"/ 0600 x 0308 / 1100 /",
+	"/ 0600 x 1160 /",
+	"/ 0600 x 0308 / 1160 /",
+	"/ 0600 x 11A8 /",
+	"/ 0600 x 0308 / 11A8 /",
+	"/ 0600 x AC00 /",
+	"/ 0600 x 0308 / AC00 /",
+	"/ 0600 x AC01 /",
+	"/ 0600 x 0308 / AC01 /",
+	"/ 0600 x 231A /",
+	"/ 0600 x 0308 / 231A /",
+	"/ 0600 x 094D /",
+	"/ 0600 x 0308 x 094D /",
+	"/ 0600 x 0915 /",
+	"/ 0600 x 0308 / 0915 /",
+	"/ 0903 / 0020 /",
+	"/ 0903 x 0308 / 0020 /",
+	"/ 0903 / 000D /",
+	"/ 0903 x 0308 / 000D /",
+	"/ 0903 / 000A /",
+	"/ 0903 x 0308 / 000A /",
+	"/ 0903 / 0001 /",
+	"/ 0903 x 0308 / 0001 /",
+	"/ 0903 x 0300 /",
+	"/ 0903 x 0308 x 0300 /",
+	"/ 0903 x 200D /",
+	"/ 0903 x 0308 x 200D /",
+	"/ 0903 / 1F1E6 /",
+	"/ 0903 x 0308 / 1F1E6 /",
+	"/ 0903 / 0600 /",
+	"/ 0903 x 0308 / 0600 /",
+	"/ 0903 x 0903 /",
+	"/ 0903 x 0308 x 0903 /",
+	"/ 0903 / 1100 /",
+	"/ 0903 x 0308 / 1100 /",
+	"/ 0903 / 1160 /",
+	"/ 0903 x 0308 / 1160 /",
+	"/ 0903 / 11A8 /",
+	"/ 0903 x 0308 / 11A8 /",
+	"/ 0903 / AC00 /",
+	"/ 0903 x 0308 / AC00 /",
+	"/ 0903 / AC01 /",
+	"/ 0903 x 0308 / AC01 /",
+	"/ 0903 / 231A /",
+	"/ 0903 x 0308 / 231A /",
+	"/ 0903 x 094D /",
+	"/ 0903 x 0308 x 094D /",
+	"/ 0903 / 0915 /",
+	"/ 0903 x 0308 / 0915 /",
+	"/ 1100 / 0020 /",
+	"/ 1100 x 0308 / 0020 /",
+	"/ 1100 / 000D /",
+	"/ 1100 x 0308 / 000D /",
+	"/ 1100 / 000A /",
+	"/ 1100 x 0308 / 000A /",
+	"/ 1100 / 0001 /",
+	"/ 1100 x 0308 / 0001 /",
+	"/ 1100 x 0300 /",
+	"/ 1100 x 0308 x 0300 /",
+	"/ 1100 x 200D /",
+	"/ 1100 x 0308 x 200D /",
+	"/ 1100 / 1F1E6 /",
+	"/ 1100 x 0308 / 1F1E6 /",
+	"/ 1100 / 0600 /",
+	"/ 1100 x 0308 / 0600 /",
+	"/ 1100 x 0903 /",
+	"/ 1100 x 0308 x 0903 /",
+	"/ 1100 x 1100 /",
+	"/ 1100 x 0308 / 1100 /",
+	"/ 1100 x 1160 /",
+	"/ 1100 x 0308 / 1160 /",
+	"/ 1100 / 11A8 /",
+	"/ 1100 x 0308 / 11A8 /",
+	"/ 1100 x AC00 /",
+	"/ 1100 x 0308 / AC00 /",
+	"/ 1100 x AC01 /",
+	"/ 1100 x 0308 / AC01 /",
+	"/ 1100 / 231A /",
+	"/ 1100 x 0308 / 231A /",
+	"/ 1100 x 094D /",
+	"/ 1100 x 0308 x 094D /",
+	"/ 1100 / 0915 /",
+	"/ 1100 x 0308 / 0915 /",
+	"/ 1160 / 0020 /",
+	"/ 1160 x 0308 / 0020 /",
+	"/ 1160 / 000D /",
+	"/ 1160 x 0308 / 000D /",
+	"/ 1160 / 000A /",
+	"/ 1160 x 0308 / 000A /",
+	"/ 1160 / 0001 /",
+	"/ 1160 x 0308 / 0001 /",
+	"/ 1160 x 0300 /",
+	"/ 1160 x 0308 x 0300 /",
+	"/ 1160 x 200D /",
+	"/ 1160 x 0308 x 200D /",
+	"/ 1160 / 1F1E6 /",
+	"/ 1160 x 0308 / 1F1E6 /",
+	"/ 1160 / 0600 /",
+	"/ 1160 x 0308 / 0600 /",
+	"/ 1160 x 0903 /",
+	"/ 1160 x 0308 x 0903 /",
+	"/ 1160 / 1100 /",
+	"/ 1160 x 0308 / 1100 /",
+	"/ 1160 x 1160 /",
+	"/ 1160 x 0308 / 1160 /",
+	"/ 1160 x 11A8 /",
+	"/ 1160 x 0308 / 11A8 /",
+	"/ 1160 / AC00 /",
+	"/ 1160 x 0308 / AC00 /",
+	"/ 1160 / AC01 /",
+	"/ 1160 x 0308 / AC01 /",
+	"/ 1160 / 231A /",
+	"/ 1160 x 0308 / 231A /",
+	"/ 1160 x 094D /",
+	"/ 1160 x 0308 x 094D /",
+	"/ 1160 / 0915 /",
+	"/ 1160 x 0308 / 0915 /",
+	"/ 11A8 / 0020 /",
+	"/ 11A8 x 0308 / 0020 /",
+	"/ 11A8 / 000D /",
+	"/ 11A8 x 0308 / 000D /",
+	"/ 11A8 / 000A /",
+	"/ 11A8 x 0308 / 000A /",
+	"/ 11A8 / 0001 /",
+	"/ 11A8 x 0308 / 0001 /",
+	"/ 11A8 x 0300 /",
+	"/ 11A8 x 0308 x 0300 /",
+	"/ 11A8 x 200D /",
+	"/ 11A8 x 0308 x 200D /",
+	"/ 11A8 / 1F1E6 /",
+	"/ 11A8 x 0308 / 1F1E6 /",
+	"/ 11A8 / 0600 /",
+	"/ 11A8 x 0308 / 0600 /",
+	"/ 11A8 x 0903 /",
+	"/ 11A8 x 0308 x 0903 /",
+	"/ 11A8 / 1100 /",
+	"/ 11A8 x 0308 / 1100 /",
+	"/ 11A8 / 1160 /",
+	"/ 11A8 x 0308 / 1160 /",
+	"/ 11A8 x 11A8 /",
+	"/ 11A8 x 0308 / 11A8 /",
+	"/ 11A8 / AC00 /",
+	"/ 11A8 x 0308 / AC00 /",
+	"/ 11A8 / AC01 /",
+	"/ 11A8 x 0308 / AC01 /",
+	"/ 11A8 / 231A /",
+	"/ 11A8 x 0308 / 231A /",
+	"/ 11A8 x 094D /",
+	"/ 11A8 x 0308 x 094D /",
+	"/ 11A8 / 0915 /",
+	"/ 11A8 x 0308 / 0915 /",
+	"/ AC00 / 0020 /",
+	"/ AC00 x 0308 / 0020 /",
+	"/ AC00 / 000D /",
+	"/ AC00 x 0308 / 000D /",
+	"/ AC00 / 000A /",
+	"/ AC00 x 0308 / 000A /",
+	"/ AC00 / 0001 /",
+	"/ AC00 x 0308 / 0001 /",
+	"/ AC00 x 0300 /",
+	"/ AC00 x 0308 x 0300 /",
+	"/ AC00 x 200D /",
+	"/ AC00 x 0308 x 200D /",
+	"/ AC00 / 1F1E6 /",
+	"/ AC00 x 0308 / 1F1E6 /",
+	"/ AC00 / 0600 /",
+	"/ AC00 x 0308 / 0600 /",
+	"/ AC00 x 0903 /",
+	"/ AC00 x 0308 x 0903 /",
+	"/ AC00 / 1100 /",
+	"/ AC00 x 0308 / 1100 /",
+	"/ AC00 x 1160 /",
+	"/ AC00 x 0308 / 1160 /",
+	"/ AC00 x 11A8 /",
+	"/ AC00 x 0308 / 11A8 /",
+	"/ AC00 / AC00 /",
+	"/ AC00 x 0308 / AC00 /",
+	"/ AC00 / AC01 /",
+	"/ AC00 x 0308 / AC01 /",
+	"/ AC00 / 231A /",
+	"/ AC00 x 0308 / 231A /",
+	"/ AC00 x 094D /",
+	"/ AC00 x 0308 x 094D /",
+	"/ AC00 / 0915 /",
+	"/ AC00 x 0308 / 0915 /",
+	"/ AC01 / 0020 /",
+	"/ AC01 x 0308 / 0020 /",
+	"/ AC01 / 000D /",
+	"/ AC01 x 0308 / 000D /",
+	"/ AC01 / 000A /",
+	"/ AC01 x 0308 / 000A /",
+	"/ AC01 / 0001 /",
+	"/ AC01 x 0308 / 0001 /",
+	"/ AC01 x 0300 /",
+	"/ AC01 x 0308 x 0300 /",
+	"/ AC01 x 200D /",
+	"/ AC01 x 0308 x 200D /",
+	"/ AC01 / 1F1E6 /",
+	"/ AC01 x 0308 / 1F1E6 /",
+	"/ AC01 / 0600 /",
+	"/ AC01 x 0308 / 0600 /",
+	"/ AC01 x 0903 /",
+	"/ AC01 x 0308 x 0903 /",
+	"/ AC01 / 1100 /",
+	"/ AC01 x 0308 / 1100 /",
+	"/ AC01 / 1160 /",
+	"/ AC01 x 0308 / 1160 /",
+	"/ AC01 x 11A8 /",
+	"/ AC01 x 0308 / 11A8 /",
+	"/ AC01 / AC00 /",
+	"/ AC01 x 0308 / AC00 /",
+	"/ AC01 / AC01 /",
+	"/ AC01 x 0308 / AC01 /",
+	"/ AC01 / 231A /",
+	"/ AC01 x 0308 / 231A /",
+	"/ AC01 x 094D /",
+	"/ AC01 x 0308 x 094D /",
+	"/ AC01 / 0915 /",
+	"/ AC01 x 0308 / 0915 /",
+	"/ 231A / 0020 /",
+	"/ 231A x 0308 / 0020 /",
+	"/ 231A / 000D /",
+	"/ 231A x 0308 / 000D /",
+	"/ 231A / 000A /",
+	"/ 231A x 0308 / 000A /",
+	"/ 231A / 0001 /",
+	"/ 231A x 0308 / 0001 /",
+	"/ 231A x 0300 /",
+	"/ 231A x 0308 x 0300 /",
+	"/ 231A x 200D /",
+	"/ 231A x 0308 x 200D /",
+	"/ 231A / 1F1E6 /",
+	"/ 231A x 0308 / 1F1E6 /",
+	"/ 231A / 0600 /",
+	"/ 231A x 0308 / 0600 /",
+	"/ 231A x 0903 /",
+	"/ 231A x 0308 x 0903 /",
+	"/ 231A / 1100 /",
+	"/ 231A x 0308 / 1100 /",
+	"/ 231A / 1160 /",
+	"/ 231A x 0308 / 1160 /",
+	"/ 231A / 11A8 /",
+	"/ 231A x 0308 / 11A8 /",
+	"/ 231A / AC00 /",
+	"/ 231A x 0308 / AC00 /",
+	"/ 231A / AC01 /",
+	"/ 231A x 0308 / AC01 /",
+	"/ 231A / 231A /",
+	"/ 231A x 0308 / 231A /",
+	"/ 231A x 094D /",
+	"/ 231A x 0308 x 094D /",
+	"/ 231A / 0915 /",
+	"/ 231A x 0308 / 0915 /",
+	"/ 094D / 0020 /",
+	"/ 094D x 0308 / 0020 /",
+	"/ 094D / 000D /",
+	"/ 094D x 0308 / 000D /",
+	"/ 094D / 000A /",
+	"/ 094D x 0308 / 000A /",
+	"/ 094D / 0001 /",
+	"/ 094D x 0308 / 0001 /",
+	"/ 094D x 0300 /",
+	"/ 094D x 0308 x 0300 /",
+	"/ 094D x 200D /",
+	"/ 094D x 0308 x 200D /",
+	"/ 094D / 1F1E6 /",
+	"/ 094D x 0308 / 1F1E6 /",
+	"/ 094D / 0600 /",
+	"/ 094D x 0308 / 0600 /",
+	"/ 094D x 0903 /",
+	"/ 094D x 0308 x 0903 /",
+	"/ 094D / 1100 /",
+	"/ 094D x 0308 / 1100 /",
+	"/ 094D / 1160 /",
+	"/ 094D x 0308 / 1160 /",
+	"/ 094D / 11A8 /",
+	"/ 094D x 0308 / 11A8 /",
+	"/ 094D / AC00 /",
+	"/ 094D x 0308 / AC00 /",
+	"/ 094D / AC01 /",
+	"/ 094D x 0308 / AC01 /",
+	"/ 094D / 231A /",
+	"/ 094D x 0308 / 231A /",
+	"/ 094D x 094D /",
+	"/ 094D x 0308 x 094D /",
+	"/ 094D / 0915 /",
+	"/ 094D x 0308 / 0915 /",
+	"/ 0915 / 0020 /",
+	"/ 0915 x 0308 / 0020 /",
+	"/ 0915 / 000D /",
+	"/ 0915 x 0308 / 000D /",
+	"/ 0915 / 000A /",
+	"/ 0915 x 0308 / 000A /",
+	"/ 0915 / 0001 /",
+	"/ 0915 x 0308 / 0001 /",
+	"/ 0915 x 0300 /",
+	"/ 0915 x 0308 x 0300 /",
+	"/ 0915 x 200D /",
+	"/ 0915 x 0308 x 200D /",
+	"/ 0915 / 1F1E6 /",
+	"/ 0915 x 0308 / 1F1E6 /",
+	"/ 0915 / 0600 /",
+	"/ 0915 x 0308 / 0600 /",
+	"/ 0915 x 0903 /",
+	"/ 0915 x 0308 x 0903 /",
+	"/ 0915 / 1100 /",
+	"/ 0915 x 0308 / 1100 /",
+	"/ 0915 / 1160 /",
+	"/ 0915 x 0308 / 1160 /",
+	"/ 0915 / 11A8 /",
+	"/ 0915 x 0308 / 11A8 /",
+	"/ 0915 / AC00 /",
+	"/ 0915 x 0308 / AC00 /",
+	"/ 0915 / AC01 /",
+	"/ 0915 x 0308 / AC01 /",
+	"/ 0915 / 231A /",
+	"/ 0915 x 0308 / 231A /",
+	"/ 0915 x 094D /",
+	"/ 0915 x 0308 x 094D /",
+	"/ 0915 / 0915 /",
+	"/ 0915 x 0308 / 0915 /",
+
+	"/ 000D x 000A / 0061 / 000A / 0308 /",
+	"/ 0061 x 0308 /",
+	"/ 0020 x 200D / 0646 /",
+	"/ 0646 x 200D / 0020 /",
+	"/ 1100 x 1100 /",
+	"/ AC00 x 11A8 / 1100 /",
+	"/ AC01 x 11A8 / 1100 /",
+	"/ 1F1E6 x 1F1E7 / 1F1E8 / 0062 /",
+	"/ 0061 / 1F1E6 x 1F1E7 / 1F1E8 / 0062 /",
+	"/ 0061 / 1F1E6 x 1F1E7 x 200D / 1F1E8 / 0062 /",
+	"/ 0061 / 1F1E6 x 200D / 1F1E7 x 1F1E8 / 0062 /",
+	"/ 0061 / 1F1E6 x 1F1E7 / 1F1E8 x 1F1E9 / 0062 /",
+	"/ 0061 x 200D /",
+	"/ 0061 x 0308 / 0062 /",
+	"/ 0061 x 0903 / 0062 /",
+	"/ 0061 / 0600 x 0062 /",
+	"/ 1F476 x 1F3FF / 1F476 /",
+	"/ 0061 x 1F3FF / 1F476 /",
+	"/ 0061 x 1F3FF / 1F476 x 200D x 1F6D1 /",
+	"/ 1F476 x 1F3FF x 0308 x 200D x 1F476 x 1F3FF /",
+	"/ 1F6D1 x 200D x 1F6D1 /",
+	"/ 0061 x 200D / 1F6D1 /",
+	"/ 2701 x 200D x 2701 /",
+	"/ 0061 x 200D / 2701 /",
+	"/ 1F468 x 200D x 1F469 x 200D x 1F467 x 200D x 1F466 /",
+	"/ 1F3F4 x E0067 x E0062 x E0065 x E006E x E0067 x E007F /",
+	"/ 0031 x FE0F x 20E3 /",
+	"/ 2764 x FE0F x 200D x 1F525 /",
+	"/ 0915 x 094D x 0924 /",
+	"/ 0915 x 094D x 094D x 0924 /",
+	"/ 0915 x 094D x 200D x 0924 /",
+	"/ 0915 x 093C x 200D x 094D x 0924 /",
+	"/ 0915 x 093C x 094D x 200D x 0924 /",
+	"/ 0915 x 094D x 0924 x 094D x 092F /",
+	"/ 0915 x 094D / 0061 /",
+	"/ 0061 x 094D / 0924 /",
+	"/ 003F x 094D / 0924 /",
+	"/ 0915 / 0924 /",
+	"/ 0995 x 09CD x 09B7 /",
+	"/ 0915 x 094D x 0995 /",
+	"/ 0D15 x 0D4D x 0D15 /",
+	"/ 1112 x 1161 x 11AB / 1100 x 1173 x 11AF /",
+	"/ D55C / AE00 /",
+	"/ 0E01 x 0E33 /",
+	"/ 0E40 / 0E01 /",
+	"/ 0061 / 0062 / 0063 /",
+};
+
+// Break classes as Perl has them: Grapheme_Cluster_Break, with Extended_Pictographic and the Indic_Conjunct_Break
+// Linker and Consonant of Unicode 15.1 split out. Hangul syllables only at the ends of the block.
+struct ClassSample
+{
+	char32_t codePoint;
+	const char* breakClass;
+};
+
+static const ClassSample kClassSamples[] = {
+	{ 0x0000, "Control" }, { 0x0009, "Control" }, { 0x000A, "LF" }, { 0x000B, "Control" },
+	{ 0x000C, "Control" }, { 0x000D, "CR" }, { 0x000E, "Control" }, { 0x001F, "Control" },
+	{ 0x0020, "Other" }, { 0x007E, "Other" }, { 0x007F, "Control" }, { 0x009F, "Control" },
+	{ 0x00A0, "Other" }, { 0x00A8, "Other" }, { 0x00A9, "Pictographic" }, { 0x00AA, "Other" },
+	{ 0x00AC, "Other" }, { 0x00AD, "Control" }, { 0x00AE, "Pictographic" }, { 0x00AF, "Other" },
+	{ 0x02FF, "Other" }, { 0x0300, "Extend" }, { 0x036F, "Extend" }, { 0x0370, "Other" },
+	{ 0x0482, "Other" }, { 0x0483, "Extend" }, { 0x0489, "Extend" }, { 0x048A, "Other" },
+	{ 0x0590, "Other" }, { 0x0591, "Extend" }, { 0x05BD, "Extend" }, { 0x05BE, "Other" },
+	{ 0x05BF, "Extend" }, { 0x05C0, "Other" }, { 0x05C1, "Extend" }, { 0x05C2, "Extend" },
+	{ 0x05C3, "Other" }, { 0x05C4, "Extend" }, { 0x05C5, "Extend" }, { 0x05C6, "Other" },
+	{ 0x05C7, "Extend" }, { 0x05C8, "Other" }, { 0x05FF, "Other" }, { 0x0600, "Prepend" },
+	{ 0x0605, "Prepend" }, { 0x0606, "Other" }, { 0x060F, "Other" }, { 0x0610, "Extend" },
+	{ 0x061A, "Extend" }, { 0x061B, "Other" }, { 0x061C, "Control" }, { 0x061D, "Other" },
+	{ 0x064A, "Other" }, { 0x064B, "Extend" }, { 0x065F, "Extend" }, { 0x0660, "Other" },
+	{ 0x066F, "Other" }, { 0x0670, "Extend" }, { 0x0671, "Other" }, { 0x06D5, "Other" },
+	{ 0x06D6, "Extend" }, { 0x06DC, "Extend" }, { 0x06DD, "Prepend" }, { 0x06DE, "Other" },
+	{ 0x06DF, "Extend" }, { 0x06E4, "Extend" }, { 0x06E5, "Other" }, { 0x06E6, "Other" },
+	{ 0x06E7, "Extend" }, { 0x06E8, "Extend" }, { 0x06E9, "Other" }, { 0x06EA, "Extend" },
+	{ 0x06ED, "Extend" }, { 0x06EE, "Other" }, { 0x070E, "Other" }, { 0x070F, "Prepend" },
+	{ 0x0710, "Other" }, { 0x0711, "Extend" }, { 0x0712, "Other" }, { 0x072F, "Other" },
+	{ 0x0730, "Extend" }, { 0x074A, "Extend" }, { 0x074B, "Other" }, { 0x07A5, "Other" },
+	{ 0x07A6, "Extend" }, { 0x07B0, "Extend" }, { 0x07B1, "Other" }, { 0x07EA, "Other" },
+	{ 0x07EB, "Extend" }, { 0x07F3, "Extend" }, { 0x07F4, "Other" }, { 0x07FC, "Other" },
+	{ 0x07FD, "Extend" }, { 0x07FE, "Other" }, { 0x0815, "Other" }, { 0x0816, "Extend" },
+	{ 0x0819, "Extend" }, { 0x081A, "Other" }, { 0x081B, "Extend" }, { 0x0823, "Extend" },
+	{ 0x0824, "Other" }, { 0x0825, "Extend" }, { 0x0827, "Extend" }, { 0x0828, "Other" },
+	{ 0x0829, "Extend" }, { 0x082D, "Extend" }, { 0x082E, "Other" }, { 0x0858, "Other" },
+	{ 0x0859, "Extend" }, { 0x085B, "Extend" }, { 0x085C, "Other" }, { 0x088F, "Other" },
+	{ 0x0890, "Prepend" }, { 0x0891, "Prepend" }, { 0x0892, "Other" }, { 0x0897, "Other" },
+	{ 0x0898, "Extend" }, { 0x089F, "Extend" }, { 0x08A0, "Other" }, { 0x08C9, "Other" },
+	{ 0x08CA, "Extend" }, { 0x08E1, "Extend" }, { 0x08E2, "Prepend" }, { 0x08E3, "Extend" },
+	{ 0x0902, "Extend" }, { 0x0903, "SpacingMark" }, { 0x0904, "Other" }, { 0x0914, "Other" },
+	{ 0x0915, "Consonant" }, { 0x0939, "Consonant" }, { 0x093A, "Extend" }, { 0x093B, "SpacingMark" },
+	{ 0x093C, "Extend" }, { 0x093D, "Other" }, { 0x093E, "SpacingMark" }, { 0x0940, "SpacingMark" },
+	{ 0x0941, "Extend" }, { 0x0948, "Extend" }, { 0x0949, "SpacingMark" }, { 0x094C, "SpacingMark" },
+	{ 0x094D, "Linker" }, { 0x094E, "SpacingMark" }, { 0x094F, "SpacingMark" }, { 0x0950, "Other" },
+	{ 0x0951, "Extend" }, { 0x0957, "Extend" }, { 0x0958, "Consonant" }, { 0x095F, "Consonant" },
+	{ 0x0960, "Other" }, { 0x0961, "Other" }, { 0x0962, "Extend" }, { 0x0963, "Extend" },
+	{ 0x0964, "Other" }, { 0x0977, "Other" }, { 0x0978, "Consonant" }, { 0x097F, "Consonant" },
+	{ 0x0980, "Other" }, { 0x0981, "Extend" }, { 0x0982, "SpacingMark" }, { 0x0983, "SpacingMark" },
+	{ 0x0984, "Other" }, { 0x0994, "Other" }, { 0x0995, "Consonant" }, { 0x09A8, "Consonant" },
+	{ 0x09A9, "Other" }, { 0x09AA, "Consonant" }, { 0x09B0, "Consonant" }, { 0x09B1, "Other" },
+	{ 0x09B2, "Consonant" }, { 0x09B3, "Other" }, { 0x09B5, "Other" }, { 0x09B6, "Consonant" },
+	{ 0x09B9, "Consonant" }, { 0x09BA, "Other" }, { 0x09BB, "Other" }, { 0x09BC, "Extend" },
+	{ 0x09BD, "Other" }, { 0x09BE, "Extend" }, { 0x09BF, "SpacingMark" }, { 0x09C0, "SpacingMark" },
+	{ 0x09C1, "Extend" }, { 0x09C4, "Extend" }, { 0x09C5, "Other" }, { 0x09C6, "Other" },
+	{ 0x09C7, "SpacingMark" }, { 0x09C8, "SpacingMark" }, { 0x09C9, "Other" }, { 0x09CA, "Other" },
+	{ 0x09CB, "SpacingMark" }, { 0x09CC, "SpacingMark" }, { 0x09CD, "Linker" }, { 0x09CE, "Other" },
+	{ 0x09D6, "Other" }, { 0x09D7, "Extend" }, { 0x09D8, "Other" }, { 0x09DB, "Other" },
+	{ 0x09DC, "Consonant" }, { 0x09DD, "Consonant" }, { 0x09DE, "Other" }, { 0x09DF, "Consonant" },
+	{ 0x09E0, "Other" }, { 0x09E1, "Other" }, { 0x09E2, "Extend" }, { 0x09E3, "Extend" },
+	{ 0x09E4, "Other" }, { 0x09EF, "Other" }, { 0x09F0, "Consonant" }, { 0x09F1, "Consonant" },
+	{ 0x09F2, "Other" }, { 0x09FD, "Other" }, { 0x09FE, "Extend" }, { 0x09FF, "Other" },
+	{ 0x0A00, "Other" }, { 0x0A01, "Extend" }, { 0x0A02, "Extend" }, { 0x0A03, "SpacingMark" },
+	{ 0x0A04, "Other" }, { 0x0A3B, "Other" }, { 0x0A3C, "Extend" }, { 0x0A3D, "Other" },
+	{ 0x0A3E, "SpacingMark" }, { 0x0A40, "SpacingMark" }, { 0x0A41, "Extend" }, { 0x0A42, "Extend" },
+	{ 0x0A43, "Other" }, { 0x0A46, "Other" }, { 0x0A47, "Extend" }, { 0x0A48, "Extend" },
+	{ 0x0A49, "Other" }, { 0x0A4A, "Other" }, { 0x0A4B, "Extend" }, { 0x0A4D, "Extend" },
+	{ 0x0A4E, "Other" }, { 0x0A50, "Other" }, { 0x0A51, "Extend" }, { 0x0A52, "Other" },
+	{ 0x0A6F, "Other" }, { 0x0A70, "Extend" }, { 0x0A71, "Extend" }, { 0x0A72, "Other" },
+	{ 0x0A74, "Other" }, { 0x0A75, "Extend" }, { 0x0A76, "Other" }, { 0x0A80, "Other" },
+	{ 0x0A81, "Extend" }, { 0x0A82, "Extend" }, { 0x0A83, "SpacingMark" }, { 0x0A84, "Other" },
+	{ 0x0A94, "Other" }, { 0x0A95, "Consonant" }, { 0x0AA8, "Consonant" }, { 0x0AA9, "Other" },
+	{ 0x0AAA, "Consonant" }, { 0x0AB0, "Consonant" }, { 0x0AB1, "Other" }, { 0x0AB2, "Consonant" },
+	{ 0x0AB3, "Consonant" }, { 0x0AB4, "Other" }, { 0x0AB5, "Consonant" }, { 0x0AB9, "Consonant" },
+	{ 0x0ABA, "Other" }, { 0x0ABB, "Other" }, { 0x0ABC, "Extend" }, { 0x0ABD, "Other" },
+	{ 0x0ABE, "SpacingMark" }, { 0x0AC0, "SpacingMark" }, { 0x0AC1, "Extend" }, { 0x0AC5, "Extend" },
+	{ 0x0AC6, "Other" }, { 0x0AC7, "Extend" }, { 0x0AC8, "Extend" }, { 0x0AC9, "SpacingMark" },
+	{ 0x0ACA, "Other" }, { 0x0ACB, "SpacingMark" }, { 0x0ACC, "SpacingMark" }, { 0x0ACD, "Linker" },
+	{ 0x0ACE, "Other" }, { 0x0AE1, "Other" }, { 0x0AE2, "Extend" }, { 0x0AE3, "Extend" },
+	{ 0x0AE4, "Other" }, { 0x0AF8, "Other" }, { 0x0AF9, "Consonant" }, { 0x0AFA, "Extend" },
+	{ 0x0AFF, "Extend" }, { 0x0B00, "Other" }, { 0x0B01, "Extend" }, { 0x0B02, "SpacingMark" },
+	{ 0x0B03, "SpacingMark" }, { 0x0B04, "Other" }, { 0x0B14, "Other" }, { 0x0B15, "Consonant" },
+	{ 0x0B28, "Consonant" }, { 0x0B29, "Other" }, { 0x0B2A, "Consonant" }, { 0x0B30, "Consonant" },
+	{ 0x0B31, "Other" }, { 0x0B32, "Consonant" }, { 0x0B33, "Consonant" }, { 0x0B34, "Other" },
+	{ 0x0B35, "Consonant" }, { 0x0B39, "Consonant" }, { 0x0B3A, "Other" }, { 0x0B3B, "Other" },
+	{ 0x0B3C, "Extend" }, { 0x0B3D, "Other" }, { 0x0B3E, "Extend" }, { 0x0B3F, "Extend" },
+	{ 0x0B40, "SpacingMark" }, { 0x0B41, "Extend" }, { 0x0B44, "Extend" }, { 0x0B45, "Other" },
+	{ 0x0B46, "Other" }, { 0x0B47, "SpacingMark" }, { 0x0B48, "SpacingMark" }, { 0x0B49, "Other" },
+	{ 0x0B4A, "Other" }, { 0x0B4B, "SpacingMark" }, { 0x0B4C, "SpacingMark" }, { 0x0B4D, "Linker" },
+	{ 0x0B4E, "Other" }, { 0x0B54, "Other" }, { 0x0B55, "Extend" }, { 0x0B57, "Extend" },
+	{ 0x0B58, "Other" }, { 0x0B5B, "Other" }, { 0x0B5C, "Consonant" }, { 0x0B5D, "Consonant" },
+	{ 0x0B5E, "Other" }, { 0x0B5F, "Consonant" }, { 0x0B60, "Other" }, { 0x0B61, "Other" },
+	{ 0x0B62, "Extend" }, { 0x0B63, "Extend" }, { 0x0B64, "Other" }, { 0x0B70, "Other" },
+	{ 0x0B71, "Consonant" }, { 0x0B72, "Other" }, { 0x0B81, "Other" }, { 0x0B82, "Extend" },
+	{ 0x0B83, "Other" }, { 0x0BBD, "Other" }, { 0x0BBE, "Extend" }, { 0x0BBF, "SpacingMark" },
+	{ 0x0BC0, "Extend" }, { 0x0BC1, "SpacingMark" }, { 0x0BC2, "SpacingMark" }, { 0x0BC3, "Other" },
+	{ 0x0BC5, "Other" }, { 0x0BC6, "SpacingMark" }, { 0x0BC8, "SpacingMark" }, { 0x0BC9, "Other" },
+	{ 0x0BCA, "SpacingMark" }, { 0x0BCC, "SpacingMark" }, { 0x0BCD, "Extend" }, { 0x0BCE, "Other" },
+	{ 0x0BD6, "Other" }, { 0x0BD7, "Extend" }, { 0x0BD8, "Other" }, { 0x0BFF, "Other" },
+	{ 0x0C00, "Extend" }, { 0x0C01, "SpacingMark" }, { 0x0C03, "SpacingMark" }, { 0x0C04, "Extend" },
+	{ 0x0C05, "Other" }, { 0x0C14, "Other" }, { 0x0C15, "Consonant" }, { 0x0C28, "Consonant" },
+	{ 0x0C29, "Other" }, { 0x0C2A, "Consonant" }, { 0x0C39, "Consonant" }, { 0x0C3A, "Other" },
+	{ 0x0C3B, "Other" }, { 0x0C3C, "Extend" }, { 0x0C3D, "Other" }, { 0x0C3E, "Extend" },
+	{ 0x0C40, "Extend" }, { 0x0C41, "SpacingMark" }, { 0x0C44, "SpacingMark" }, { 0x0C45, "Other" },
+	{ 0x0C46, "Extend" }, { 0x0C48, "Extend" }, { 0x0C49, "Other" }, { 0x0C4A, "Extend" },
+	{ 0x0C4C, "Extend" }, { 0x0C4D, "Linker" }, { 0x0C4E, "Other" }, { 0x0C54, "Other" },
+	{ 0x0C55, "Extend" }, { 0x0C56, "Extend" }, { 0x0C57, "Other" }, { 0x0C58, "Consonant" },
+	{ 0x0C5A, "Consonant" }, { 0x0C5B, "Other" }, { 0x0C61, "Other" }, { 0x0C62, "Extend" },
+	{ 0x0C63, "Extend" }, { 0x0C64, "Other" }, { 0x0C80, "Other" }, { 0x0C81, "Extend" },
+	{ 0x0C82, "SpacingMark" }, { 0x0C83, "SpacingMark" }, { 0x0C84, "Other" }, { 0x0CBB, "Other" },
+	{ 0x0CBC, "Extend" }, { 0x0CBD, "Other" }, { 0x0CBE, "SpacingMark" }, { 0x0CBF, "Extend" },
+	{ 0x0CC0, "SpacingMark" }, { 0x0CC1, "SpacingMark" }, { 0x0CC2, "Extend" }, { 0x0CC3, "SpacingMark" },
+	{ 0x0CC4, "SpacingMark" }, { 0x0CC5, "Other" }, { 0x0CC6, "Extend" }, { 0x0CC7, "SpacingMark" },
+	{ 0x0CC8, "SpacingMark" }, { 0x0CC9, "Other" }, { 0x0CCA, "SpacingMark" }, { 0x0CCB, "SpacingMark" },
+	{ 0x0CCC, "Extend" }, { 0x0CCD, "Extend" }, { 0x0CCE, "Other" }, { 0x0CD4, "Other" },
+	{ 0x0CD5, "Extend" }, { 0x0CD6, "Extend" }, { 0x0CD7, "Other" }, { 0x0CE1, "Other" },
+	{ 0x0CE2, "Extend" }, { 0x0CE3, "Extend" }, { 0x0CE4, "Other" }, { 0x0CFF, "Other" },
+	{ 0x0D00, "Extend" }, { 0x0D01, "Extend" }, { 0x0D02, "SpacingMark" }, { 0x0D03, "SpacingMark" },
+	{ 0x0D04, "Other" }, { 0x0D14, "Other" }, { 0x0D15, "Consonant" }, { 0x0D3A, "Consonant" },
+	{ 0x0D3B, "Extend" }, { 0x0D3C, "Extend" }, { 0x0D3D, "Other" }, { 0x0D3E, "Extend" },
+	{ 0x0D3F, "SpacingMark" }, { 0x0D40, "SpacingMark" }, { 0x0D41, "Extend" }, { 0x0D44, "Extend" },
+	{ 0x0D45, "Other" }, { 0x0D46, "SpacingMark" }, { 0x0D48, "SpacingMark" }, { 0x0D49, "Other" },
+	{ 0x0D4A, "SpacingMark" }, { 0x0D4C, "SpacingMark" }, { 0x0D4D, "Linker" }, { 0x0D4E, "Prepend" },
+	{ 0x0D4F, "Other" }, { 0x0D56, "Other" }, { 0x0D57, "Extend" }, { 0x0D58, "Other" },
+	{ 0x0D61, "Other" }, { 0x0D62, "Extend" }, { 0x0D63, "Extend" }, { 0x0D64, "Other" },
+	{ 0x0D80, "Other" }, { 0x0D81, "Extend" }, { 0x0D82, "SpacingMark" }, { 0x0D83, "SpacingMark" },
+	{ 0x0D84, "Other" }, { 0x0DC9, "Other" }, { 0x0DCA, "Extend" }, { 0x0DCB, "Other" },
+	{ 0x0DCE, "Other" }, { 0x0DCF, "Extend" }, { 0x0DD0, "SpacingMark" }, { 0x0DD1, "SpacingMark" },
+	{ 0x0DD2, "Extend" }, { 0x0DD4, "Extend" }, { 0x0DD5, "Other" }, { 0x0DD6, "Extend" },
+	{ 0x0DD7, "Other" }, { 0x0DD8, "SpacingMark" }, { 0x0DDE, "SpacingMark" }, { 0x0DDF, "Extend" },
+	{ 0x0DE0, "Other" }, { 0x0DF1, "Other" }, { 0x0DF2, "SpacingMark" }, { 0x0DF3, "SpacingMark" },
+	{ 0x0DF4, "Other" }, { 0x0E30, "Other" }, { 0x0E31, "Extend" }, { 0x0E32, "Other" },
+	{ 0x0E33, "SpacingMark" }, { 0x0E34, "Extend" }, { 0x0E3A, "Extend" }, { 0x0E3B, "Other" },
+	{ 0x0E46, "Other" }, { 0x0E47, "Extend" }, { 0x0E4E, "Extend" }, { 0x0E4F, "Other" },
+	{ 0x0EB0, "Other" }, { 0x0EB1, "Extend" }, { 0x0EB2, "Other" }, { 0x0EB3, "SpacingMark" },
+	{ 0x0EB4, "Extend" }, { 0x0EBC, "Extend" }, { 0x0EBD, "Other" }, { 0x0EC7, "Other" },
+	{ 0x0EC8, "Extend" }, { 0x0ECD, "Extend" }, { 0x0ECE, "Other" }, { 0x0F17, "Other" },
+	{ 0x0F18, "Extend" }, { 0x0F19, "Extend" }, { 0x0F1A, "Other" }, { 0x0F34, "Other" },
+	{ 0x0F35, "Extend" }, { 0x0F36, "Other" }, { 0x0F37, "Extend" }, { 0x0F38, "Other" },
+	{ 0x0F39, "Extend" }, { 0x0F3A, "Other" }, { 0x0F3D, "Other" }, { 0x0F3E, "SpacingMark" },
+	{ 0x0F3F, "SpacingMark" }, { 0x0F40, "Other" }, { 0x0F70, "Other" }, { 0x0F71, "Extend" },
+	{ 0x0F7E, "Extend" }, { 0x0F7F, "SpacingMark" }, { 0x0F80, "Extend" }, { 0x0F84, "Extend" },
+	{ 0x0F85, "Other" }, { 0x0F86, "Extend" }, { 0x0F87, "Extend" }, { 0x0F88, "Other" },
+	{ 0x0F8C, "Other" }, { 0x0F8D, "Extend" }, { 0x0F97, "Extend" }, { 0x0F98, "Other" },
+	{ 0x0F99, "Extend" }, { 0x0FBC, "Extend" }, { 0x0FBD, "Other" }, { 0x0FC5, "Other" },
+	{ 0x0FC6, "Extend" }, { 0x0FC7, "Other" }, { 0x102C, "Other" }, { 0x102D, "Extend" },
+	{ 0x1030, "Extend" }, { 0x1031, "SpacingMark" }, { 0x1032, "Extend" }, { 0x1037, "Extend" },
+	{ 0x1038, "Other" }, { 0x1039, "Extend" }, { 0x103A, "Extend" }, { 0x103B, "SpacingMark" },
+	{ 0x103C, "SpacingMark" }, { 0x103D, "Extend" }, { 0x103E, "Extend" }, { 0x103F, "Other" },
+	{ 0x1055, "Other" }, { 0x1056, "SpacingMark" }, { 0x1057, "SpacingMark" }, { 0x1058, "Extend" },
+	{ 0x1059, "Extend" }, { 0x105A, "Other" }, { 0x105D, "Other" }, { 0x105E, "Extend" },
+	{ 0x1060, "Extend" }, { 0x1061, "Other" }, { 0x1070, "Other" }, { 0x1071, "Extend" },
+	{ 0x1074, "Extend" }, { 0x1075, "Other" }, { 0x1081, "Other" }, { 0x1082, "Extend" },
+	{ 0x1083, "Other" }, { 0x1084, "SpacingMark" }, { 0x1085, "Extend" }, { 0x1086, "Extend" },
+	{ 0x1087, "Other" }, { 0x108C, "Other" }, { 0x108D, "Extend" }, { 0x108E, "Other" },
+	{ 0x109C, "Other" }, { 0x109D, "Extend" }, { 0x109E, "Other" }, { 0x10FF, "Other" },
+	{ 0x1100, "L" }, { 0x115F, "L" }, { 0x1160, "V" }, { 0x11A7, "V" },
+	{ 0x11A8, "T" }, { 0x11FF, "T" }, { 0x1200, "Other" }, { 0x135C, "Other" },
+	{ 0x135D, "Extend" }, { 0x135F, "Extend" }, { 0x1360, "Other" }, { 0x1711, "Other" },
+	{ 0x1712, "Extend" }, { 0x1714, "Extend" }, { 0x1715, "SpacingMark" }, { 0x1716, "Other" },
+	{ 0x1731, "Other" }, { 0x1732, "Extend" }, { 0x1733, "Extend" }, { 0x1734, "SpacingMark" },
+	{ 0x1735, "Other" }, { 0x1751, "Other" }, { 0x1752, "Extend" }, { 0x1753, "Extend" },
+	{ 0x1754, "Other" }, { 0x1771, "Other" }, { 0x1772, "Extend" }, { 0x1773, "Extend" },
+	{ 0x1774, "Other" }, { 0x17B3, "Other" }, { 0x17B4, "Extend" }, { 0x17B5, "Extend" },
+	{ 0x17B6, "SpacingMark" }, { 0x17B7, "Extend" }, { 0x17BD, "Extend" }, { 0x17BE, "SpacingMark" },
+	{ 0x17C5, "SpacingMark" }, { 0x17C6, "Extend" }, { 0x17C7, "SpacingMark" }, { 0x17C8, "SpacingMark" },
+	{ 0x17C9, "Extend" }, { 0x17D3, "Extend" }, { 0x17D4, "Other" }, { 0x17DC, "Other" },
+	{ 0x17DD, "Extend" }, { 0x17DE, "Other" }, { 0x180A, "Other" }, { 0x180B, "Extend" },
+	{ 0x180D, "Extend" }, { 0x180E, "Control" }, { 0x180F, "Extend" }, { 0x1810, "Other" },
+	{ 0x1884, "Other" }, { 0x1885, "Extend" }, { 0x1886, "Extend" }, { 0x1887, "Other" },
+	{ 0x18A8, "Other" }, { 0x18A9, "Extend" }, { 0x18AA, "Other" }, { 0x191F, "Other" },
+	{ 0x1920, "Extend" }, { 0x1922, "Extend" }, { 0x1923, "SpacingMark" }, { 0x1926, "SpacingMark" },
+	{ 0x1927, "Extend" }, { 0x1928, "Extend" }, { 0x1929, "SpacingMark" }, { 0x192B, "SpacingMark" },
+	{ 0x192C, "Other" }, { 0x192F, "Other" }, { 0x1930, "SpacingMark" }, { 0x1931, "SpacingMark" },
+	{ 0x1932, "Extend" }, { 0x1933, "SpacingMark" }, { 0x1938, "SpacingMark" }, { 0x1939, "Extend" },
+	{ 0x193B, "Extend" }, { 0x193C, "Other" }, { 0x1A16, "Other" }, { 0x1A17, "Extend" },
+	{ 0x1A18, "Extend" }, { 0x1A19, "SpacingMark" }, { 0x1A1A, "SpacingMark" }, { 0x1A1B, "Extend" },
+	{ 0x1A1C, "Other" }, { 0x1A54, "Other" }, { 0x1A55, "SpacingMark" }, { 0x1A56, "Extend" },
+	{ 0x1A57, "SpacingMark" }, { 0x1A58, "Extend" }, { 0x1A5E, "Extend" }, { 0x1A5F, "Other" },
+	{ 0x1A60, "Extend" }, { 0x1A61, "Other" }, { 0x1A62, "Extend" }, { 0x1A63, "Other" },
+	{ 0x1A64, "Other" }, { 0x1A65, "Extend" }, { 0x1A6C, "Extend" }, { 0x1A6D, "SpacingMark" },
+	{ 0x1A72, "SpacingMark" }, { 0x1A73, "Extend" }, { 0x1A7C, "Extend" }, { 0x1A7D, "Other" },
+	{ 0x1A7E, "Other" }, { 0x1A7F, "Extend" }, { 0x1A80, "Other" }, { 0x1AAF, "Other" },
+	{ 0x1AB0, "Extend" }, { 0x1ACE, "Extend" }, { 0x1ACF, "Other" }, { 0x1AFF, "Other" },
+	{ 0x1B00, "Extend" }, { 0x1B03, "Extend" }, { 0x1B04, "SpacingMark" }, { 0x1B05, "Other" },
+	{ 0x1B33, "Other" }, { 0x1B34, "Extend" }, { 0x1B3A, "Extend" }, { 0x1B3B, "SpacingMark" },
+	{ 0x1B3C, "Extend" }, { 0x1B3D, "SpacingMark" }, { 0x1B41, "SpacingMark" }, { 0x1B42, "Extend" },
+	{ 0x1B43, "SpacingMark" }, { 0x1B44, "SpacingMark" }, { 0x1B45, "Other" }, { 0x1B6A, "Other" },
+	{ 0x1B6B, "Extend" }, { 0x1B73, "Extend" }, { 0x1B74, "Other" }, { 0x1B7F, "Other" },
+	{ 0x1B80, "Extend" }, { 0x1B81, "Extend" }, { 0x1B82, "SpacingMark" }, { 0x1B83, "Other" },
+	{ 0x1BA0, "Other" }, { 0x1BA1, "SpacingMark" }, { 0x1BA2, "Extend" }, { 0x1BA5, "Extend" },
+	{ 0x1BA6, "SpacingMark" }, { 0x1BA7, "SpacingMark" }, { 0x1BA8, "Extend" }, { 0x1BA9, "Extend" },
+	{ 0x1BAA, "SpacingMark" }, { 0x1BAB, "Extend" }, { 0x1BAD, "Extend" }, { 0x1BAE, "Other" },
+	{ 0x1BE5, "Other" }, { 0x1BE6, "Extend" }, { 0x1BE7, "SpacingMark" }, { 0x1BE8, "Extend" },
+	{ 0x1BE9, "Extend" }, { 0x1BEA, "SpacingMark" }, { 0x1BEC, "SpacingMark" }, { 0x1BED, "Extend" },
+	{ 0x1BEE, "SpacingMark" }, { 0x1BEF, "Extend" }, { 0x1BF1, "Extend" }, { 0x1BF2, "SpacingMark" },
+	{ 0x1BF3, "SpacingMark" }, { 0x1BF4, "Other" }, { 0x1C23, "Other" }, { 0x1C24, "SpacingMark" },
+	{ 0x1C2B, "SpacingMark" }, { 0x1C2C, "Extend" }, { 0x1C33, "Extend" }, { 0x1C34, "SpacingMark" },
+	{ 0x1C35, "SpacingMark" }, { 0x1C36, "Extend" }, { 0x1C37, "Extend" }, { 0x1C38, "Other" },
+	{ 0x1CCF, "Other" }, { 0x1CD0, "Extend" }, { 0x1CD2, "Extend" }, { 0x1CD3, "Other" },
+	{ 0x1CD4, "Extend" }, { 0x1CE0, "Extend" }, { 0x1CE1, "SpacingMark" }, { 0x1CE2, "Extend" },
+	{ 0x1CE8, "Extend" }, { 0x1CE9, "Other" }, { 0x1CEC, "Other" }, { 0x1CED, "Extend" },
+	{ 0x1CEE, "Other" }, { 0x1CF3, "Other" }, { 0x1CF4, "Extend" }, { 0x1CF5, "Other" },
+	{ 0x1CF6, "Other" }, { 0x1CF7, "SpacingMark" }, { 0x1CF8, "Extend" }, { 0x1CF9, "Extend" },
+	{ 0x1CFA, "Other" }, { 0x1DBF, "Other" }, { 0x1DC0, "Extend" }, { 0x1DFF, "Extend" },
+	{ 0x1E00, "Other" }, { 0x200A, "Other" }, { 0x200B, "Control" }, { 0x200C, "Extend" },
+	{ 0x200D, "ZWJ" }, { 0x200E, "Control" }, { 0x200F, "Control" }, { 0x2010, "Other" },
+	{ 0x2027, "Other" }, { 0x2028, "Control" }, { 0x202E, "Control" }, { 0x202F, "Other" },
+	{ 0x203B, "Other" }, { 0x203C, "Pictographic" }, { 0x203D, "Other" }, { 0x2048, "Other" },
+	{ 0x2049, "Pictographic" }, { 0x204A, "Other" }, { 0x205F, "Other" }, { 0x2060, "Control" },
+	{ 0x206F, "Control" }, { 0x2070, "Other" }, { 0x20CF, "Other" }, { 0x20D0, "Extend" },
+	{ 0x20F0, "Extend" }, { 0x20F1, "Other" }, { 0x2121, "Other" }, { 0x2122, "Pictographic" },
+	{ 0x2123, "Other" }, { 0x2138, "Other" }, { 0x2139, "Pictographic" }, { 0x213A, "Other" },
+	{ 0x2193, "Other" }, { 0x2194, "Pictographic" }, { 0x2199, "Pictographic" }, { 0x219A, "Other" },
+	{ 0x21A8, "Other" }, { 0x21A9, "Pictographic" }, { 0x21AA, "Pictographic" }, { 0x21AB, "Other" },
+	{ 0x2319, "Other" }, { 0x231A, "Pictographic" }, { 0x231B, "Pictographic" }, { 0x231C, "Other" },
+	{ 0x2327, "Other" }, { 0x2328, "Pictographic" }, { 0x2329, "Other" }, { 0x2387, "Other" },
+	{ 0x2388, "Pictographic" }, { 0x2389, "Other" }, { 0x23CE, "Other" }, { 0x23CF, "Pictographic" },
+	{ 0x23D0, "Other" }, { 0x23E8, "Other" }, { 0x23E9, "Pictographic" }, { 0x23F3, "Pictographic" },
+	{ 0x23F4, "Other" }, { 0x23F7, "Other" }, { 0x23F8, "Pictographic" }, { 0x23FA, "Pictographic" },
+	{ 0x23FB, "Other" }, { 0x24C1, "Other" }, { 0x24C2, "Pictographic" }, { 0x24C3, "Other" },
+	{ 0x25A9, "Other" }, { 0x25AA, "Pictographic" }, { 0x25AB, "Pictographic" }, { 0x25AC, "Other" },
+	{ 0x25B5, "Other" }, { 0x25B6, "Pictographic" }, { 0x25B7, "Other" }, { 0x25BF, "Other" },
+	{ 0x25C0, "Pictographic" }, { 0x25C1, "Other" }, { 0x25FA, "Other" }, { 0x25FB, "Pictographic" },
+	{ 0x25FE, "Pictographic" }, { 0x25FF, "Other" }, { 0x2600, "Pictographic" }, { 0x2605, "Pictographic" },
+	{ 0x2606, "Other" }, { 0x2607, "Pictographic" }, { 0x2612, "Pictographic" }, { 0x2613, "Other" },
+	{ 0x2614, "Pictographic" }, { 0x2685, "Pictographic" }, { 0x2686, "Other" }, { 0x268F, "Other" },
+	{ 0x2690, "Pictographic" }, { 0x2705, "Pictographic" }, { 0x2706, "Other" }, { 0x2707, "Other" },
+	{ 0x2708, "Pictographic" }, { 0x2712, "Pictographic" }, { 0x2713, "Other" }, { 0x2714, "Pictographic" },
+	{ 0x2715, "Other" }, { 0x2716, "Pictographic" }, { 0x2717, "Other" }, { 0x271C, "Other" },
+	{ 0x271D, "Pictographic" }, { 0x271E, "Other" }, { 0x2720, "Other" }, { 0x2721, "Pictographic" },
+	{ 0x2722, "Other" }, { 0x2727, "Other" }, { 0x2728, "Pictographic" }, { 0x2729, "Other" },
+	{ 0x2732, "Other" }, { 0x2733, "Pictographic" }, { 0x2734, "Pictographic" }, { 0x2735, "Other" },
+	{ 0x2743, "Other" }, { 0x2744, "Pictographic" }, { 0x2745, "Other" }, { 0x2746, "Other" },
+	{ 0x2747, "Pictographic" }, { 0x2748, "Other" }, { 0x274B, "Other" }, { 0x274C, "Pictographic" },
+	{ 0x274D, "Other" }, { 0x274E, "Pictographic" }, { 0x274F, "Other" }, { 0x2752, "Other" },
+	{ 0x2753, "Pictographic" }, { 0x2755, "Pictographic" }, { 0x2756, "Other" }, { 0x2757, "Pictographic" },
+	{ 0x2758, "Other" }, { 0x2762, "Other" }, { 0x2763, "Pictographic" }, { 0x2767, "Pictographic" },
+	{ 0x2768, "Other" }, { 0x2794, "Other" }, { 0x2795, "Pictographic" }, { 0x2797, "Pictographic" },
+	{ 0x2798, "Other" }, { 0x27A0, "Other" }, { 0x27A1, "Pictographic" }, { 0x27A2, "Other" },
+	{ 0x27AF, "Other" }, { 0x27B0, "Pictographic" }, { 0x27B1, "Other" }, { 0x27BE, "Other" },
+	{ 0x27BF, "Pictographic" }, { 0x27C0, "Other" }, { 0x2933, "Other" }, { 0x2934, "Pictographic" },
+	{ 0x2935, "Pictographic" }, { 0x2936, "Other" }, { 0x2B04, "Other" }, { 0x2B05, "Pictographic" },
+	{ 0x2B07, "Pictographic" }, { 0x2B08, "Other" }, { 0x2B1A, "Other" }, { 0x2B1B, "Pictographic" },
+	{ 0x2B1C, "Pictographic" }, { 0x2B1D, "Other" }, { 0x2B4F, "Other" }, { 0x2B50, "Pictographic" },
+	{ 0x2B51, "Other" }, { 0x2B54, "Other" }, { 0x2B55, "Pictographic" }, { 0x2B56, "Other" },
+	{ 0x2CEE, "Other" }, { 0x2CEF, "Extend" }, { 0x2CF1, "Extend" }, { 0x2CF2, "Other" },
+	{ 0x2D7E, "Other" }, { 0x2D7F, "Extend" }, { 0x2D80, "Other" }, { 0x2DDF, "Other" },
+	{ 0x2DE0, "Extend" }, { 0x2DFF, "Extend" }, { 0x2E00, "Other" }, { 0x3029, "Other" },
+	{ 0x302A, "Extend" }, { 0x302F, "Extend" }, { 0x3030, "Pictographic" }, { 0x3031, "Other" },
+	{ 0x303C, "Other" }, { 0x303D, "Pictographic" }, { 0x303E, "Other" }, { 0x3098, "Other" },
+	{ 0x3099, "Extend" }, { 0x309A, "Extend" }, { 0x309B, "Other" }, { 0x3296, "Other" },
+	{ 0x3297, "Pictographic" }, { 0x3298, "Other" }, { 0x3299, "Pictographic" }, { 0x329A, "Other" },
+	{ 0xA66E, "Other" }, { 0xA66F, "Extend" }, { 0xA672, "Extend" }, { 0xA673, "Other" },
+	{ 0xA674, "Extend" }, { 0xA67D, "Extend" }, { 0xA67E, "Other" }, { 0xA69D, "Other" },
+	{ 0xA69E, "Extend" }, { 0xA69F, "Extend" }, { 0xA6A0, "Other" }, { 0xA6EF, "Other" },
+	{ 0xA6F0, "Extend" }, { 0xA6F1, "Extend" }, { 0xA6F2, "Other" }, { 0xA801, "Other" },
+	{ 0xA802, "Extend" }, { 0xA803, "Other" }, { 0xA805, "Other" }, { 0xA806, "Extend" },
+	{ 0xA807, "Other" }, { 0xA80A, "Other" }, { 0xA80B, "Extend" }, { 0xA80C, "Other" },
+	{ 0xA822, "Other" }, { 0xA823, "SpacingMark" }, { 0xA824, "SpacingMark" }, { 0xA825, "Extend" },
+	{ 0xA826, "Extend" }, { 0xA827, "SpacingMark" }, { 0xA828, "Other" }, { 0xA82B, "Other" },
+	{ 0xA82C, "Extend" }, { 0xA82D, "Other" }, { 0xA87F, "Other" }, { 0xA880, "SpacingMark" },
+	{ 0xA881, "SpacingMark" }, { 0xA882, "Other" }, { 0xA8B3, "Other" }, { 0xA8B4, "SpacingMark" },
+	{ 0xA8C3, "SpacingMark" }, { 0xA8C4, "Extend" }, { 0xA8C5, "Extend" }, { 0xA8C6, "Other" },
+	{ 0xA8DF, "Other" }, { 0xA8E0, "Extend" }, { 0xA8F1, "Extend" }, { 0xA8F2, "Other" },
+	{ 0xA8FE, "Other" }, { 0xA8FF, "Extend" }, { 0xA900, "Other" }, { 0xA925, "Other" },
+	{ 0xA926, "Extend" }, { 0xA92D, "Extend" }, { 0xA92E, "Other" }, { 0xA946, "Other" },
+	{ 0xA947, "Extend" }, { 0xA951, "Extend" }, { 0xA952, "SpacingMark" }, { 0xA953, "SpacingMark" },
+	{ 0xA954, "Other" }, { 0xA95F, "Other" }, { 0xA960, "L" }, { 0xA97C, "L" },
+	{ 0xA97D, "Other" }, { 0xA97F, "Other" }, { 0xA980, "Extend" }, { 0xA982, "Extend" },
+	{ 0xA983, "SpacingMark" }, { 0xA984, "Other" }, { 0xA9B2, "Other" }, { 0xA9B3, "Extend" },
+	{ 0xA9B4, "SpacingMark" }, { 0xA9B5, "SpacingMark" }, { 0xA9B6, "Extend" }, { 0xA9B9, "Extend" },
+	{ 0xA9BA, "SpacingMark" }, { 0xA9BB, "SpacingMark" }, { 0xA9BC, "Extend" }, { 0xA9BD, "Extend" },
+	{ 0xA9BE, "SpacingMark" }, { 0xA9C0, "SpacingMark" }, { 0xA9C1, "Other" }, { 0xA9E4, "Other" },
+	{ 0xA9E5, "Extend" }, { 0xA9E6, "Other" }, { 0xAA28, "Other" }, { 0xAA29, "Extend" },
+	{ 0xAA2E, "Extend" }, { 0xAA2F, "SpacingMark" }, { 0xAA30, "SpacingMark" }, { 0xAA31, "Extend" },
+	{ 0xAA32, "Extend" }, { 0xAA33, "SpacingMark" }, { 0xAA34, "SpacingMark" }, { 0xAA35, "Extend" },
+	{ 0xAA36, "Extend" }, { 0xAA37, "Other" }, { 0xAA42, "Other" }, { 0xAA43, "Extend" },
+	{ 0xAA44, "Other" }, { 0xAA4B, "Other" }, { 0xAA4C, "Extend" }, { 0xAA4D, "SpacingMark" },
+	{ 0xAA4E, "Other" }, { 0xAA7B, "Other" }, { 0xAA7C, "Extend" }, { 0xAA7D, "Other" },
+	{ 0xAAAF, "Other" }, { 0xAAB0, "Extend" }, { 0xAAB1, "Other" }, { 0xAAB2, "Extend" },
+	{ 0xAAB4, "Extend" }, { 0xAAB5, "Other" }, { 0xAAB6, "Other" }, { 0xAAB7, "Extend" },
+	{ 0xAAB8, "Extend" }, { 0xAAB9, "Other" }, { 0xAABD, "Other" }, { 0xAABE, "Extend" },
+	{ 0xAABF, "Extend" }, { 0xAAC0, "Other" }, { 0xAAC1, "Extend" }, { 0xAAC2, "Other" },
+	{ 0xAAEA, "Other" }, { 0xAAEB, "SpacingMark" }, { 0xAAEC, "Extend" }, { 0xAAED, "Extend" },
+	{ 0xAAEE, "SpacingMark" }, { 0xAAEF, "SpacingMark" }, { 0xAAF0, "Other" }, { 0xAAF4, "Other" },
+	{ 0xAAF5, "SpacingMark" }, { 0xAAF6, "Extend" }, { 0xAAF7, "Other" }, { 0xABE2, "Other" },
+	{ 0xABE3, "SpacingMark" }, { 0xABE4, "SpacingMark" }, { 0xABE5, "Extend" }, { 0xABE6, "SpacingMark" },
+	{ 0xABE7, "SpacingMark" }, { 0xABE8, "Extend" }, { 0xABE9, "SpacingMark" }, { 0xABEA, "SpacingMark" },
+	{ 0xABEB, "Other" }, { 0xABEC, "SpacingMark" }, { 0xABED, "Extend" }, { 0xABEE, "Other" },
+	{ 0xABFF, "Other" }, { 0xAC00, "LV" }, { 0xAC01, "LVT" }, { 0xAC1B, "LVT" },
+	{ 0xAC1C, "LV" }, { 0xAC1D, "LVT" }, { 0xAC37, "LVT" }, { 0xAC38, "LV" },
+	{ 0xAC39, "LVT" }, { 0xD787, "LVT" }, { 0xD788, "LV" }, { 0xD789, "LVT" },
+	{ 0xD7A3, "LVT" }, { 0xD7A4, "Other" }, { 0xD7AF, "Other" }, { 0xD7B0, "V" },
+	{ 0xD7C6, "V" }, { 0xD7C7, "Other" }, { 0xD7CA, "Other" }, { 0xD7CB, "T" },
+	{ 0xD7FB, "T" }, { 0xD7FC, "Other" }, { 0xFB1D, "Other" }, { 0xFB1E, "Extend" },
+	{ 0xFB1F, "Other" }, { 0xFDFF, "Other" }, { 0xFE00, "Extend" }, { 0xFE0F, "Extend" },
+	{ 0xFE10, "Other" }, { 0xFE1F, "Other" }, { 0xFE20, "Extend" }, { 0xFE2F, "Extend" },
+	{ 0xFE30, "Other" }, { 0xFEFE, "Other" }, { 0xFEFF, "Control" }, { 0xFF00, "Other" },
+	{ 0xFF9D, "Other" }, { 0xFF9E, "Extend" }, { 0xFF9F, "Extend" }, { 0xFFA0, "Other" },
+	{ 0xFFEF, "Other" }, { 0xFFF0, "Control" }, { 0xFFFB, "Control" }, { 0xFFFC, "Other" },
+	{ 0x101FC, "Other" }, { 0x101FD, "Extend" }, { 0x101FE, "Other" }, { 0x102DF, "Other" },
+	{ 0x102E0, "Extend" }, { 0x102E1, "Other" }, { 0x10375, "Other" }, { 0x10376, "Extend" },
+	{ 0x1037A, "Extend" }, { 0x1037B, "Other" }, { 0x10A00, "Other" }, { 0x10A01, "Extend" },
+	{ 0x10A03, "Extend" }, { 0x10A04, "Other" }, { 0x10A05, "Extend" }, { 0x10A06, "Extend" },
+	{ 0x10A07, "Other" }, { 0x10A0B, "Other" }, { 0x10A0C, "Extend" }, { 0x10A0F, "Extend" },
+	{ 0x10A10, "Other" }, { 0x10A37, "Other" }, { 0x10A38, "Extend" }, { 0x10A3A, "Extend" },
+	{ 0x10A3B, "Other" }, { 0x10A3E, "Other" }, { 0x10A3F, "Extend" }, { 0x10A40, "Other" },
+	{ 0x10AE4, "Other" }, { 0x10AE5, "Extend" }, { 0x10AE6, "Extend" }, { 0x10AE7, "Other" },
+	{ 0x10D23, "Other" }, { 0x10D24, "Extend" }, { 0x10D27, "Extend" }, { 0x10D28, "Other" },
+	{ 0x10EAA, "Other" }, { 0x10EAB, "Extend" }, { 0x10EAC, "Extend" }, { 0x10EAD, "Other" },
+	{ 0x10F45, "Other" }, { 0x10F46, "Extend" }, { 0x10F50, "Extend" }, { 0x10F51, "Other" },
+	{ 0x10F81, "Other" }, { 0x10F82, "Extend" }, { 0x10F85, "Extend" }, { 0x10F86, "Other" },
+	{ 0x10FFF, "Other" }, { 0x11000, "SpacingMark" }, { 0x11001, "Extend" }, { 0x11002, "SpacingMark" },
+	{ 0x11003, "Other" }, { 0x11037, "Other" }, { 0x11038, "Extend" }, { 0x11046, "Extend" },
+	{ 0x11047, "Other" }, { 0x1106F, "Other" }, { 0x11070, "Extend" }, { 0x11071, "Other" },
+	{ 0x11072, "Other" }, { 0x11073, "Extend" }, { 0x11074, "Extend" }, { 0x11075, "Other" },
+	{ 0x1107E, "Other" }, { 0x1107F, "Extend" }, { 0x11081, "Extend" }, { 0x11082, "SpacingMark" },
+	{ 0x11083, "Other" }, { 0x110AF, "Other" }, { 0x110B0, "SpacingMark" }, { 0x110B2, "SpacingMark" },
+	{ 0x110B3, "Extend" }, { 0x110B6, "Extend" }, { 0x110B7, "SpacingMark" }, { 0x110B8, "SpacingMark" },
+	{ 0x110B9, "Extend" }, { 0x110BA, "Extend" }, { 0x110BB, "Other" }, { 0x110BC, "Other" },
+	{ 0x110BD, "Prepend" }, { 0x110BE, "Other" }, { 0x110C1, "Other" }, { 0x110C2, "Extend" },
+	{ 0x110C3, "Other" }, { 0x110CC, "Other" }, { 0x110CD, "Prepend" }, { 0x110CE, "Other" },
+	{ 0x110FF, "Other" }, { 0x11100, "Extend" }, { 0x11102, "Extend" }, { 0x11103, "Other" },
+	{ 0x11126, "Other" }, { 0x11127, "Extend" }, { 0x1112B, "Extend" }, { 0x1112C, "SpacingMark" },
+	{ 0x1112D, "Extend" }, { 0x11134, "Extend" }, { 0x11135, "Other" }, { 0x11144, "Other" },
+	{ 0x11145, "SpacingMark" }, { 0x11146, "SpacingMark" }, { 0x11147, "Other" }, { 0x11172, "Other" },
+	{ 0x11173, "Extend" }, { 0x11174, "Other" }, { 0x1117F, "Other" }, { 0x11180, "Extend" },
+	{ 0x11181, "Extend" }, { 0x11182, "SpacingMark" }, { 0x11183, "Other" }, { 0x111B2, "Other" },
+	{ 0x111B3, "SpacingMark" }, { 0x111B5, "SpacingMark" }, { 0x111B6, "Extend" }, { 0x111BE, "Extend" },
+	{ 0x111BF, "SpacingMark" }, { 0x111C0, "SpacingMark" }, { 0x111C1, "Other" }, { 0x111C2, "Prepend" },
+	{ 0x111C3, "Prepend" }, { 0x111C4, "Other" }, { 0x111C8, "Other" }, { 0x111C9, "Extend" },
+	{ 0x111CC, "Extend" }, { 0x111CD, "Other" }, { 0x111CE, "SpacingMark" }, { 0x111CF, "Extend" },
+	{ 0x111D0, "Other" }, { 0x1122B, "Other" }, { 0x1122C, "SpacingMark" }, { 0x1122E, "SpacingMark" },
+	{ 0x1122F, "Extend" }, { 0x11231, "Extend" }, { 0x11232, "SpacingMark" }, { 0x11233, "SpacingMark" },
+	{ 0x11234, "Extend" }, { 0x11235, "SpacingMark" }, { 0x11236, "Extend" }, { 0x11237, "Extend" },
+	{ 0x11238, "Other" }, { 0x1123D, "Other" }, { 0x1123E, "Extend" }, { 0x1123F, "Other" },
+	{ 0x112DE, "Other" }, { 0x112DF, "Extend" }, { 0x112E0, "SpacingMark" }, { 0x112E2, "SpacingMark" },
+	{ 0x112E3, "Extend" }, { 0x112EA, "Extend" }, { 0x112EB, "Other" }, { 0x112FF, "Other" },
+	{ 0x11300, "Extend" }, { 0x11301, "Extend" }, { 0x11302, "SpacingMark" }, { 0x11303, "SpacingMark" },
+	{ 0x11304, "Other" }, { 0x1133A, "Other" }, { 0x1133B, "Extend" }, { 0x1133C, "Extend" },
+	{ 0x1133D, "Other" }, { 0x1133E, "Extend" }, { 0x1133F, "SpacingMark" }, { 0x11340, "Extend" },
+	{ 0x11341, "SpacingMark" }, { 0x11344, "SpacingMark" }, { 0x11345, "Other" }, { 0x11346, "Other" },
+	{ 0x11347, "SpacingMark" }, { 0x11348, "SpacingMark" }, { 0x11349, "Other" }, { 0x1134A, "Other" },
+	{ 0x1134B, "SpacingMark" }, { 0x1134D, "SpacingMark" }, { 0x1134E, "Other" }, { 0x11356, "Other" },
+	{ 0x11357, "Extend" }, { 0x11358, "Other" }, { 0x11361, "Other" }, { 0x11362, "SpacingMark" },
+	{ 0x11363, "SpacingMark" }, { 0x11364, "Other" }, { 0x11365, "Other" }, { 0x11366, "Extend" },
+	{ 0x1136C, "Extend" }, { 0x1136D, "Other" }, { 0x1136F, "Other" }, { 0x11370, "Extend" },
+	{ 0x11374, "Extend" }, { 0x11375, "Other" }, { 0x11434, "Other" }, { 0x11435, "SpacingMark" },
+	{ 0x11437, "SpacingMark" }, { 0x11438, "Extend" }, { 0x1143F, "Extend" }, { 0x11440, "SpacingMark" },
+	{ 0x11441, "SpacingMark" }, { 0x11442, "Extend" }, { 0x11444, "Extend" }, { 0x11445, "SpacingMark" },
+	{ 0x11446, "Extend" }, { 0x11447, "Other" }, { 0x1145D, "Other" }, { 0x1145E, "Extend" },
+	{ 0x1145F, "Other" }, { 0x114AF, "Other" }, { 0x114B0, "Extend" }, { 0x114B1, "SpacingMark" },
+	{ 0x114B2, "SpacingMark" }, { 0x114B3, "Extend" }, { 0x114B8, "Extend" }, { 0x114B9, "SpacingMark" },
+	{ 0x114BA, "Extend" }, { 0x114BB, "SpacingMark" }, { 0x114BC, "SpacingMark" }, { 0x114BD, "Extend" },
+	{ 0x114BE, "SpacingMark" }, { 0x114BF, "Extend" }, { 0x114C0, "Extend" }, { 0x114C1, "SpacingMark" },
+	{ 0x114C2, "Extend" }, { 0x114C3, "Extend" }, { 0x114C4, "Other" }, { 0x115AE, "Other" },
+	{ 0x115AF, "Extend" }, { 0x115B0, "SpacingMark" }, { 0x115B1, "SpacingMark" }, { 0x115B2, "Extend" },
+	{ 0x115B5, "Extend" }, { 0x115B6, "Other" }, { 0x115B7, "Other" }, { 0x115B8, "SpacingMark" },
+	{ 0x115BB, "SpacingMark" }, { 0x115BC, "Extend" }, { 0x115BD, "Extend" }, { 0x115BE, "SpacingMark" },
+	{ 0x115BF, "Extend" }, { 0x115C0, "Extend" }, { 0x115C1, "Other" }, { 0x115DB, "Other" },
+	{ 0x115DC, "Extend" }, { 0x115DD, "Extend" }, { 0x115DE, "Other" }, { 0x1162F, "Other" },
+	{ 0x11630, "SpacingMark" }, { 0x11632, "SpacingMark" }, { 0x11633, "Extend" }, { 0x1163A, "Extend" },
+	{ 0x1163B, "SpacingMark" }, { 0x1163C, "SpacingMark" }, { 0x1163D, "Extend" }, { 0x1163E, "SpacingMark" },
+	{ 0x1163F, "Extend" }, { 0x11640, "Extend" }, { 0x11641, "Other" }, { 0x116AA, "Other" },
+	{ 0x116AB, "Extend" }, { 0x116AC, "SpacingMark" }, { 0x116AD, "Extend" }, { 0x116AE, "SpacingMark" },
+	{ 0x116AF, "SpacingMark" }, { 0x116B0, "Extend" }, { 0x116B5, "Extend" }, { 0x116B6, "SpacingMark" },
+	{ 0x116B7, "Extend" }, { 0x116B8, "Other" }, { 0x1171C, "Other" }, { 0x1171D, "Extend" },
+	{ 0x1171F, "Extend" }, { 0x11720, "Other" }, { 0x11721, "Other" }, { 0x11722, "Extend" },
+	{ 0x11725, "Extend" }, { 0x11726, "SpacingMark" }, { 0x11727, "Extend" }, { 0x1172B, "Extend" },
+	{ 0x1172C, "Other" }, { 0x1182B, "Other" }, { 0x1182C, "SpacingMark" }, { 0x1182E, "SpacingMark" },
+	{ 0x1182F, "Extend" }, { 0x11837, "Extend" }, { 0x11838, "SpacingMark" }, { 0x11839, "Extend" },
+	{ 0x1183A, "Extend" }, { 0x1183B, "Other" }, { 0x1192F, "Other" }, { 0x11930, "Extend" },
+	{ 0x11931, "SpacingMark" }, { 0x11935, "SpacingMark" }, { 0x11936, "Other" }, { 0x11937, "SpacingMark" },
+	{ 0x11938, "SpacingMark" }, { 0x11939, "Other" }, { 0x1193A, "Other" }, { 0x1193B, "Extend" },
+	{ 0x1193C, "Extend" }, { 0x1193D, "SpacingMark" }, { 0x1193E, "Extend" }, { 0x1193F, "Prepend" },
+	{ 0x11940, "SpacingMark" }, { 0x11941, "Prepend" }, { 0x11942, "SpacingMark" }, { 0x11943, "Extend" },
+	{ 0x11944, "Other" }, { 0x119D0, "Other" }, { 0x119D1, "SpacingMark" }, { 0x119D3, "SpacingMark" },
+	{ 0x119D4, "Extend" }, { 0x119D7, "Extend" }, { 0x119D8, "Other" }, { 0x119D9, "Other" },
+	{ 0x119DA, "Extend" }, { 0x119DB, "Extend" }, { 0x119DC, "SpacingMark" }, { 0x119DF, "SpacingMark" },
+	{ 0x119E0, "Extend" }, { 0x119E1, "Other" }, { 0x119E3, "Other" }, { 0x119E4, "SpacingMark" },
+	{ 0x119E5, "Other" }, { 0x11A00, "Other" }, { 0x11A01, "Extend" }, { 0x11A0A, "Extend" },
+	{ 0x11A0B, "Other" }, { 0x11A32, "Other" }, { 0x11A33, "Extend" }, { 0x11A38, "Extend" },
+	{ 0x11A39, "SpacingMark" }, { 0x11A3A, "Prepend" }, { 0x11A3B, "Extend" }, { 0x11A3E, "Extend" },
+	{ 0x11A3F, "Other" }, { 0x11A46, "Other" }, { 0x11A47, "Extend" }, { 0x11A48, "Other" },
+	{ 0x11A50, "Other" }, { 0x11A51, "Extend" }, { 0x11A56, "Extend" }, { 0x11A57, "SpacingMark" },
+	{ 0x11A58, "SpacingMark" }, { 0x11A59, "Extend" }, { 0x11A5B, "Extend" }, { 0x11A5C, "Other" },
+	{ 0x11A83, "Other" }, { 0x11A84, "Prepend" }, { 0x11A89, "Prepend" }, { 0x11A8A, "Extend" },
+	{ 0x11A96, "Extend" }, { 0x11A97, "SpacingMark" }, { 0x11A98, "Extend" }, { 0x11A99, "Extend" },
+	{ 0x11A9A, "Other" }, { 0x11C2E, "Other" }, { 0x11C2F, "SpacingMark" }, { 0x11C30, "Extend" },
+	{ 0x11C36, "Extend" }, { 0x11C37, "Other" }, { 0x11C38, "Extend" }, { 0x11C3D, "Extend" },
+	{ 0x11C3E, "SpacingMark" }, { 0x11C3F, "Extend" }, { 0x11C40, "Other" }, { 0x11C91, "Other" },
+	{ 0x11C92, "Extend" }, { 0x11CA7, "Extend" }, { 0x11CA8, "Other" }, { 0x11CA9, "SpacingMark" },
+	{ 0x11CAA, "Extend" }, { 0x11CB0, "Extend" }, { 0x11CB1, "SpacingMark" }, { 0x11CB2, "Extend" },
+	{ 0x11CB3, "Extend" }, { 0x11CB4, "SpacingMark" }, { 0x11CB5, "Extend" }, { 0x11CB6, "Extend" },
+	{ 0x11CB7, "Other" }, { 0x11D30, "Other" }, { 0x11D31, "Extend" }, { 0x11D36, "Extend" },
+	{ 0x11D37, "Other" }, { 0x11D39, "Other" }, { 0x11D3A, "Extend" }, { 0x11D3B, "Other" },
+	{ 0x11D3C, "Extend" }, { 0x11D3D, "Extend" }, { 0x11D3E, "Other" }, { 0x11D3F, "Extend" },
+	{ 0x11D45, "Extend" }, { 0x11D46, "Prepend" }, { 0x11D47, "Extend" }, { 0x11D48, "Other" },
+	{ 0x11D89, "Other" }, { 0x11D8A, "SpacingMark" }, { 0x11D8E, "SpacingMark" }, { 0x11D8F, "Other" },
+	{ 0x11D90, "Extend" }, { 0x11D91, "Extend" }, { 0x11D92, "Other" }, { 0x11D93, "SpacingMark" },
+	{ 0x11D94, "SpacingMark" }, { 0x11D95, "Extend" }, { 0x11D96, "SpacingMark" }, { 0x11D97, "Extend" },
+	{ 0x11D98, "Other" }, { 0x11EF2, "Other" }, { 0x11EF3, "Extend" }, { 0x11EF4, "Extend" },
+	{ 0x11EF5, "SpacingMark" }, { 0x11EF6, "SpacingMark" }, { 0x11EF7, "Other" }, { 0x1342F, "Other" },
+	{ 0x13430, "Control" }, { 0x13438, "Control" }, { 0x13439, "Other" }, { 0x16AEF, "Other" },
+	{ 0x16AF0, "Extend" }, { 0x16AF4, "Extend" }, { 0x16AF5, "Other" }, { 0x16B2F, "Other" },
+	{ 0x16B30, "Extend" }, { 0x16B36, "Extend" }, { 0x16B37, "Other" }, { 0x16F4E, "Other" },
+	{ 0x16F4F, "Extend" }, { 0x16F50, "Other" }, { 0x16F51, "SpacingMark" }, { 0x16F87, "SpacingMark" },
+	{ 0x16F88, "Other" }, { 0x16F8E, "Other" }, { 0x16F8F, "Extend" }, { 0x16F92, "Extend" },
+	{ 0x16F93, "Other" }, { 0x16FE3, "Other" }, { 0x16FE4, "Extend" }, { 0x16FE5, "Other" },
+	{ 0x16FEF, "Other" }, { 0x16FF0, "SpacingMark" }, { 0x16FF1, "SpacingMark" }, { 0x16FF2, "Other" },
+	{ 0x1BC9C, "Other" }, { 0x1BC9D, "Extend" }, { 0x1BC9E, "Extend" }, { 0x1BC9F, "Other" },
+	{ 0x1BCA0, "Control" }, { 0x1BCA3, "Control" }, { 0x1BCA4, "Other" }, { 0x1CEFF, "Other" },
+	{ 0x1CF00, "Extend" }, { 0x1CF2D, "Extend" }, { 0x1CF2E, "Other" }, { 0x1CF2F, "Other" },
+	{ 0x1CF30, "Extend" }, { 0x1CF46, "Extend" }, { 0x1CF47, "Other" }, { 0x1D164, "Other" },
+	{ 0x1D165, "Extend" }, { 0x1D166, "SpacingMark" }, { 0x1D167, "Extend" }, { 0x1D169, "Extend" },
+	{ 0x1D16A, "Other" }, { 0x1D16C, "Other" }, { 0x1D16D, "SpacingMark" }, { 0x1D16E, "Extend" },
+	{ 0x1D172, "Extend" }, { 0x1D173, "Control" }, { 0x1D17A, "Control" }, { 0x1D17B, "Extend" },
+	{ 0x1D182, "Extend" }, { 0x1D183, "Other" }, { 0x1D184, "Other" }, { 0x1D185, "Extend" },
+	{ 0x1D18B, "Extend" }, { 0x1D18C, "Other" }, { 0x1D1A9, "Other" }, { 0x1D1AA, "Extend" },
+	{ 0x1D1AD, "Extend" }, { 0x1D1AE, "Other" }, { 0x1D241, "Other" }, { 0x1D242, "Extend" },
+	{ 0x1D244, "Extend" }, { 0x1D245, "Other" }, { 0x1D9FF, "Other" }, { 0x1DA00, "Extend" },
+	{ 0x1DA36, "Extend" }, { 0x1DA37, "Other" }, { 0x1DA3A, "Other" }, { 0x1DA3B, "Extend" },
+	{ 0x1DA6C, "Extend" }, { 0x1DA6D, "Other" }, { 0x1DA74, "Other" }, { 0x1DA75, "Extend" },
+	{ 0x1DA76, "Other" }, { 0x1DA83, "Other" }, { 0x1DA84, "Extend" }, { 0x1DA85, "Other" },
+	{ 0x1DA9A, "Other" }, { 0x1DA9B, "Extend" }, { 0x1DA9F, "Extend" }, { 0x1DAA0, "Other" },
+	{ 0x1DAA1, "Extend" }, { 0x1DAAF, "Extend" }, { 0x1DAB0, "Other" }, { 0x1DFFF, "Other" },
+	{ 0x1E000, "Extend" }, { 0x1E006, "Extend" }, { 0x1E007, "Other" }, { 0x1E008, "Extend" },
+	{ 0x1E018, "Extend" }, { 0x1E019, "Other" }, { 0x1E01A, "Other" }, { 0x1E01B, "Extend" },
+	{ 0x1E021, "Extend" }, { 0x1E022, "Other" }, { 0x1E023, "Extend" }, { 0x1E024, "Extend" },
+	{ 0x1E025, "Other" }, { 0x1E026, "Extend" }, { 0x1E02A, "Extend" }, { 0x1E02B, "Other" },
+	{ 0x1E12F, "Other" }, { 0x1E130, "Extend" }, { 0x1E136, "Extend" }, { 0x1E137, "Other" },
+	{ 0x1E2AD, "Other" }, { 0x1E2AE, "Extend" }, { 0x1E2AF, "Other" }, { 0x1E2EB, "Other" },
+	{ 0x1E2EC, "Extend" }, { 0x1E2EF, "Extend" }, { 0x1E2F0, "Other" }, { 0x1E8CF, "Other" },
+	{ 0x1E8D0, "Extend" }, { 0x1E8D6, "Extend" }, { 0x1E8D7, "Other" }, { 0x1E943, "Other" },
+	{ 0x1E944, "Extend" }, { 0x1E94A, "Extend" }, { 0x1E94B, "Other" }, { 0x1EFFF, "Other" },
+	{ 0x1F000, "Pictographic" }, { 0x1F0FF, "Pictographic" }, { 0x1F100, "Other" }, { 0x1F10C, "Other" },
+	{ 0x1F10D, "Pictographic" }, { 0x1F10F, "Pictographic" }, { 0x1F110, "Other" }, { 0x1F12E, "Other" },
+	{ 0x1F12F, "Pictographic" }, { 0x1F130, "Other" }, { 0x1F16B, "Other" }, { 0x1F16C, "Pictographic" },
+	{ 0x1F171, "Pictographic" }, { 0x1F172, "Other" }, { 0x1F17D, "Other" }, { 0x1F17E, "Pictographic" },
+	{ 0x1F17F, "Pictographic" }, { 0x1F180, "Other" }, { 0x1F18D, "Other" }, { 0x1F18E, "Pictographic" },
+	{ 0x1F18F, "Other" }, { 0x1F190, "Other" }, { 0x1F191, "Pictographic" }, { 0x1F19A, "Pictographic" },
+	{ 0x1F19B, "Other" }, { 0x1F1AC, "Other" }, { 0x1F1AD, "Pictographic" }, { 0x1F1E5, "Pictographic" },
+	{ 0x1F1E6, "RegionalIndicator" }, { 0x1F1FF, "RegionalIndicator" }, { 0x1F200, "Other" }, { 0x1F201, "Pictographic" },
+	{ 0x1F20F, "Pictographic" }, { 0x1F210, "Other" }, { 0x1F219, "Other" }, { 0x1F21A, "Pictographic" },
+	{ 0x1F21B, "Other" }, { 0x1F22E, "Other" }, { 0x1F22F, "Pictographic" }, { 0x1F230, "Other" },
+	{ 0x1F231, "Other" }, { 0x1F232, "Pictographic" }, { 0x1F23A, "Pictographic" }, { 0x1F23B, "Other" },
+	{ 0x1F23C, "Pictographic" }, { 0x1F23F, "Pictographic" }, { 0x1F240, "Other" }, { 0x1F248, "Other" },
+	{ 0x1F249, "Pictographic" }, { 0x1F3FA, "Pictographic" }, { 0x1F3FB, "Extend" }, { 0x1F3FF, "Extend" },
+	{ 0x1F400, "Pictographic" }, { 0x1F53D, "Pictographic" }, { 0x1F53E, "Other" }, { 0x1F545, "Other" },
+	{ 0x1F546, "Pictographic" }, { 0x1F64F, "Pictographic" }, { 0x1F650, "Other" }, { 0x1F67F, "Other" },
+	{ 0x1F680, "Pictographic" }, { 0x1F6FF, "Pictographic" }, { 0x1F700, "Other" }, { 0x1F773, "Other" },
+	{ 0x1F774, "Pictographic" }, { 0x1F77F, "Pictographic" }, { 0x1F780, "Other" }, { 0x1F7D4, "Other" },
+	{ 0x1F7D5, "Pictographic" }, { 0x1F7FF, "Pictographic" }, { 0x1F800, "Other" }, { 0x1F80B, "Other" },
+	{ 0x1F80C, "Pictographic" }, { 0x1F80F, "Pictographic" }, { 0x1F810, "Other" }, { 0x1F847, "Other" },
+	{ 0x1F848, "Pictographic" }, { 0x1F84F, "Pictographic" }, { 0x1F850, "Other" }, { 0x1F859, "Other" },
+	{ 0x1F85A, "Pictographic" }, { 0x1F85F, "Pictographic" }, { 0x1F860, "Other" }, { 0x1F887, "Other" },
+	{ 0x1F888, "Pictographic" }, { 0x1F88F, "Pictographic" }, { 0x1F890, "Other" }, { 0x1F8AD, "Other" },
+	{ 0x1F8AE, "Pictographic" }, { 0x1F8FF, "Pictographic" }, { 0x1F900, "Other" }, { 0x1F90B, "Other" },
+	{ 0x1F90C, "Pictographic" }, { 0x1F93A, "Pictographic" }, { 0x1F93B, "Other" }, { 0x1F93C, "Pictographic" },
+	{ 0x1F945, "Pictographic" }, { 0x1F946, "Other" }, { 0x1F947, "Pictographic" }, { 0x1FAFF, "Pictographic" },
+	{ 0x1FB00, "Other" }, { 0x1FBFF, "Other" }, { 0x1FC00, "Pictographic" }, { 0x1FFFD, "Pictographic" },
+	{ 0x1FFFE, "Other" }, { 0xDFFFF, "Other" }, { 0xE0000, "Control" }, { 0xE001F, "Control" },
+	{ 0xE0020, "Extend" }, { 0xE007F, "Extend" }, { 0xE0080, "Control" }, { 0xE00FF, "Control" },
+	{ 0xE0100, "Extend" }, { 0xE01EF, "Extend" }, { 0xE01F0, "Control" }, { 0xE0FFF, "Control" },
+	{ 0xE1000, "Other" }, { 0x10FFFF, "Other" },
+};
+
+static int sFailures = 0;
+
+static void Check(bool inOk, const std::string& inWhat)
+{
+	std::printf("%s: %s\n", inOk ? "ok" : "FAILED", inWhat.c_str());
+	if (!inOk) {
+		++sFailures;
+	}
+}
+
+static void AppendUTF8(std::string& ioText, char32_t inCodePoint)
+{
+	if (inCodePoint < 0x80) {
+		ioText += static_cast<char>(inCodePoint);
+	}
+	else if (inCodePoint < 0x800) {
+		ioText += static_cast<char>(0xC0 | (inCodePoint >> 6));
+		ioText += static_cast<char>(0x80 | (inCodePoint & 0x3F));
+	}
+	else if (inCodePoint < 0x10000) {
+		ioText += static_cast<char>(0xE0 | (inCodePoint >> 12));
+		ioText += static_cast<char>(0x80 | ((inCodePoint >> 6) & 0x3F));
+		ioText += static_cast<char>(0x80 | (inCodePoint & 0x3F));
+	}
+	else {
+		ioText += static_cast<char>(0xF0 | (inCodePoint >> 18));
+		ioText += static_cast<char>(0x80 | ((inCodePoint >> 12) & 0x3F));
+		ioText += static_cast<char>(0x80 | ((inCodePoint >> 6) & 0x3F));
+		ioText += static_cast<char>(0x80 | (inCodePoint & 0x3F));
+	}
+}
+
+// The cluster offsets IndexGraphemes finds in inText, with the one at the end
+static std::vector<uint32_t> ClusterOffsets(const std::string& inText)
+{
+	std::vector<Grapheme> graphemes;
+	IndexGraphemes(inText, graphemes);
+	std::vector<uint32_t> offsets;
+	for (const auto& grapheme : graphemes) {
+		offsets.push_back(grapheme.offset);
+	}
+	return offsets;
+}
+
+static void CheckBreakTests()
+{
+	size_t failed = 0;
+	for (auto test : kBreakTests) {
+		// Every code point is followed by / or x. A break after the last one is the end of the text.
+		std::string text;
+		std::vector<uint32_t> expected = { 0 };
+		for (const char* token = std::strchr(test, ' '); token != nullptr; token = std::strchr(token + 1, ' ')) {
+			char* end;
+			auto codePoint = static_cast<char32_t>(std::strtoul(token + 1, &end, 16));
+			AppendUTF8(text, codePoint);
+			if (end[1] == '/') {
+				expected.push_back(static_cast<uint32_t>(text.size()));
+			}
+			token = std::strchr(token + 1, ' ');
+		}
+
+		if (ClusterOffsets(text) != expected) {
+			if (++failed <= 20) {
+				Check(false, std::string("break test ") + test);
+			}
+		}
+	}
+	Check(failed == 0, std::to_string(failed) + " of " + std::to_string(sizeof(kBreakTests) / sizeof(kBreakTests[0])) + " break tests failed");
+}
+
+// Whether the last of inCodePoints starts a cluster of its own
+static bool Joins(std::initializer_list<char32_t> inCodePoints)
+{
+	std::string text;
+	size_t last = 0;
+	for (auto codePoint : inCodePoints) {
+		last = text.size();
+		AppendUTF8(text, codePoint);
+	}
+	auto offsets = ClusterOffsets(text);
+	return std::find(offsets.begin(), offsets.end(), last) == offsets.end();
+}
+
+// Works out the break class of a code point from how it clusters with samples of the others
+static const char* ObservedClass(char32_t inCodePoint)
+{
+	auto c = inCodePoint;
+	if (Joins({ c, 0x000A })) return "CR";
+	if (Joins({ 0x000D, c })) return "LF";
+	if (!Joins({ c, 0x0308 })) return "Control";
+	if (Joins({ 0x0061, c })) {
+		if (Joins({ 0x1F476, c, 0x1F476 })) return "ZWJ";
+		if (Joins({ 0x0915, c, 0x0915 })) return "Linker";
+		if (Joins({ 0x1F476, c, 0x200D, 0x1F476 })) return "Extend";
+		return "SpacingMark";
+	}
+	if (Joins({ c, 0x0061 })) return "Prepend";
+
+	bool afterL = Joins({ 0x1100, c });
+	bool beforeV = Joins({ c, 0x1160 });
+	bool beforeT = Joins({ c, 0x11A8 });
+	if (afterL && beforeV) return !beforeT ? "L" : Joins({ 0xAC00, c }) ? "V" : "LV";
+	if (afterL && beforeT) return "LVT";
+	if (beforeT) return "T";
+
+	if (Joins({ 0x1F1E6, c })) return "RegionalIndicator";
+	if (Joins({ 0x1F476, 0x200D, c })) return "Pictographic";
+	if (Joins({ 0x0915, 0x094D, c })) return "Consonant";
+	return "Other";
+}
+
+static void CheckClasses()
+{
+	size_t failed = 0;
+	for (const auto& sample : kClassSamples) {
+		auto observed = ObservedClass(sample.codePoint);
+		if (std::strcmp(observed, sample.breakClass) != 0) {
+			if (++failed <= 20) {
+				char what[96];
+				std::snprintf(what, sizeof(what), "U+%04X is %s, expected %s", static_cast<unsigned>(sample.codePoint), observed, sample.breakClass);
+				Check(false, what);
+			}
+		}
+	}
+	Check(failed == 0, std::to_string(failed) + " of " + std::to_string(sizeof(kClassSamples) / sizeof(kClassSamples[0])) + " break classes wrong");
+}
+
+static void CheckRepair()
+{
+	struct Case
+	{
+		const char* name;
+		std::string text;
+		std::string repaired;
+	};
+	const Case cases[] = {
+		{ "valid text is left alone", "Caf\xC3\xA9 \xF0\x9F\x8E\xB5", "Caf\xC3\xA9 \xF0\x9F\x8E\xB5" },
+		{ "empty", "", "" },
+		{ "stray byte", "a\xFF" "b", "a\xEF\xBF\xBD" "b" },
+		{ "truncated at the end", "a\xE2\x82", "a\xEF\xBF\xBD\xEF\xBF\xBD" },
+		{ "overlong form", "\xC0\xAF", "\xEF\xBF\xBD\xEF\xBF\xBD" },
+		{ "encoded surrogate", "\xED\xA0\x80" "a", "\xEF\xBF\xBD\xEF\xBF\xBD\xEF\xBF\xBD" "a" },
+		{ "past U+10FFFF", "\xF4\x90\x80\x80", "\xEF\xBF\xBD\xEF\xBF\xBD\xEF\xBF\xBD\xEF\xBF\xBD" },
+		{ "valid text after a repair is kept", "\x80\xE2\x82\xAC", "\xEF\xBF\xBD\xE2\x82\xAC" },
+	};
+	for (const auto& test : cases) {
+		auto text = test.text;
+		RepairUTF8(text);
+		Check(text == test.repaired, std::string("repair: ") + test.name);
+	}
+
+	// Each bad byte is a cluster of its own, read as U+FFFD
+	std::vector<Grapheme> graphemes;
+	IndexGraphemes("a\xFF\x80\xCC\x88", graphemes);
+	Check(graphemes.size() == 4 && graphemes[1].offset == 1 && graphemes[1].base == 0xFFFD && graphemes[2].offset == 2 && graphemes[2].base == 0xFFFD,
+		"repair: invalid bytes index as U+FFFD clusters");
+}
+
+int main()
+{
+	CheckBreakTests();
+	CheckClasses();
+	CheckRepair();
+
+	std::printf("%d failure(s)\n", sFailures);
+	return sFailures == 0 ? 0 : 1;
+}
@@ -0,0 +1,237 @@
+//==============================================================================
+/**
+@file       MarqueeFramesTest.cpp
+
+@brief      Title font lookup, glyph advances and the frames each scroll mode cuts from a title
+
+@copyright  (c) 2021, bionyx187
+			This source code is licensed under the MIT-style license found in the LICENSE file.
+
+**/
+//==============================================================================
+
+#include "../FontMetrics.h"
+#include "../Graphemes.h"
+#include "../MarqueeFrames.h"
+
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+// Courier at 12 pixels is 7.2 pixels a character, spaces included, so exactly 10 fit in kKeyTitleWidth and the frame
+// counts below can be worked out by hand. The keys tick 4 times a second.
+
+static const int kSize = 12;
+static const int kCourierAdvance = 600 * kSize;	// thousandths of a pixel
+static const size_t kCourierFit = 10;
+static const std::chrono::milliseconds kPeriod{ 250 };
+
+static int sFailures = 0;
+
+static void Check(bool inOk, const std::string& inWhat)
+{
+	std::printf("%s: %s\n", inOk ? "ok" : "FAILED", inWhat.c_str());
+	if (!inOk) {
+		++sFailures;
+	}
+}
+
+static MarqueeFrames BuildFrames(const std::string& inTitle, const TitleFont& inFont, ScrollMode inMode)
+{
+	std::vector<Grapheme> graphemes;
+	IndexGraphemes(inTitle, graphemes);
+	return MarqueeFrames(inTitle, graphemes, inFont, inMode, kPeriod);
+}
+
+static void CheckLookup()
+{
+	auto times = LookupTitleFont("Times New Roman", "Bold", 14);
+	Check(times.face == FontFace::SerifBold && times.scalePercent == 100 && times.size == 14 && times.IsKnown(),
+		"lookup: Times New Roman Bold has its own table");
+
+	auto georgia = LookupTitleFont("Georgia", "Regular", kSize);
+	Check(georgia.face == FontFace::Serif && georgia.scalePercent == 110, "lookup: Georgia is Times scaled up");
+
+	auto black = LookupTitleFont("Arial Black", "Regular", kSize);
+	Check(black.face == FontFace::SansBold && black.scalePercent == 120, "lookup: Arial Black is bold whatever the style");
+
+	auto courier = LookupTitleFont("Courier New", "Bold Italic", kSize);
+	Check(courier.face == FontFace::Mono && courier.scalePercent == 100, "lookup: Courier New is monospaced in any style");
+
+	auto unknown = LookupTitleFont("Wingdings", "Regular", kSize);
+	Check(unknown == LookupTitleFont("Arial", "Regular", kSize), "lookup: an unknown family is measured as Arial");
+	auto unknownBold = LookupTitleFont("Wingdings", "Bold", kSize);
+	Check(unknownBold == LookupTitleFont("Arial", "Bold", kSize), "lookup: an unknown bold family is measured as Arial Bold");
+
+	Check(!LookupTitleFont("Arial", "Regular", 0).IsKnown(), "lookup: size 0 isn't known");
+	Check(!LookupTitleFont("Arial", "Regular", -3).IsKnown(), "lookup: a negative size isn't known");
+	Check(LookupTitleFont("Arial", "Regular", 0) == TitleFont{ FontFace::Sans, 100, 0 }, "lookup: size 0 is clamped to 0");
+}
+
+static void CheckAdvances()
+{
+	auto arial = LookupTitleFont("Arial", "Regular", kSize);
+	auto courier = LookupTitleFont("Courier New", "Regular", kSize);
+	auto georgia = LookupTitleFont("Georgia", "Regular", kSize);
+
+	Check(GlyphAdvance(arial, U'A') == 667 * kSize, "advance: Arial A");
+	Check(GlyphAdvance(arial, U'i') == 222 * kSize, "advance: Arial i");
+	Check(GlyphAdvance(arial, U' ') == 278 * kSize, "advance: Arial space");
+	Check(GlyphAdvance(courier, U'i') == kCourierAdvance && GlyphAdvance(courier, U'W') == kCourierAdvance, "advance: Courier is monospaced");
+	Check(GlyphAdvance(georgia, U'n') == 500 * kSize * 110 / 100, "advance: Georgia is scaled from Times");
+	Check(GlyphAdvance(arial, U'\u00E9') == GlyphAdvance(arial, U'n'), "advance: a letter outside the table is measured like n");
+
+	Check(GlyphAdvance(arial, U'\u4E00') == 1000 * kSize, "advance: a CJK ideograph is an em");
+	Check(GlyphAdvance(arial, U'\U0001F3B5') == 1000 * kSize, "advance: an emoji is an em");
+	Check(GlyphAdvance(courier, U'\u4E00') == 2 * kCourierAdvance, "advance: a wide character is two cells in Courier");
+
+	Check(GlyphAdvance(arial, U'\u0301') == 0, "advance: a combining mark is 0");
+	Check(GlyphAdvance(arial, U'\u200D') == 0, "advance: ZWJ is 0");
+	Check(GlyphAdvance(arial, U'\uFE0F') == 0, "advance: a variation selector is 0");
+
+	// A cluster is measured by its base, and an emoji presentation selector makes it wide
+	std::vector<Grapheme> graphemes;
+	IndexGraphemes("e\xCC\x81\xE2\x9D\xA4\xEF\xB8\x8F", graphemes); // e, U+0301, U+2764 U+FE0F
+	Check(graphemes.size() == 3, "advance: e with an accent and a red heart are two clusters");
+	if (graphemes.size() == 3) {
+		Check(GlyphAdvance(arial, graphemes[0]) == GlyphAdvance(arial, U'e'), "advance: an accented e is as wide as e");
+		Check(GlyphAdvance(arial, graphemes[1]) == 1000 * kSize, "advance: a heart with VS16 is an em");
+	}
+
+	Check(GlyphAdvance(LookupTitleFont("Arial", "Regular", 0), U'n') == 0, "advance: nothing is measured in an unknown font");
+}
+
+static void CheckFit()
+{
+	auto courier = LookupTitleFont("Courier New", "Regular", kSize);
+	auto arial = LookupTitleFont("Arial", "Regular", kSize);
+	const ScrollMode modes[] = { ScrollMode::Marquee, ScrollMode::Bounce, ScrollMode::PageFlip, ScrollMode::Ellipsis };
+
+	// 10 Courier characters, and 6 wide ones in Arial, are exactly kKeyTitleWidth
+	const std::string exact[] = { "0123456789", "\xE6\x97\xA5\xE6\x9C\xAC\xE8\xAA\x9E\xE3\x81\xAE\xE6\xAD\x8C\xE8\xA9\x9E" };
+	const TitleFont exactFonts[] = { courier, arial };
+	for (size_t i = 0; i < 2; ++i) {
+		for (auto mode : modes) {
+			auto frames = BuildFrames(exact[i], exactFonts[i], mode);
+			Check(frames.IsStatic() && frames.Frame(0) == exact[i], "fit: an exact fit is one static frame, mode " + std::to_string(static_cast<int>(mode)));
+		}
+	}
+
+	// One character more doesn't fit
+	const std::string over[] = { "0123456789a", exact[1] + "a" };
+	for (size_t i = 0; i < 2; ++i) {
+		for (auto mode : modes) {
+			auto frames = BuildFrames(over[i], exactFonts[i], mode);
+			bool scrolls = mode == ScrollMode::Ellipsis ? frames.Frame(0) != over[i] : !frames.IsStatic();
+			Check(scrolls, "fit: one character over doesn't fit, mode " + std::to_string(static_cast<int>(mode)));
+		}
+	}
+
+	Check(BuildFrames("Title", LookupTitleFont("Arial", "Regular", 0), ScrollMode::Marquee).FrameCount() == 0,
+		"fit: no frames before the font is known");
+	Check(BuildFrames("", courier, ScrollMode::Marquee).FrameCount() == 0, "fit: no frames for an empty title");
+}
+
+static void CheckModes()
+{
+	auto courier = LookupTitleFont("Courier New", "Regular", kSize);
+	const std::string title = "Hello wonderful world";
+	const size_t count = title.size();
+
+	// A key's width of spaces on either side, and a frame for every start from the first space to the first frame of
+	// trailing spaces
+	auto marquee = BuildFrames(title, courier, ScrollMode::Marquee);
+	size_t padding = (kKeyTitleWidth * 1000 + kCourierAdvance - 1) / kCourierAdvance;
+	Check(padding == kCourierFit && marquee.FrameCount() == padding + count + 1, "marquee: one frame per cluster plus padding");
+	Check(marquee.Frame(0) == std::string(kCourierFit, ' '), "marquee: starts blank");
+	Check(marquee.Frame(padding) == "Hello wond", "marquee: shows the start of the title after the padding");
+	Check(marquee.Frame(marquee.FrameCount() - 1) == std::string(kCourierFit, ' '), "marquee: ends blank");
+
+	// Starts 0 to 11 show the title, so it slides 11 steps each way and dwells at both ends
+	auto bounce = BuildFrames(title, courier, ScrollMode::Bounce);
+	auto bounceDwell = MarqueeFrames::Dwell(ScrollMode::Bounce, kPeriod);
+	size_t last = count - kCourierFit;
+	Check(bounce.FrameCount() == 2 * bounceDwell + 2 * (last - 1), "bounce: dwells at each end and slides between");
+	Check(bounce.Frame(0) == "Hello wond" && bounce.Frame(bounceDwell - 1) == "Hello wond", "bounce: holds the start");
+	Check(bounce.Frame(bounceDwell + last - 1) == "rful world", "bounce: reaches the end");
+	Check(bounce.Frame(bounce.FrameCount() - 1) == "ello wonde", "bounce: stops one step short of the start");
+
+	// No two of the words fit together
+	auto pages = BuildFrames(title, courier, ScrollMode::PageFlip);
+	auto pageDwell = MarqueeFrames::Dwell(ScrollMode::PageFlip, kPeriod);
+	Check(pages.FrameCount() == 3 * pageDwell, "page: three pages, each held");
+	Check(pages.Frame(0) == "Hello" && pages.Frame(pageDwell) == "wonderful" && pages.Frame(2 * pageDwell) == "world",
+		"page: one word a page");
+
+	// A word longer than the key is cut where it fills one
+	auto cut = BuildFrames("Supercalifragilistic ok", courier, ScrollMode::PageFlip);
+	Check(cut.FrameCount() == 3 * pageDwell && cut.Frame(0) == "Supercalif" && cut.Frame(pageDwell) == "ragilistic"
+		&& cut.Frame(2 * pageDwell) == "ok", "page: a long word is cut into pages");
+
+	// The ellipsis is a Courier cell, leaving room for 9 characters
+	auto ellipsis = BuildFrames(title, courier, ScrollMode::Ellipsis);
+	Check(ellipsis.IsStatic() && ellipsis.Frame(0) == "Hello won\xE2\x80\xA6", "ellipsis: as much as fits with the ellipsis");
+	auto trimmed = BuildFrames("Hello my wonderful world", courier, ScrollMode::Ellipsis);
+	Check(trimmed.Frame(0) == "Hello my\xE2\x80\xA6", "ellipsis: no space before the ellipsis");
+
+	// At 60 pixels a wide character is the whole key, so nothing fits beside the ellipsis, but the first cluster stays
+	auto big = BuildFrames("\xE4\xB8\x80\xE4\xBA\x8C", LookupTitleFont("Courier New", "Regular", 60), ScrollMode::Ellipsis);
+	Check(big.IsStatic() && big.Frame(0) == "\xE4\xB8\x80\xE2\x80\xA6", "ellipsis: keeps a first cluster wider than the key");
+
+	Check(ParseScrollMode("bounce") == ScrollMode::Bounce && ParseScrollMode("page") == ScrollMode::PageFlip
+		&& ParseScrollMode("ellipsis") == ScrollMode::Ellipsis && ParseScrollMode("marquee") == ScrollMode::Marquee
+		&& ParseScrollMode("sideways") == ScrollMode::Marquee, "modes: parsed by name, Marquee otherwise");
+}
+
+static void CheckDwell()
+{
+	using std::chrono::milliseconds;
+	Check(MarqueeFrames::Dwell(ScrollMode::PageFlip, kPeriod) == 6 && MarqueeFrames::Dwell(ScrollMode::Bounce, kPeriod) == 4,
+		"dwell: 1.5 s a page and 1 s an end at 250 ms");
+	Check(MarqueeFrames::Dwell(ScrollMode::PageFlip, milliseconds(100)) == 15 && MarqueeFrames::Dwell(ScrollMode::Bounce, milliseconds(100)) == 10,
+		"dwell: the same time in more ticks at 100 ms");
+	Check(MarqueeFrames::Dwell(ScrollMode::PageFlip, milliseconds(400)) == 4, "dwell: rounded to the nearest tick");
+	Check(MarqueeFrames::Dwell(ScrollMode::PageFlip, milliseconds(5000)) == 1 && MarqueeFrames::Dwell(ScrollMode::Bounce, milliseconds(0)) == 1,
+		"dwell: at least one tick");
+	Check(MarqueeFrames::Dwell(ScrollMode::Marquee, kPeriod) == 0 && MarqueeFrames::Dwell(ScrollMode::Ellipsis, kPeriod) == 0,
+		"dwell: none for modes that don't hold");
+
+	// Halving the period doubles the ticks a page is held for
+	std::vector<Grapheme> graphemes;
+	const std::string title = "Hello wonderful world";
+	IndexGraphemes(title, graphemes);
+	auto courier = LookupTitleFont("Courier New", "Regular", kSize);
+	MarqueeFrames fast(title, graphemes, courier, ScrollMode::PageFlip, kPeriod / 2);
+	Check(fast.FrameCount() == 3 * 2 * MarqueeFrames::Dwell(ScrollMode::PageFlip, kPeriod), "dwell: pages follow the period");
+}
+
+static void CheckCache()
+{
+	auto courier = LookupTitleFont("Courier New", "Regular", kSize);
+	MarqueeFrameCache cache("Hello wonderful world");
+	auto marquee = cache.Get(courier, ScrollMode::Marquee, kPeriod);
+	Check(marquee == cache.Get(courier, ScrollMode::Marquee, kPeriod), "cache: a mode and font is built once");
+	Check(marquee == cache.Get(courier, ScrollMode::Marquee, kPeriod * 2), "cache: the marquee doesn't depend on the period");
+	Check(marquee != cache.Get(courier, ScrollMode::Bounce, kPeriod), "cache: each mode has its own frames");
+	Check(marquee != cache.Get(LookupTitleFont("Courier New", "Regular", 14), ScrollMode::Marquee, kPeriod), "cache: each size has its own frames");
+	auto pages = cache.Get(courier, ScrollMode::PageFlip, kPeriod);
+	Check(pages == cache.Get(courier, ScrollMode::PageFlip, std::chrono::milliseconds(260)), "cache: periods with the same dwell share frames");
+	Check(pages != cache.Get(courier, ScrollMode::PageFlip, kPeriod * 2), "cache: periods with another dwell don't");
+
+	MarqueeFrameCache repaired("ok\xFF");
+	Check(repaired.Title() == "ok\xEF\xBF\xBD", "cache: invalid UTF-8 is repaired");
+}
+
+int main()
+{
+	CheckLookup();
+	CheckAdvances();
+	CheckFit();
+	CheckModes();
+	CheckDwell();
+	CheckCache();
+
+	std::printf("%d failure(s)\n", sFailures);
+	return sFailures == 0 ? 0 : 1;
+}
@@ -0,0 +1,312 @@
+//==============================================================================
+/**
+@file       MprisMediaSourceTest.cpp
+
+@brief      MprisMediaSource against a fake player on a private dbus-daemon
+
+@copyright  (c) 2021, bionyx187
+			This source code is licensed under the MIT-style license found in the LICENSE file.
+
+**/
+//==============================================================================
+
+#include "../MprisMediaSource.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <signal.h>
+#include <unistd.h>
+
+// Usage: MprisMediaSourceTest <dbus-daemon>
+//
+// Starts a session bus of its own, so nothing on the desktop is touched, and plays an MPRIS player on a second
+// connection to it: owning and releasing the name, answering GetAll and sending PropertiesChanged.
+
+static const char kPlayerName[] = "org.mpris.MediaPlayer2.fake";
+static const char kPlayerPath[] = "/org/mpris/MediaPlayer2";
+static const char kPlayerInterface[] = "org.mpris.MediaPlayer2.Player";
+static const std::chrono::seconds kEventTimeout{ 5 };
+
+static const char kIntrospection[] =
+	"<node>"
+	"  <interface name='org.mpris.MediaPlayer2.Player'>"
+	"    <property name='PlaybackStatus' type='s' access='read'/>"
+	"    <property name='Metadata' type='a{sv}' access='read'/>"
+	"  </interface>"
+	"</node>";
+
+static int sFailures = 0;
+
+static void Check(bool inOk, const char* inWhat)
+{
+	std::printf("%s: %s\n", inOk ? "ok" : "FAILED", inWhat);
+	if (!inOk) {
+		++sFailures;
+	}
+}
+
+// A dbus-daemon --session of our own, stopped again on destruction
+class PrivateBus
+{
+public:
+	explicit PrivateBus(const std::string& inDaemon)
+	{
+		std::string command = inDaemon + " --session --fork --print-address=1 --print-pid=1";
+		FILE* output = popen(command.c_str(), "r");
+		if (output == nullptr) {
+			return;
+		}
+		char line[512];
+		if (std::fgets(line, sizeof(line), output) != nullptr) {
+			mAddress = line;
+			while (!mAddress.empty() && (mAddress.back() == '\n' || mAddress.back() == '\r')) {
+				mAddress.pop_back();
+			}
+		}
+		if (std::fgets(line, sizeof(line), output) != nullptr) {
+			mPid = std::atoi(line);
+		}
+		pclose(output);
+	}
+
+	~PrivateBus()
+	{
+		if (mPid > 0) {
+			kill(mPid, SIGTERM);
+		}
+	}
+
+	const std::string& Address() const { return mAddress; }
+
+private:
+	std::string mAddress;
+	pid_t mPid = 0;
+};
+
+// Events as MprisMediaSource delivers them, on its own thread
+class EventLog
+{
+public:
+	void Add(MediaSource::Event inEvent, const std::wstring& inSessionId)
+	{
+		{
+			std::lock_guard<std::mutex> lock(mMutex);
+			mEvents.emplace_back(inEvent, inSessionId);
+		}
+		mChanged.notify_all();
+	}
+
+	// Waits for inEvent past the ones already waited for
+	bool WaitFor(MediaSource::Event inEvent, const std::wstring& inSessionId)
+	{
+		std::unique_lock<std::mutex> lock(mMutex);
+		return mChanged.wait_for(lock, kEventTimeout, [&]() {
+			for (; mNext < mEvents.size(); ++mNext) {
+				if (mEvents[mNext].first == inEvent && mEvents[mNext].second == inSessionId) {
+					++mNext;
+					return true;
+				}
+			}
+			return false;
+		});
+	}
+
+private:
+	std::mutex mMutex;
+	std::condition_variable mChanged;
+	std::vector<std::pair<MediaSource::Event, std::wstring>> mEvents;
+	size_t mNext = 0;
+};
+
+// The player side: the object at /org/mpris/MediaPlayer2, served on a main loop thread of its own
+class FakePlayer
+{
+public:
+	explicit FakePlayer(const std::string& inAddress)
+	{
+		auto flags = static_cast<GDBusConnectionFlags>(G_DBUS_CONNECTION_FLAGS_AUTHENTICATION_CLIENT | G_DBUS_CONNECTION_FLAGS_MESSAGE_BUS_CONNECTION);
+		mConnection = g_dbus_connection_new_for_address_sync(inAddress.c_str(), flags, nullptr, nullptr, nullptr);
+		mNode = g_dbus_node_info_new_for_xml(kIntrospection, nullptr);
+		mContext = g_main_context_new();
+		mLoop = g_main_loop_new(mContext, FALSE);
+
+		// Property requests are dispatched on the main context that is the thread default at registration time.
+		static const GDBusInterfaceVTable kVTable = { nullptr, &FakePlayer::GetProperty, nullptr };
+		g_main_context_push_thread_default(mContext);
+		mRegistration = g_dbus_connection_register_object(mConnection, kPlayerPath, g_dbus_node_info_lookup_interface(mNode, kPlayerInterface), &kVTable, this, nullptr, nullptr);
+		g_main_context_pop_thread_default(mContext);
+
+		mThread = std::thread([this]() {
+			g_main_context_push_thread_default(mContext);
+			g_main_loop_run(mLoop);
+			g_main_context_pop_thread_default(mContext);
+		});
+	}
+
+	~FakePlayer()
+	{
+		g_dbus_connection_unregister_object(mConnection, mRegistration);
+		g_main_loop_quit(mLoop);
+		mThread.join();
+		g_main_loop_unref(mLoop);
+		g_main_context_unref(mContext);
+		g_dbus_node_info_unref(mNode);
+		g_dbus_connection_close_sync(mConnection, nullptr, nullptr);
+		g_object_unref(mConnection);
+	}
+
+	bool Connected() const { return mConnection != nullptr && mRegistration != 0; }
+
+	// RequestName and ReleaseName are what players do when they start and quit
+	bool Own()
+	{
+		return CallBus("RequestName", g_variant_new("(su)", kPlayerName, 0u));
+	}
+
+	bool Release()
+	{
+		return CallBus("ReleaseName", g_variant_new("(s)", kPlayerName));
+	}
+
+	// Changes the state and announces all of it, like most players do
+	void Set(const std::string& inStatus, const std::string& inTitle, const std::vector<std::string>& inArtists)
+	{
+		{
+			std::lock_guard<std::mutex> lock(mMutex);
+			mStatus = inStatus;
+			mTitle = inTitle;
+			mArtists = inArtists;
+		}
+
+		GVariantBuilder changed;
+		g_variant_builder_init(&changed, G_VARIANT_TYPE_VARDICT);
+		g_variant_builder_add(&changed, "{sv}", "PlaybackStatus", g_variant_new_string(inStatus.c_str()));
+		g_variant_builder_add(&changed, "{sv}", "Metadata", Metadata());
+		const gchar* invalidated[] = { nullptr };
+		g_dbus_connection_emit_signal(mConnection, nullptr, kPlayerPath, "org.freedesktop.DBus.Properties", "PropertiesChanged",
+			g_variant_new("(sa{sv}^as)", kPlayerInterface, &changed, invalidated), nullptr);
+		g_dbus_connection_flush_sync(mConnection, nullptr, nullptr);
+	}
+
+private:
+	static GVariant* GetProperty(GDBusConnection*, const gchar*, const gchar*, const gchar*, const gchar* inPropertyName, GError**, gpointer inUserData)
+	{
+		auto player = static_cast<FakePlayer*>(inUserData);
+		if (std::string(inPropertyName) == "PlaybackStatus") {
+			std::lock_guard<std::mutex> lock(player->mMutex);
+			return g_variant_new_string(player->mStatus.c_str());
+		}
+		return player->Metadata();
+	}
+
+	GVariant* Metadata()
+	{
+		std::lock_guard<std::mutex> lock(mMutex);
+		std::vector<const gchar*> artists;
+		for (const auto& artist : mArtists) {
+			artists.push_back(artist.c_str());
+		}
+		artists.push_back(nullptr);
+
+		GVariantBuilder metadata;
+		g_variant_builder_init(&metadata, G_VARIANT_TYPE_VARDICT);
+		g_variant_builder_add(&metadata, "{sv}", "mpris:trackid", g_variant_new_object_path("/org/mpris/MediaPlayer2/Track/1"));
+		g_variant_builder_add(&metadata, "{sv}", "xesam:title", g_variant_new_string(mTitle.c_str()));
+		g_variant_builder_add(&metadata, "{sv}", "xesam:artist", g_variant_new_strv(artists.data(), -1));
+		return g_variant_builder_end(&metadata);
+	}
+
+	bool CallBus(const char* inMethod, GVariant* inParameters)
+	{
+		GVariant* reply = g_dbus_connection_call_sync(mConnection, "org.freedesktop.DBus", "/org/freedesktop/DBus", "org.freedesktop.DBus", inMethod,
+			inParameters, nullptr, G_DBUS_CALL_FLAGS_NONE, -1, nullptr, nullptr);
+		if (reply == nullptr) {
+			return false;
+		}
+		g_variant_unref(reply);
+		return true;
+	}
+
+	GDBusConnection* mConnection = nullptr;
+	GDBusNodeInfo* mNode = nullptr;
+	GMainContext* mContext = nullptr;
+	GMainLoop* mLoop = nullptr;
+	guint mRegistration = 0;
+	std::thread mThread;
+
+	std::string mStatus = "Playing";
+	std::string mTitle;
+	std::vector<std::string> mArtists;
+	std::mutex mMutex; // protects mStatus, mTitle, mArtists
+};
+
+int main(int argc, const char* const argv[])
+{
+	if (argc != 2) {
+		std::fprintf(stderr, "Usage: %s <dbus-daemon>\n", argv[0]);
+		return 2;
+	}
+
+	PrivateBus bus(argv[1]);
+	if (bus.Address().empty()) {
+		std::fprintf(stderr, "Could not start %s\n", argv[1]);
+		return 1;
+	}
+
+	const std::wstring id = L"org.mpris.MediaPlayer2.fake";
+	EventLog events;
+	{
+		FakePlayer player(bus.Address());
+		Check(player.Connected(), "player connects and registers its object");
+
+		// Already running when the source starts, so it is found through ListNames
+		player.Set("Playing", "First", { "A", "B" });
+		Check(player.Own(), "player owns its name");
+
+		MprisMediaSource source(bus.Address());
+		source.Start([&](MediaSource::Event inEvent, const std::wstring& inSessionId) { events.Add(inEvent, inSessionId); });
+		Check(events.WaitFor(MediaSource::Event::SessionAdded, id), "running player is added on Start");
+
+		auto sessions = source.GetSessions();
+		Check(sessions.size() == 1 && sessions[0].id == id && sessions[0].status == MediaPlaybackStatus::Playing, "GetSessions has the playing player");
+		Check(source.GetCurrentSessionId() == id, "playing player is current");
+
+		MediaProperties properties;
+		Check(source.GetProperties(id, properties) && properties.title == "First" && properties.artist == L"A, B", "properties come from GetAll");
+		Check(properties.artwork == nullptr, "no mpris:artUrl means no artwork");
+
+		// PropertiesChanged
+		player.Set("Playing", "Second \xE2\x99\xAA", { "C" });
+		Check(events.WaitFor(MediaSource::Event::PropertiesChanged, id), "metadata change is reported");
+		Check(source.GetProperties(id, properties) && properties.title == "Second \xE2\x99\xAA" && properties.artist == L"C", "title stays UTF-8");
+
+		player.Set("Paused", "Second \xE2\x99\xAA", { "C" });
+		Check(events.WaitFor(MediaSource::Event::PlaybackChanged, id), "playback change is reported");
+		MediaPlaybackStatus status = MediaPlaybackStatus::Closed;
+		Check(source.GetPlaybackStatus(id, status) && status == MediaPlaybackStatus::Paused, "status follows PlaybackStatus");
+
+		// NameOwnerChanged
+		Check(player.Release(), "player releases its name");
+		Check(events.WaitFor(MediaSource::Event::SessionRemoved, id), "player quitting is reported");
+		Check(source.GetSessions().empty() && !source.GetPlaybackStatus(id, status), "player is gone");
+		Check(source.GetCurrentSessionId().empty(), "nothing is current");
+
+		player.Set("Playing", "Third", { "D" });
+		Check(player.Own(), "player owns its name again");
+		Check(events.WaitFor(MediaSource::Event::SessionAdded, id), "player starting is reported");
+		Check(source.GetProperties(id, properties) && properties.title == "Third", "properties are fetched for a new player");
+
+		source.Stop();
+	}
+
+	std::printf("%d failure(s)\n", sFailures);
+	return sFailures == 0 ? 0 : 1;
+}
@@ -0,0 +1,219 @@
+//==============================================================================
+/**
+@file       ScrollScenarioTest.cpp
+
+@brief      An hour of 4 Hz scrolling on 64 keys, on virtual time
+
+@copyright  (c) 2021, bionyx187
+			This source code is licensed under the MIT-style license found in the LICENSE file.
+
+**/
+//==============================================================================
+
+#include "../Common/ESDConnectionManager.h"
+#include "../FontMetrics.h"
+#include "../MarqueeFrames.h"
+#include "../MediaStreamDeckPlugin.h"
+#include "../Metrics.h"
+#include "../ScriptedMediaSource.h"
+#include "../TickScheduler.h"
+#include "../VirtualClock.h"
+
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <string>
+
+#include <stdlib.h>
+
+// Every deadline is hit exactly on the virtual clock, so the tick counts are exact: a key scheduled at
+// 250 ms ticks once right away and then 4 times a second, 14,401 times in an hour when nothing parks it.
+
+static const int kKeys = 64;
+static const int kPeriodMs = 250;
+static const std::chrono::hours kRunTime{ 1 };
+static const unsigned long long kTicksPerKey = 14401;
+static const unsigned long long kTicks = kKeys * kTicksPerKey; // 921,664
+
+static int sFailures = 0;
+
+static void Check(bool inOk, const std::string& inWhat)
+{
+	std::printf("%s: %s\n", inOk ? "ok" : "FAILED", inWhat.c_str());
+	if (!inOk) {
+		++sFailures;
+	}
+}
+
+// The platform's media source, which the plugin's default constructor would use. Here it is the scripted one.
+std::unique_ptr<MediaSource> CreateMediaSource()
+{
+	return std::make_unique<ScriptedMediaSource>();
+}
+
+// A folder of its own for the plugin's log and artwork cache, removed with everything in it at the end, so
+// nothing lands in the build tree and no cache carries over from one run to the next
+class TemporaryFolder
+{
+public:
+	TemporaryFolder()
+	{
+		auto path = (std::filesystem::temp_directory_path() / "ScrollScenarioTest.XXXXXX").string();
+		if (mkdtemp(&path[0]) != nullptr) {
+			mPath = path;
+		}
+	}
+
+	~TemporaryFolder()
+	{
+		if (!mPath.empty()) {
+			std::error_code error;
+			std::filesystem::remove_all(mPath, error);
+		}
+	}
+
+	const std::string& Path() const { return mPath; }
+
+private:
+	std::string mPath;
+};
+
+static std::string KeyContext(int inKey)
+{
+	return "key" + std::to_string(inKey);
+}
+
+// The scheduler on its own, with a tick function that always has another frame
+static void RunScheduler()
+{
+	VirtualClock clock;
+	unsigned long long ticks = 0;
+	TickScheduler scheduler(clock, [&](const std::string&, int tick, unsigned long long&, const TitleFont&, ScrollMode, std::chrono::milliseconds) {
+		++ticks;
+		return tick + 1;
+	});
+	for (int key = 0; key < kKeys; ++key) {
+		scheduler.Schedule(KeyContext(key), kPeriodMs);
+	}
+
+	auto start = std::chrono::steady_clock::now();
+	scheduler.RunUntil(clock.Now() + kRunTime);
+	auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+
+	Check(ticks == kTicks, "scheduler: " + std::to_string(ticks) + " ticks in " + std::to_string(elapsed.count()) + " ms");
+	bool exact = true;
+	for (int key = 0; key < kKeys; ++key) {
+		TickScheduler::TickStats stats;
+		exact = exact && scheduler.GetStats(KeyContext(key), stats) && stats.ticks == kTicksPerKey &&
+			stats.missedFrames == 0 && stats.maxLateness.count() == 0;
+	}
+	Check(exact, "scheduler: every key on time, none missed");
+}
+
+// setTitle calls for inTicks ticks of a title scrolling on one key. The first frame always goes out; after that
+// a frame that is the same as the one before, such as the blank ends of the marquee, isn't sent.
+static unsigned long long ExpectedTitleCalls(const std::string& inTitle, unsigned long long inTicks)
+{
+	MarqueeFrameCache cache(inTitle);
+	auto frames = cache.Get(LookupTitleFont("Arial", "Regular", 12), ScrollMode::Marquee, std::chrono::milliseconds(kPeriodMs));
+	auto count = frames->FrameCount();
+	unsigned long long calls = 0;
+	for (unsigned long long tick = 0; tick < inTicks; ++tick) {
+		size_t frame = tick % count;
+		if (tick == 0 || frames->Frame(frame) != frames->Frame(frame > 0 ? frame - 1 : count - 1)) {
+			++calls;
+		}
+	}
+	return calls;
+}
+
+// The whole plugin on a scripted player, with a connection manager that never connects to take the messages:
+//
+// - 0:00       The keys appear, draw the empty initial state and park.
+// - 0:00.075   The media worker publishes the first title and wakes the keys. They scroll on a grid from here.
+// - 20:00.100  The track changes. It is published at .175 and shows from the next tick at .325.
+// - 40:00.100  The player pauses. Published at .175, the keys clear their titles at .325 and park.
+// - 50:00.100  The player plays again. Published at .175, which wakes the keys right away on a grid of its own.
+//
+// Every event lands between two ticks, so each phase's tick and setTitle counts are exact.
+static void RunPlugin()
+{
+	using std::chrono::milliseconds;
+	using std::chrono::minutes;
+	const std::string firstTitle = "A title that is much too long to fit on a key";
+	const std::string secondTitle = "Another title, which doesn't fit on a key either";
+	const auto trackChange = minutes(20) + milliseconds(100);
+	const auto pause = minutes(40) + milliseconds(100);
+	const auto resume = minutes(50) + milliseconds(100);
+
+	TemporaryFolder dataFolder;
+	Check(!dataFolder.Path().empty(), "plugin: data folder " + dataFolder.Path());
+
+	VirtualClock clock;
+	auto source = std::make_unique<ScriptedMediaSource>();
+	auto script = source.get();
+	script->AddSession(std::chrono::seconds(0), L"player");
+	script->SetCurrentSession(std::chrono::seconds(0), L"player");
+	script->SetTrack(std::chrono::seconds(0), L"player", firstTitle, L"Artist", nullptr);
+	script->SetPlayback(std::chrono::seconds(0), L"player", MediaPlaybackStatus::Playing);
+	script->SetTrack(trackChange, L"player", secondTitle, L"Artist", nullptr);
+	script->SetPlayback(pause, L"player", MediaPlaybackStatus::Paused);
+	script->SetPlayback(resume, L"player", MediaPlaybackStatus::Playing);
+
+	MediaStreamDeckPlugin plugin(std::move(source), clock, dataFolder.Path());
+	ESDConnectionManager connection(0, "scenario", "registerPlugin", "{}", &plugin);
+
+	json settings = { { "settings", { { "refresh_time", kPeriodMs } } } };
+	json titleParameters = { { "titleParameters", { { "fontFamily", "Arial" }, { "fontStyle", "Regular" }, { "fontSize", 12 } } } };
+	for (int key = 0; key < kKeys; ++key) {
+		plugin.WillAppearForAction("com.bionyx187.media.action", KeyContext(key), settings, "device");
+		plugin.TitleParametersDidChange("com.bionyx187.media.action", KeyContext(key), titleParameters, "device");
+	}
+
+	// Runs the plugin up to inUntil, applying the script's steps at inFrom first, and checks what happened on the way
+	// against counts per key
+	auto start = std::chrono::steady_clock::now();
+	auto phase = [&](const char* inName, VirtualClock::duration inFrom, VirtualClock::duration inUntil, unsigned long long inTicks,
+		unsigned long long inTitleCalls, unsigned long long inRefreshes, size_t inParked) {
+		auto ticksBefore = Metrics::Value(MetricCounter::Ticks);
+		auto titlesBefore = Metrics::Value(MetricCounter::TitleCalls);
+		auto refreshesBefore = Metrics::Value(MetricCounter::CheckMediaCalls);
+		script->RunUntil(inFrom);
+		plugin.RunUntil(VirtualClock::time_point(inUntil));
+
+		auto ticks = Metrics::Value(MetricCounter::Ticks) - ticksBefore;
+		auto titles = Metrics::Value(MetricCounter::TitleCalls) - titlesBefore;
+		auto refreshes = Metrics::Value(MetricCounter::CheckMediaCalls) - refreshesBefore;
+		auto parked = plugin.ParkedKeyCount();
+		auto name = std::string("plugin, ") + inName + ": ";
+		Check(ticks == kKeys * inTicks, name + std::to_string(ticks) + " ticks, expected " + std::to_string(kKeys * inTicks));
+		Check(titles == kKeys * inTitleCalls, name + std::to_string(titles) + " setTitle calls, expected " + std::to_string(kKeys * inTitleCalls));
+		Check(refreshes == inRefreshes, name + std::to_string(refreshes) + " refreshes, expected " + std::to_string(inRefreshes));
+		Check(parked == inParked, name + std::to_string(parked) + " keys parked, expected " + std::to_string(inParked));
+	};
+
+	auto grid = [](VirtualClock::duration inFirst, VirtualClock::duration inLast) {
+		return static_cast<unsigned long long>((inLast - inFirst) / milliseconds(kPeriodMs)) + 1;
+	};
+	auto published = milliseconds(75);
+	auto firstTicks = grid(published, trackChange - milliseconds(25));
+	auto secondTicks = grid(trackChange + milliseconds(225), pause - milliseconds(25));
+	auto resumedTicks = grid(resume + published, kRunTime);
+
+	phase("first title", std::chrono::seconds(0), trackChange, 1 + firstTicks, 1 + ExpectedTitleCalls(firstTitle, firstTicks), 1, 0);
+	phase("track change", trackChange, pause, secondTicks, ExpectedTitleCalls(secondTitle, secondTicks), 1, 0);
+	phase("paused", pause, resume, 1, 1, 0, kKeys);
+	phase("resumed", resume, kRunTime, resumedTicks, ExpectedTitleCalls(secondTitle, resumedTicks), 0, 0);
+
+	auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+	std::printf("plugin: an hour in %lld ms\n", static_cast<long long>(elapsed.count()));
+}
+
+int main()
+{
+	RunScheduler();
+	RunPlugin();
+
+	std::printf("%d failure(s)\n", sFailures);
+	return sFailures == 0 ? 0 : 1;
+}
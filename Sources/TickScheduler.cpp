@@ -0,0 +1,331 @@
+//==============================================================================
+/**
+@file       TickScheduler.cpp
+
+@brief      Drives the per-button scroll ticks from a single timer on the websocket io_service
+
+@copyright  (c) 2021, bionyx187
+			This source code is licensed under the MIT-style license found in the LICENSE file.
+
+**/
+//==============================================================================
+
+#include "TickScheduler.h"
+#include "Metrics.h"
+#include "Trace.h"
+
+#include <asio/post.hpp>
+
+TickScheduler::TickScheduler(asio::io_service& inIOService, TickFunction inTickFunction, CatchUp inCatchUp) :
+	mIOService(&inIOService),
+	mTimer(std::make_unique<asio::steady_timer>(inIOService)),
+	mTickFunction(std::move(inTickFunction)),
+	mCatchUp(inCatchUp)
+{
+}
+
+TickScheduler::TickScheduler(VirtualClock& inClock, TickFunction inTickFunction, CatchUp inCatchUp) :
+	mVirtualClock(&inClock),
+	mTickFunction(std::move(inTickFunction)),
+	mCatchUp(inCatchUp)
+{
+}
+
+TickScheduler::~TickScheduler()
+{
+	if (mTimer != nullptr) {
+		asio::error_code ec;
+		mTimer->cancel(ec);
+	}
+}
+
+TickScheduler::Clock::time_point TickScheduler::Now() const
+{
+	return mVirtualClock != nullptr ? mVirtualClock->Now() : Clock::now();
+}
+
+void TickScheduler::Schedule(const std::string& inContext, int inPeriodMs, ScrollMode inMode)
+{
+	{
+		std::lock_guard<std::mutex> lock(mMutex);
+		auto [entry, inserted] = mStates.try_emplace(inContext);
+		auto& state = entry->second;
+		if (inserted || state.cancelled) {
+			++mActiveCount;
+			state.cancelled = false;
+		}
+		if (state.parked) {
+			state.parked = false;
+			--mParkedCount;
+		}
+		state.period = std::chrono::milliseconds(inPeriodMs);
+		state.mode = inMode;
+		state.deadline = Now();
+		state.generation = 0;
+		++state.serial;
+		mDeadlines.push({ state.deadline, inContext, state.serial });
+	}
+
+	// The timer may only be touched from the io thread, so hand the re-arm over to it.
+	if (mIOService != nullptr) {
+		asio::post(*mIOService, [this]() { Arm(); });
+	}
+}
+
+void TickScheduler::Cancel(const std::string& inContext)
+{
+	// The heap entry is left behind. When it comes due, FindLive sees the mark and frees the state. A parked
+	// context has no heap entry, so it goes right away.
+	std::lock_guard<std::mutex> lock(mMutex);
+	auto state = mStates.find(inContext);
+	if (state != mStates.end() && !state->second.cancelled) {
+		--mActiveCount;
+		if (state->second.parked) {
+			--mParkedCount;
+			mStates.erase(state);
+		}
+		else {
+			state->second.cancelled = true;
+		}
+	}
+}
+
+void TickScheduler::SetTitleFont(const std::string& inContext, const TitleFont& inFont)
+{
+	bool woken = false;
+	{
+		std::lock_guard<std::mutex> lock(mMutex);
+		auto state = mStates.find(inContext);
+		if (state == mStates.end() || state->second.cancelled || state->second.font == inFont) {
+			return;
+		}
+		state->second.font = inFont;
+		state->second.generation = 0;
+		if (state->second.parked) {
+			Wake(inContext, state->second);
+			woken = true;
+		}
+	}
+
+	if (woken && mIOService != nullptr) {
+		asio::post(*mIOService, [this]() { Arm(); });
+	}
+}
+
+void TickScheduler::WakeAll()
+{
+	bool woken = false;
+	{
+		std::lock_guard<std::mutex> lock(mMutex);
+		++mWakeAllCount;
+		for (auto& [context, state] : mStates) {
+			if (state.parked) {
+				Wake(context, state);
+				woken = true;
+			}
+		}
+	}
+
+	if (woken && mIOService != nullptr) {
+		asio::post(*mIOService, [this]() { Arm(); });
+	}
+}
+
+// Puts a parked context back on the heap, due now. Callers hold mMutex and arm the timer afterwards.
+void TickScheduler::Wake(const std::string& inContext, TickState& ioState)
+{
+	ioState.parked = false;
+	--mParkedCount;
+	ioState.tick = 0;
+	ioState.deadline = Now();
+	mDeadlines.push({ ioState.deadline, inContext, ioState.serial });
+}
+
+size_t TickScheduler::ContextCount()
+{
+	std::lock_guard<std::mutex> lock(mMutex);
+	return mActiveCount;
+}
+
+size_t TickScheduler::ParkedCount()
+{
+	std::lock_guard<std::mutex> lock(mMutex);
+	return mParkedCount;
+}
+
+bool TickScheduler::GetStats(const std::string& inContext, TickStats& outStats)
+{
+	std::lock_guard<std::mutex> lock(mMutex);
+	auto state = mStates.find(inContext);
+	if (state == mStates.end() || state->second.cancelled) {
+		return false;
+	}
+	outStats = state->second.stats;
+	return true;
+}
+
+void TickScheduler::RunUntil(VirtualClock::time_point inTime)
+{
+	for (;;) {
+		{
+			std::lock_guard<std::mutex> lock(mMutex);
+			DropStale();
+			if (mDeadlines.empty() || mDeadlines.top().when > inTime) {
+				break;
+			}
+			mVirtualClock->AdvanceTo(mDeadlines.top().when);
+		}
+		RunDue();
+	}
+	mVirtualClock->AdvanceTo(inTime);
+}
+
+// The state a heap entry belongs to, or nullptr if the entry is stale. Every context has exactly one entry
+// with its current serial, so that is where a cancelled context's state gets freed. Callers hold mMutex.
+TickScheduler::TickState* TickScheduler::FindLive(const std::string& inContext, unsigned inSerial)
+{
+	auto state = mStates.find(inContext);
+	if (state == mStates.end() || state->second.serial != inSerial) {
+		return nullptr;
+	}
+	if (state->second.cancelled) {
+		mStates.erase(state);
+		return nullptr;
+	}
+	return &state->second;
+}
+
+// Drop stale entries from the top of the heap, so the next deadline is a real one. Callers hold mMutex.
+void TickScheduler::DropStale()
+{
+	while (!mDeadlines.empty() && FindLive(mDeadlines.top().context, mDeadlines.top().serial) == nullptr) {
+		mDeadlines.pop();
+	}
+}
+
+void TickScheduler::Arm()
+{
+	std::lock_guard<std::mutex> lock(mMutex);
+
+	// Stale entries are dropped so the timer never wakes up just to discard them.
+	DropStale();
+	if (mDeadlines.empty()) {
+		asio::error_code ec;
+		mTimer->cancel(ec);
+		return;
+	}
+
+	// Re-arming cancels the pending wait, whose handler then sees operation_aborted and bows out.
+	mTimer->expires_at(mDeadlines.top().when);
+	mTimer->async_wait([this](const asio::error_code& ec) { OnTimer(ec); });
+}
+
+void TickScheduler::OnTimer(const asio::error_code& ec)
+{
+	if (ec == asio::error::operation_aborted) {
+		return;
+	}
+
+	TRACE_SCOPE("scheduler", "wakeup");
+	RunDue();
+	Arm();
+}
+
+void TickScheduler::RunDue()
+{
+	struct DueTick
+	{
+		std::string context;
+		unsigned serial;
+		Clock::time_point deadline;
+		int tick;
+		TitleFont font;
+		ScrollMode mode;
+		std::chrono::milliseconds period;
+		unsigned long long generation;
+	};
+	std::vector<DueTick> due;
+	unsigned long long wakeAllCount = 0;
+
+	// Collect everything that is due in this wakeup. The tick function does websocket I/O, so it runs
+	// without the lock held.
+	{
+		std::lock_guard<std::mutex> lock(mMutex);
+		auto now = Now();
+		wakeAllCount = mWakeAllCount;
+		while (!mDeadlines.empty() && mDeadlines.top().when <= now) {
+			auto deadline = mDeadlines.top();
+			mDeadlines.pop();
+
+			auto state = FindLive(deadline.context, deadline.serial);
+			if (state == nullptr) {
+				continue;
+			}
+
+			auto& tickState = *state;
+			auto lateness = std::chrono::duration_cast<std::chrono::microseconds>(now - deadline.when);
+			++tickState.stats.ticks;
+			tickState.stats.totalLateness += lateness;
+			if (lateness > tickState.stats.maxLateness) {
+				tickState.stats.maxLateness = lateness;
+			}
+
+			due.push_back({ deadline.context, deadline.serial, deadline.when, tickState.tick, tickState.font, tickState.mode, tickState.period, tickState.generation });
+		}
+	}
+
+	Metrics::Add(MetricCounter::Ticks, due.size());
+	for (auto& item : due) {
+		item.tick = mTickFunction(item.context, item.tick, item.generation, item.font, item.mode, item.period);
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(mMutex);
+		auto now = Now();
+		for (const auto& item : due) {
+			// Skip contexts that were cancelled or rescheduled while the tick function ran.
+			auto state = FindLive(item.context, item.serial);
+			if (state == nullptr) {
+				continue;
+			}
+
+			// A new title font while the tick function ran reset the generation to 0 to ask for a redraw.
+			auto& tickState = *state;
+			bool fontChanged = tickState.font != item.font;
+			if (!fontChanged) {
+				tickState.generation = item.generation;
+			}
+
+			if (item.tick == kParked) {
+				// Park unless something woke the context while the tick function decided to park, since the
+				// function may not have seen what changed.
+				tickState.tick = 0;
+				if (!fontChanged && mWakeAllCount == wakeAllCount) {
+					tickState.parked = true;
+					++mParkedCount;
+					continue;
+				}
+				tickState.deadline = now;
+				mDeadlines.push({ tickState.deadline, item.context, item.serial });
+				continue;
+			}
+			tickState.tick = item.tick;
+
+			// The next deadline is computed from the previous one rather than from now, so the time spent in
+			// the tick function and the websocket send doesn't stretch the period.
+			tickState.deadline = item.deadline + tickState.period;
+			if (tickState.deadline <= now) {
+				if (mCatchUp == CatchUp::Compress || tickState.period.count() <= 0) {
+					tickState.stats.missedFrames += 1;
+					tickState.deadline = now;
+				}
+				else {
+					auto missed = (now - tickState.deadline) / tickState.period + 1;
+					tickState.stats.missedFrames += missed;
+					tickState.deadline += missed * tickState.period;
+				}
+			}
+			mDeadlines.push({ tickState.deadline, item.context, item.serial });
+		}
+	}
+}
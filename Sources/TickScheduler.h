@@ -0,0 +1,139 @@
+//==============================================================================
+/**
+@file       TickScheduler.h
+
+@brief      Drives the per-button scroll ticks from a single timer on the websocket io_service
+
+@copyright  (c) 2021, bionyx187
+			This source code is licensed under the MIT-style license found in the LICENSE file.
+
+**/
+//==============================================================================
+
+#pragma once
+
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <asio/io_service.hpp>
+#include <asio/steady_timer.hpp>
+
+#include "MarqueeFrames.h"
+#include "VirtualClock.h"
+
+class TickScheduler
+{
+public:
+	// Called once per due context. Receives the current tick and returns the next one. generation is
+	// the media state generation the context last drew; the function updates it when it draws a newer
+	// one. It starts out as 0 so a newly scheduled context always draws. period is the context's, for
+	// modes that hold a frame for a time. Returning kParked stops ticking the context until it is woken.
+	using TickFunction = std::function<int(const std::string& context, int tick, unsigned long long& generation, const TitleFont& font, ScrollMode mode, std::chrono::milliseconds period)>;
+
+	// What to do with frames whose deadline passed while the io thread was busy.
+	enum class CatchUp
+	{
+		Skip,		// Drop the missed frames and stay on the original deadline grid
+		Compress	// Draw one frame right away and restart the grid from now
+	};
+
+	// Pacing counters for a single context. Lateness is measured from the absolute deadline to the
+	// moment the wakeup picked the context up.
+	struct TickStats
+	{
+		unsigned long long ticks = 0;
+		unsigned long long missedFrames = 0;
+		std::chrono::microseconds totalLateness{ 0 };
+		std::chrono::microseconds maxLateness{ 0 };
+	};
+
+	static constexpr int kParked = -1;
+
+	TickScheduler(asio::io_service& inIOService, TickFunction inTickFunction, CatchUp inCatchUp = CatchUp::Skip);
+
+	// Runs on virtual time instead. Nothing ticks by itself; RunUntil advances the clock from deadline
+	// to deadline and ticks on the calling thread.
+	TickScheduler(VirtualClock& inClock, TickFunction inTickFunction, CatchUp inCatchUp = CatchUp::Skip);
+	~TickScheduler();
+
+	// Add a context, or reset an existing one with a new period and scroll mode. The context ticks as soon
+	// as possible and redraws from scratch.
+	void Schedule(const std::string& inContext, int inPeriodMs, ScrollMode inMode = ScrollMode::Marquee);
+
+	// Stops ticking the context right away. It only marks the context cancelled, which is a single hash lookup
+	// under the lock. Its state is freed when the wakeup that would have ticked it next finds the mark.
+	void Cancel(const std::string& inContext);
+
+	// A new title font redraws the context from scratch, and wakes it if it is parked.
+	void SetTitleFont(const std::string& inContext, const TitleFont& inFont);
+
+	// Ticks every parked context as soon as possible, for when what they show may have changed. A wakeup
+	// that comes in while a context is ticking keeps it from parking.
+	void WakeAll();
+
+	size_t ContextCount();
+	size_t ParkedCount();
+
+	// Returns false if the context isn't scheduled.
+	bool GetStats(const std::string& inContext, TickStats& outStats);
+
+	// Only for the virtual clock: tick everything due up to and including inTime.
+	void RunUntil(VirtualClock::time_point inTime);
+
+private:
+	using Clock = std::chrono::steady_clock;
+
+	struct TickState
+	{
+		std::chrono::milliseconds period{ 0 };
+		Clock::time_point deadline;
+		int tick = 0;
+		TitleFont font;
+		ScrollMode mode = ScrollMode::Marquee;
+		unsigned long long generation = 0;
+		TickStats stats;
+
+		// Bumped whenever the context is rescheduled so stale heap entries can be recognized.
+		unsigned serial = 0;
+		bool cancelled = false;
+		bool parked = false; // no heap entry until woken
+	};
+
+	struct Deadline
+	{
+		Clock::time_point when;
+		std::string context;
+		unsigned serial;
+
+		bool operator>(const Deadline& other) const { return when > other.when; }
+	};
+
+	Clock::time_point Now() const;
+	TickState* FindLive(const std::string& inContext, unsigned inSerial);
+	void Wake(const std::string& inContext, TickState& ioState);
+	void DropStale();
+	void Arm();
+	void OnTimer(const asio::error_code& ec);
+	void RunDue();
+
+	// Either the io_service and its timer, or the virtual clock
+	asio::io_service* mIOService = nullptr;
+	std::unique_ptr<asio::steady_timer> mTimer;
+	VirtualClock* mVirtualClock = nullptr;
+
+	TickFunction mTickFunction;
+	CatchUp mCatchUp;
+
+	std::unordered_map<std::string, TickState> mStates;
+	size_t mActiveCount = 0; // mStates that aren't cancelled
+	size_t mParkedCount = 0;
+	unsigned long long mWakeAllCount = 0;
+	std::priority_queue<Deadline, std::vector<Deadline>, std::greater<Deadline>> mDeadlines;
+	std::mutex mMutex; // protects mStates, mActiveCount, mParkedCount, mWakeAllCount, mDeadlines
+};
@@ -0,0 +1,167 @@
+//==============================================================================
+/**
+@file       Trace.cpp
+
+@brief      Opt-in span tracing, exported as a Chrome Trace Event file
+
+@copyright  (c) 2021, bionyx187
+			This source code is licensed under the MIT-style license found in the LICENSE file.
+
+**/
+//==============================================================================
+
+#include "Trace.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+struct TraceSpan
+{
+	const char* category;
+	const char* name;
+	Trace::Clock::time_point begin;
+	Trace::Clock::time_point end;
+};
+
+// Only the owning thread writes spans and bumps written. Readers copy the spans and then check
+// written again to find out which of them may have been overwritten while copying.
+struct TraceThreadBuffer
+{
+	unsigned id = 0;
+	std::atomic<const char*> name{ nullptr };
+	std::atomic<unsigned long long> written{ 0 };
+	TraceSpan spans[Trace::kSpansPerThread];
+};
+
+// Buffers are kept after their thread exits, so its spans still make it into the file.
+static std::mutex sBuffersMutex;
+static std::vector<std::unique_ptr<TraceThreadBuffer>> sBuffers; // protected by sBuffersMutex
+
+// Spans that began before the latest Start are left out of the file
+static std::atomic<Trace::Clock::rep> sStartTime{ 0 };
+
+// The name is kept aside so naming a thread doesn't allocate its buffer while tracing is off
+static thread_local TraceThreadBuffer* sThreadBuffer = nullptr;
+static thread_local const char* sThreadName = nullptr;
+
+static TraceThreadBuffer& LocalBuffer()
+{
+	if (sThreadBuffer == nullptr) {
+		auto buffer = std::make_unique<TraceThreadBuffer>();
+		std::lock_guard<std::mutex> lock(sBuffersMutex);
+		buffer->id = static_cast<unsigned>(sBuffers.size()) + 1;
+		buffer->name.store(sThreadName, std::memory_order_relaxed);
+		sThreadBuffer = buffer.get();
+		sBuffers.push_back(std::move(buffer));
+	}
+	return *sThreadBuffer;
+}
+
+static void AppendEscaped(std::string& outJson, const char* inString)
+{
+	for (; *inString != '\0'; ++inString) {
+		if (*inString == '"' || *inString == '\\') {
+			outJson += '\\';
+		}
+		outJson += *inString;
+	}
+}
+
+void Trace::Start()
+{
+	sStartTime.store(Clock::now().time_since_epoch().count(), std::memory_order_relaxed);
+	sEnabled.store(true, std::memory_order_release);
+}
+
+void Trace::Stop()
+{
+	sEnabled.store(false, std::memory_order_release);
+}
+
+void Trace::SetThreadName(const char* inName)
+{
+	sThreadName = inName;
+	if (sThreadBuffer != nullptr) {
+		sThreadBuffer->name.store(inName, std::memory_order_relaxed);
+	}
+}
+
+void Trace::Record(const char* inCategory, const char* inName, Clock::time_point inBegin, Clock::time_point inEnd)
+{
+	auto& buffer = LocalBuffer();
+	auto index = buffer.written.load(std::memory_order_relaxed);
+	buffer.spans[index % kSpansPerThread] = { inCategory, inName, inBegin, inEnd };
+	buffer.written.store(index + 1, std::memory_order_release);
+}
+
+bool Trace::Write(const std::string& inPath)
+{
+	auto start = Clock::time_point(Clock::duration(sStartTime.load(std::memory_order_relaxed)));
+
+	std::string json = "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+	bool first = true;
+	char number[64];
+
+	std::vector<TraceSpan> spans;
+	std::unique_lock<std::mutex> lock(sBuffersMutex);
+	for (const auto& buffer : sBuffers) {
+		auto written = buffer->written.load(std::memory_order_acquire);
+		auto oldest = written > kSpansPerThread ? written - kSpansPerThread : 0;
+		spans.clear();
+		for (auto index = oldest; index < written; ++index) {
+			spans.push_back(buffer->spans[index % kSpansPerThread]);
+		}
+
+		// Whatever the thread wrapped around to while we were copying is garbage.
+		auto rewritten = buffer->written.load(std::memory_order_acquire);
+		auto valid = rewritten > kSpansPerThread ? rewritten - kSpansPerThread : 0;
+		size_t skip = valid > oldest ? static_cast<size_t>(valid - oldest) : 0;
+
+		if (!first) {
+			json += ',';
+		}
+		first = false;
+		auto name = buffer->name.load(std::memory_order_relaxed);
+		std::snprintf(number, sizeof(number), "%u", buffer->id);
+		json += "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":";
+		json += number;
+		json += ",\"args\":{\"name\":\"";
+		if (name != nullptr) {
+			AppendEscaped(json, name);
+		}
+		else {
+			json += "thread ";
+			json += number;
+		}
+		json += "\"}}";
+
+		for (size_t i = std::min(skip, spans.size()); i < spans.size(); ++i) {
+			const auto& span = spans[i];
+			if (span.begin < start) {
+				continue;
+			}
+			json += ",{\"name\":\"";
+			AppendEscaped(json, span.name);
+			json += "\",\"cat\":\"";
+			AppendEscaped(json, span.category);
+			std::snprintf(number, sizeof(number), "\",\"ph\":\"X\",\"pid\":1,\"tid\":%u", buffer->id);
+			json += number;
+
+			// Microseconds, with the nanoseconds behind the decimal point
+			auto begin = std::chrono::duration<double, std::micro>(span.begin - start).count();
+			auto duration = std::chrono::duration<double, std::micro>(span.end - span.begin).count();
+			std::snprintf(number, sizeof(number), ",\"ts\":%.3f,\"dur\":%.3f}", begin, duration);
+			json += number;
+		}
+	}
+	lock.unlock();
+	json += "]}";
+
+	std::ofstream file(inPath, std::ios::binary | std::ios::trunc);
+	file.write(json.data(), static_cast<std::streamsize>(json.size()));
+	return static_cast<bool>(file);
+}
@@ -0,0 +1,84 @@
+//==============================================================================
+/**
+@file       Trace.h
+
+@brief      Opt-in span tracing, exported as a Chrome Trace Event file
+
+@copyright  (c) 2021, bionyx187
+			This source code is licensed under the MIT-style license found in the LICENSE file.
+
+**/
+//==============================================================================
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <string>
+
+// Spans are recorded into a fixed ring buffer per thread, which only that thread writes, so recording
+// takes no lock. Once a buffer is full the oldest spans are overwritten. Write turns whatever the rings
+// hold into a JSON file that chrome://tracing and ui.perfetto.dev open.
+//
+// Names and categories are stored as pointers, so they have to be string literals.
+class Trace
+{
+public:
+	using Clock = std::chrono::steady_clock;
+
+	static constexpr size_t kSpansPerThread = 16 * 1024;
+
+	static bool IsEnabled() { return sEnabled.load(std::memory_order_relaxed); }
+
+	// Recording starts with spans that begin after Start. Stop keeps what was recorded for Write.
+	static void Start();
+	static void Stop();
+
+	// Shows up as the thread's name in the viewer
+	static void SetThreadName(const char* inName);
+
+	static void Record(const char* inCategory, const char* inName, Clock::time_point inBegin, Clock::time_point inEnd);
+
+	// Writes every thread's spans, oldest first. Returns false if the file couldn't be written.
+	static bool Write(const std::string& inPath);
+
+private:
+	static inline std::atomic<bool> sEnabled{ false };
+};
+
+// Records the enclosing scope as a span. With tracing off, the only cost is the flag check in the
+// constructor and the branch on its result in the destructor.
+class TraceScope
+{
+public:
+	TraceScope(const char* inCategory, const char* inName)
+	{
+		if (Trace::IsEnabled()) {
+			mCategory = inCategory;
+			mName = inName;
+			mBegin = Trace::Clock::now();
+		}
+	}
+
+	~TraceScope()
+	{
+		if (mName != nullptr) {
+			Trace::Record(mCategory, mName, mBegin, Trace::Clock::now());
+		}
+	}
+
+	TraceScope(const TraceScope&) = delete;
+	TraceScope& operator=(const TraceScope&) = delete;
+
+private:
+	const char* mCategory = nullptr;
+	const char* mName = nullptr;
+	Trace::Clock::time_point mBegin;
+};
+
+#define TRACE_CONCAT_INNER(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_INNER(a, b)
+#define TRACE_SCOPE(category, name) TraceScope TRACE_CONCAT(traceScope, __LINE__)(category, name)
+
+// Records a single call and yields its result, for spans around one blocking call in the middle of an expression
+#define TRACE_CALL(category, name, ...) ([&]() { TRACE_SCOPE(category, name); return __VA_ARGS__; }())
@@ -0,0 +1,371 @@
+//==============================================================================
+/**
+@file       UTFTranscode.cpp
+
+@brief      Validating UTF-8 <-> wide string conversion with a vectorized ASCII path
+
+@copyright  (c) 2021, bionyx187
+			This source code is licensed under the MIT-style license found in the LICENSE file.
+
+**/
+//==============================================================================
+
+#include "UTFTranscode.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <type_traits>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define UTF_AVX2 1
+#define UTF_SSE2 1
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define UTF_SSE2 1
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#include <arm_neon.h>
+#define UTF_NEON 1
+#endif
+
+// Code units handled one at a time after a run of ASCII ends, before looking for whole ASCII blocks again. Text that
+// is mostly not ASCII pays for one failed block check every kScalarRun code units.
+static constexpr size_t kScalarRun = 16;
+
+// Copies whole blocks of ASCII wide code units as bytes, stopping at the first block with anything else in it, and
+// returns how many were copied.
+template<typename Unit>
+static size_t NarrowASCIIBlocks(const Unit* inText, size_t inLength, char* outText)
+{
+	size_t i = 0;
+	if constexpr (sizeof(Unit) == 2) {
+#if defined(UTF_AVX2)
+		const __m256i nonASCII = _mm256_set1_epi16(static_cast<short>(0xFF80));
+		for (; i + 32 <= inLength; i += 32) {
+			auto low = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(inText + i));
+			auto high = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(inText + i + 16));
+			if (!_mm256_testz_si256(_mm256_or_si256(low, high), nonASCII)) {
+				break;
+			}
+			// The pack works within 128-bit lanes, so its quadwords come out as low, high, low, high.
+			auto bytes = _mm256_permute4x64_epi64(_mm256_packus_epi16(low, high), 0xD8);
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(outText + i), bytes);
+		}
+#elif defined(UTF_SSE2)
+		const __m128i nonASCII = _mm_set1_epi16(static_cast<short>(0xFF80));
+		for (; i + 16 <= inLength; i += 16) {
+			auto low = _mm_loadu_si128(reinterpret_cast<const __m128i*>(inText + i));
+			auto high = _mm_loadu_si128(reinterpret_cast<const __m128i*>(inText + i + 8));
+			auto outside = _mm_and_si128(_mm_or_si128(low, high), nonASCII);
+			if (_mm_movemask_epi8(_mm_cmpeq_epi16(outside, _mm_setzero_si128())) != 0xFFFF) {
+				break;
+			}
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(outText + i), _mm_packus_epi16(low, high));
+		}
+#elif defined(UTF_NEON)
+		for (; i + 16 <= inLength; i += 16) {
+			auto low = vld1q_u16(reinterpret_cast<const uint16_t*>(inText + i));
+			auto high = vld1q_u16(reinterpret_cast<const uint16_t*>(inText + i + 8));
+			if (vmaxvq_u16(vorrq_u16(low, high)) >= 0x80) {
+				break;
+			}
+			vst1q_u8(reinterpret_cast<uint8_t*>(outText + i), vcombine_u8(vmovn_u16(low), vmovn_u16(high)));
+		}
+#endif
+	}
+	else {
+#if defined(UTF_SSE2)
+		const __m128i nonASCII = _mm_set1_epi32(static_cast<int>(0xFFFFFF80));
+		for (; i + 16 <= inLength; i += 16) {
+			auto block = reinterpret_cast<const __m128i*>(inText + i);
+			auto a = _mm_loadu_si128(block);
+			auto b = _mm_loadu_si128(block + 1);
+			auto c = _mm_loadu_si128(block + 2);
+			auto d = _mm_loadu_si128(block + 3);
+			auto outside = _mm_and_si128(_mm_or_si128(_mm_or_si128(a, b), _mm_or_si128(c, d)), nonASCII);
+			if (_mm_movemask_epi8(_mm_cmpeq_epi32(outside, _mm_setzero_si128())) != 0xFFFF) {
+				break;
+			}
+			auto bytes = _mm_packus_epi16(_mm_packs_epi32(a, b), _mm_packs_epi32(c, d));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(outText + i), bytes);
+		}
+#elif defined(UTF_NEON)
+		for (; i + 8 <= inLength; i += 8) {
+			auto low = vld1q_u32(reinterpret_cast<const uint32_t*>(inText + i));
+			auto high = vld1q_u32(reinterpret_cast<const uint32_t*>(inText + i + 4));
+			if (vmaxvq_u32(vorrq_u32(low, high)) >= 0x80) {
+				break;
+			}
+			vst1_u8(reinterpret_cast<uint8_t*>(outText + i), vmovn_u16(vcombine_u16(vmovn_u32(low), vmovn_u32(high))));
+		}
+#endif
+	}
+	return i;
+}
+
+// Copies whole blocks of ASCII bytes as wide code units, stopping at the first block with anything else in it, and
+// returns how many were copied.
+template<typename Unit>
+static size_t WidenASCIIBlocks(const char* inText, size_t inLength, Unit* outText)
+{
+	size_t i = 0;
+#if defined(UTF_AVX2)
+	if constexpr (sizeof(Unit) == 2) {
+		for (; i + 32 <= inLength; i += 32) {
+			auto bytes = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(inText + i));
+			if (_mm256_movemask_epi8(bytes) != 0) {
+				break;
+			}
+			auto out = reinterpret_cast<__m256i*>(outText + i);
+			_mm256_storeu_si256(out, _mm256_cvtepu8_epi16(_mm256_castsi256_si128(bytes)));
+			_mm256_storeu_si256(out + 1, _mm256_cvtepu8_epi16(_mm256_extracti128_si256(bytes, 1)));
+		}
+		return i;
+	}
+#endif
+#if defined(UTF_SSE2)
+	const __m128i zero = _mm_setzero_si128();
+	for (; i + 16 <= inLength; i += 16) {
+		auto bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(inText + i));
+		if (_mm_movemask_epi8(bytes) != 0) {
+			break;
+		}
+		auto low = _mm_unpacklo_epi8(bytes, zero);
+		auto high = _mm_unpackhi_epi8(bytes, zero);
+		auto out = reinterpret_cast<__m128i*>(outText + i);
+		if constexpr (sizeof(Unit) == 2) {
+			_mm_storeu_si128(out, low);
+			_mm_storeu_si128(out + 1, high);
+		}
+		else {
+			_mm_storeu_si128(out, _mm_unpacklo_epi16(low, zero));
+			_mm_storeu_si128(out + 1, _mm_unpackhi_epi16(low, zero));
+			_mm_storeu_si128(out + 2, _mm_unpacklo_epi16(high, zero));
+			_mm_storeu_si128(out + 3, _mm_unpackhi_epi16(high, zero));
+		}
+	}
+#elif defined(UTF_NEON)
+	for (; i + 16 <= inLength; i += 16) {
+		auto bytes = vld1q_u8(reinterpret_cast<const uint8_t*>(inText + i));
+		if (vmaxvq_u8(bytes) >= 0x80) {
+			break;
+		}
+		auto low = vmovl_u8(vget_low_u8(bytes));
+		auto high = vmovl_high_u8(bytes);
+		if constexpr (sizeof(Unit) == 2) {
+			auto out = reinterpret_cast<uint16_t*>(outText + i);
+			vst1q_u16(out, low);
+			vst1q_u16(out + 8, high);
+		}
+		else {
+			auto out = reinterpret_cast<uint32_t*>(outText + i);
+			vst1q_u32(out, vmovl_u16(vget_low_u16(low)));
+			vst1q_u32(out + 4, vmovl_high_u16(low));
+			vst1q_u32(out + 8, vmovl_u16(vget_low_u16(high)));
+			vst1q_u32(out + 12, vmovl_high_u16(high));
+		}
+	}
+#endif
+	return i;
+}
+
+// How many whole blocks of ASCII bytes inText starts with, in bytes
+static size_t ASCIIBlocks(const char* inText, size_t inLength)
+{
+	size_t i = 0;
+#if defined(UTF_AVX2)
+	for (; i + 32 <= inLength; i += 32) {
+		if (_mm256_movemask_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(inText + i))) != 0) {
+			break;
+		}
+	}
+#elif defined(UTF_SSE2)
+	for (; i + 16 <= inLength; i += 16) {
+		if (_mm_movemask_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(inText + i))) != 0) {
+			break;
+		}
+	}
+#elif defined(UTF_NEON)
+	for (; i + 16 <= inLength; i += 16) {
+		if (vmaxvq_u8(vld1q_u8(reinterpret_cast<const uint8_t*>(inText + i))) >= 0x80) {
+			break;
+		}
+	}
+#endif
+	return i;
+}
+
+static char* AppendUTF8(char* outText, char32_t inCodePoint)
+{
+	if (inCodePoint < 0x80) {
+		*outText++ = static_cast<char>(inCodePoint);
+	}
+	else if (inCodePoint < 0x800) {
+		*outText++ = static_cast<char>(0xC0 | (inCodePoint >> 6));
+		*outText++ = static_cast<char>(0x80 | (inCodePoint & 0x3F));
+	}
+	else if (inCodePoint < 0x10000) {
+		*outText++ = static_cast<char>(0xE0 | (inCodePoint >> 12));
+		*outText++ = static_cast<char>(0x80 | ((inCodePoint >> 6) & 0x3F));
+		*outText++ = static_cast<char>(0x80 | (inCodePoint & 0x3F));
+	}
+	else {
+		*outText++ = static_cast<char>(0xF0 | (inCodePoint >> 18));
+		*outText++ = static_cast<char>(0x80 | ((inCodePoint >> 12) & 0x3F));
+		*outText++ = static_cast<char>(0x80 | ((inCodePoint >> 6) & 0x3F));
+		*outText++ = static_cast<char>(0x80 | (inCodePoint & 0x3F));
+	}
+	return outText;
+}
+
+template<typename Unit>
+static size_t NarrowUnits(const Unit* inText, size_t inLength, char* outText, bool& outValid)
+{
+	outValid = true;
+	char* out = outText;
+	size_t i = 0;
+	while (i < inLength) {
+		auto copied = NarrowASCIIBlocks(inText + i, inLength - i, out);
+		i += copied;
+		out += copied;
+
+		for (size_t end = std::min(inLength, i + kScalarRun); i < end; ) {
+			char32_t codePoint = static_cast<std::make_unsigned_t<Unit>>(inText[i++]);
+			if (codePoint >= 0xD800 && codePoint <= 0xDFFF) {
+				char32_t low = sizeof(Unit) == 2 && i < inLength ? static_cast<std::make_unsigned_t<Unit>>(inText[i]) : 0;
+				if (codePoint <= 0xDBFF && low >= 0xDC00 && low <= 0xDFFF) {
+					codePoint = 0x10000 + ((codePoint - 0xD800) << 10) + (low - 0xDC00);
+					++i;
+				}
+				else {
+					codePoint = 0xFFFD;
+					outValid = false;
+				}
+			}
+			else if (codePoint > 0x10FFFF) {
+				codePoint = 0xFFFD;
+				outValid = false;
+			}
+			out = AppendUTF8(out, codePoint);
+		}
+	}
+	return out - outText;
+}
+
+template<typename Unit>
+static size_t WidenUnits(const char* inText, size_t inLength, Unit* outText, bool& outValid)
+{
+	std::string_view text(inText, inLength);
+	outValid = true;
+	Unit* out = outText;
+	size_t i = 0;
+	while (i < inLength) {
+		auto copied = WidenASCIIBlocks(inText + i, inLength - i, out);
+		i += copied;
+		out += copied;
+
+		for (size_t end = std::min(inLength, i + kScalarRun); i < end; ) {
+			char32_t codePoint;
+			if (!DecodeUTF8(text, i, codePoint)) {
+				codePoint = 0xFFFD;
+				outValid = false;
+				++i;
+			}
+			if (sizeof(Unit) == 2 && codePoint >= 0x10000) {
+				*out++ = static_cast<Unit>(0xD800 + ((codePoint - 0x10000) >> 10));
+				*out++ = static_cast<Unit>(0xDC00 + (codePoint & 0x3FF));
+			}
+			else {
+				*out++ = static_cast<Unit>(codePoint);
+			}
+		}
+	}
+	return out - outText;
+}
+
+size_t WideToUTF8(const wchar_t* inText, size_t inLength, char* outText, bool& outValid)
+{
+	return NarrowUnits(inText, inLength, outText, outValid);
+}
+
+size_t UTF8ToWide(const char* inText, size_t inLength, wchar_t* outText, bool& outValid)
+{
+	return WidenUnits(inText, inLength, outText, outValid);
+}
+
+std::string ToUTF8(std::wstring_view inText)
+{
+	std::string text(MaxUTF8Size(inText.size()), '\0');
+	bool valid;
+	text.resize(WideToUTF8(inText.data(), inText.size(), text.data(), valid));
+	return text;
+}
+
+std::wstring ToWide(std::string_view inText)
+{
+	std::wstring text(MaxWideSize(inText.size()), L'\0');
+	bool valid;
+	text.resize(UTF8ToWide(inText.data(), inText.size(), text.data(), valid));
+	return text;
+}
+
+bool DecodeUTF8(std::string_view inText, size_t& ioIndex, char32_t& outCodePoint)
+{
+	auto lead = static_cast<unsigned char>(inText[ioIndex]);
+	size_t trail;
+	char32_t minimum;
+	if (lead < 0x80) {
+		outCodePoint = lead;
+		++ioIndex;
+		return true;
+	}
+	else if (lead >= 0xC2 && lead <= 0xDF) {
+		trail = 1;
+		minimum = 0x80;
+		outCodePoint = lead & 0x1F;
+	}
+	else if (lead >= 0xE0 && lead <= 0xEF) {
+		trail = 2;
+		minimum = 0x800;
+		outCodePoint = lead & 0x0F;
+	}
+	else if (lead >= 0xF0 && lead <= 0xF4) {
+		trail = 3;
+		minimum = 0x10000;
+		outCodePoint = lead & 0x07;
+	}
+	else {
+		return false;
+	}
+
+	if (inText.size() - ioIndex <= trail) {
+		return false;
+	}
+	for (size_t i = 1; i <= trail; ++i) {
+		auto unit = static_cast<unsigned char>(inText[ioIndex + i]);
+		if ((unit & 0xC0) != 0x80) {
+			return false;
+		}
+		outCodePoint = (outCodePoint << 6) | (unit & 0x3F);
+	}
+	if (outCodePoint < minimum || outCodePoint > 0x10FFFF || (outCodePoint >= 0xD800 && outCodePoint <= 0xDFFF)) {
+		return false;
+	}
+	ioIndex += trail + 1;
+	return true;
+}
+
+size_t ValidUTF8Length(std::string_view inText)
+{
+	size_t i = 0;
+	while (i < inText.size()) {
+		i += ASCIIBlocks(inText.data() + i, inText.size() - i);
+		char32_t codePoint;
+		for (size_t end = std::min(inText.size(), i + kScalarRun); i < end; ) {
+			if (!DecodeUTF8(inText, i, codePoint)) {
+				return i;
+			}
+		}
+	}
+	return i;
+}
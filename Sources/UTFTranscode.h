@@ -0,0 +1,41 @@
+//==============================================================================
+/**
+@file       UTFTranscode.h
+
+@brief      Validating UTF-8 <-> wide string conversion with a vectorized ASCII path
+
+@copyright  (c) 2021, bionyx187
+			This source code is licensed under the MIT-style license found in the LICENSE file.
+
+**/
+//==============================================================================
+
+#pragma once
+
+#include <string>
+#include <string_view>
+
+// Wide strings are UTF-16 on Windows and UTF-32 everywhere else, as wchar_t is. Runs of ASCII are
+// converted 16 or 32 code units at a time with SSE2, AVX2 or NEON, whichever the build targets, and
+// everything else one code point at a time. Invalid input (unpaired surrogates, code points past
+// U+10FFFF, malformed UTF-8) becomes U+FFFD, like WideCharToMultiByte does, and is reported.
+
+// The most a conversion of inLength units can write, so the output is sized once instead of in a
+// counting pass first
+constexpr size_t MaxUTF8Size(size_t inWideLength) { return inWideLength * (sizeof(wchar_t) == 2 ? 3 : 4); }
+constexpr size_t MaxWideSize(size_t inUTF8Length) { return inUTF8Length; }
+
+// Convert into a buffer of at least the maximum size and return how much was written. outValid says
+// whether the input was valid.
+size_t WideToUTF8(const wchar_t* inText, size_t inLength, char* outText, bool& outValid);
+size_t UTF8ToWide(const char* inText, size_t inLength, wchar_t* outText, bool& outValid);
+
+std::string ToUTF8(std::wstring_view inText);
+std::wstring ToWide(std::string_view inText);
+
+// Reads the code point at ioIndex and moves past it, or returns false and leaves ioIndex alone.
+// Overlong forms, surrogates and code points past U+10FFFF are invalid.
+bool DecodeUTF8(std::string_view inText, size_t& ioIndex, char32_t& outCodePoint);
+
+// The length of the longest valid UTF-8 prefix of inText, which is all of it for valid text
+size_t ValidUTF8Length(std::string_view inText);
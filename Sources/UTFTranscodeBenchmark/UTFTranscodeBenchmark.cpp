@@ -0,0 +1,300 @@
+//==============================================================================
+/**
+@file       UTFTranscodeBenchmark.cpp
+
+@brief      Checks the UTF transcoder and times it against the two-pass encoder it replaced
+
+@copyright  (c) 2021, bionyx187
+			This source code is licensed under the MIT-style license found in the LICENSE file.
+
+**/
+//==============================================================================
+
+// First checks the transcoder: malformed UTF-8 and unpaired surrogates against known answers, then
+// random text round-tripped and compared with a plain one-code-point-at-a-time encoder and decoder.
+// Then times ToUTF8 against the encoder it replaced, which sized the output in a first pass and
+// converted in a second (WideCharToMultiByte on Windows), on a title, a CJK title and 10 KB of base64.
+// Exits with 1 when a check fails.
+//
+// UTFTranscodeBenchmark [-iterations 100000]
+
+#include "../UTFTranscode.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+
+#ifdef _WIN32
+#include <Windows.h>
+#endif
+
+using Clock = std::chrono::steady_clock;
+
+static const size_t kRandomStrings = 20000;
+static const size_t kMaxRandomLength = 200; // long enough to cover several vector blocks and what is left after them
+static const size_t kBase64Size = 10 * 1024;
+
+static int sFailures = 0;
+
+static void Check(bool inOk, const std::string& inWhat)
+{
+	std::printf("%s: %s\n", inOk ? "ok" : "FAILED", inWhat.c_str());
+	if (!inOk) {
+		++sFailures;
+	}
+}
+
+// Appends a code point as one wchar_t, or as a surrogate pair where wchar_t is UTF-16
+static void AppendWide(std::wstring& ioText, char32_t inCodePoint)
+{
+	if (sizeof(wchar_t) == 2 && inCodePoint >= 0x10000) {
+		ioText += static_cast<wchar_t>(0xD800 + ((inCodePoint - 0x10000) >> 10));
+		ioText += static_cast<wchar_t>(0xDC00 + (inCodePoint & 0x3FF));
+	}
+	else {
+		ioText += static_cast<wchar_t>(inCodePoint);
+	}
+}
+
+// The code point at ioIndex, with unpaired surrogates and anything past U+10FFFF read as U+FFFD
+static char32_t ReadWide(const std::wstring& inText, size_t& ioIndex)
+{
+	char32_t codePoint = static_cast<char32_t>(inText[ioIndex++]);
+	if (codePoint >= 0xD800 && codePoint <= 0xDBFF && sizeof(wchar_t) == 2 && ioIndex < inText.size()) {
+		char32_t low = static_cast<char32_t>(inText[ioIndex]);
+		if (low >= 0xDC00 && low <= 0xDFFF) {
+			++ioIndex;
+			return 0x10000 + ((codePoint - 0xD800) << 10) + (low - 0xDC00);
+		}
+	}
+	if ((codePoint >= 0xD800 && codePoint <= 0xDFFF) || codePoint > 0x10FFFF) {
+		return 0xFFFD;
+	}
+	return codePoint;
+}
+
+// The encoder ToUTF8 replaced: count, allocate, convert
+static std::string TwoPassEncode(const std::wstring& inText)
+{
+	if (inText.empty()) {
+		return std::string();
+	}
+#ifdef _WIN32
+	int size = WideCharToMultiByte(CP_UTF8, 0, inText.data(), static_cast<int>(inText.size()), nullptr, 0, nullptr, nullptr);
+	std::string text(size, '\0');
+	WideCharToMultiByte(CP_UTF8, 0, inText.data(), static_cast<int>(inText.size()), &text[0], size, nullptr, nullptr);
+	return text;
+#else
+	size_t size = 0;
+	for (size_t i = 0; i < inText.size(); ) {
+		char32_t codePoint = ReadWide(inText, i);
+		size += codePoint < 0x80 ? 1 : codePoint < 0x800 ? 2 : codePoint < 0x10000 ? 3 : 4;
+	}
+	std::string text(size, '\0');
+	size_t out = 0;
+	for (size_t i = 0; i < inText.size(); ) {
+		char32_t codePoint = ReadWide(inText, i);
+		if (codePoint < 0x80) {
+			text[out++] = static_cast<char>(codePoint);
+		}
+		else if (codePoint < 0x800) {
+			text[out++] = static_cast<char>(0xC0 | (codePoint >> 6));
+			text[out++] = static_cast<char>(0x80 | (codePoint & 0x3F));
+		}
+		else if (codePoint < 0x10000) {
+			text[out++] = static_cast<char>(0xE0 | (codePoint >> 12));
+			text[out++] = static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+			text[out++] = static_cast<char>(0x80 | (codePoint & 0x3F));
+		}
+		else {
+			text[out++] = static_cast<char>(0xF0 | (codePoint >> 18));
+			text[out++] = static_cast<char>(0x80 | ((codePoint >> 12) & 0x3F));
+			text[out++] = static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+			text[out++] = static_cast<char>(0x80 | (codePoint & 0x3F));
+		}
+	}
+	return text;
+#endif
+}
+
+// UTF-8 to wide one DecodeUTF8 at a time, with one U+FFFD for every byte that doesn't start a valid sequence
+static std::wstring SimpleDecode(const std::string& inText)
+{
+	std::wstring text;
+	size_t i = 0;
+	while (i < inText.size()) {
+		char32_t codePoint;
+		if (!DecodeUTF8(inText, i, codePoint)) {
+			codePoint = 0xFFFD;
+			++i;
+		}
+		AppendWide(text, codePoint);
+	}
+	return text;
+}
+
+// Malformed UTF-8 and how much of it is valid
+static void CheckValidation()
+{
+	struct Case
+	{
+		const char* name;
+		std::string text;
+		size_t validLength;
+	};
+	const std::string ascii(40, 'a');
+	const std::vector<Case> cases = {
+		{ "ASCII", "Title", 5 },
+		{ "two, three and four byte forms", "\xC3\xA9\xE2\x82\xAC\xF0\x9F\x8E\xB5", 9 },
+		{ "highest code point", "\xF4\x8F\xBF\xBF", 4 },
+		{ "overlong two byte form", "a\xC0\x80", 1 },
+		{ "overlong three byte form", "a\xE0\x80\x80", 1 },
+		{ "overlong four byte form", "a\xF0\x80\x80\x80", 1 },
+		{ "encoded surrogate", "a\xED\xA0\x80", 1 },
+		{ "past U+10FFFF", "a\xF4\x90\x80\x80", 1 },
+		{ "invalid lead byte", "a\xF8\x88\x80\x80\x80", 1 },
+		{ "lone continuation byte", "a\x80", 1 },
+		{ "truncated sequence", "a\xE2\x82", 1 },
+		{ "continuation byte missing", "a\xE2\x82" "b", 1 },
+		{ "invalid byte after a vector block", ascii + "\xFF" + ascii, ascii.size() },
+	};
+
+	for (const auto& test : cases) {
+		bool valid = true;
+		std::wstring wide(MaxWideSize(test.text.size()), L'\0');
+		wide.resize(UTF8ToWide(test.text.data(), test.text.size(), &wide[0], valid));
+		Check(ValidUTF8Length(test.text) == test.validLength && valid == (test.validLength == test.text.size()) &&
+			wide == SimpleDecode(test.text), "validation: " + std::string(test.name));
+	}
+
+	// U+FFFD for each byte of a malformed sequence, and the text around it kept
+	Check(ToWide("a\xE2\x82" "b") == L"a\uFFFD\uFFFDb", "validation: U+FFFD for each byte of a truncated sequence");
+
+	std::wstring unpaired = L"a";
+	unpaired += static_cast<wchar_t>(0xD800);
+	unpaired += L"b";
+	unpaired += static_cast<wchar_t>(0xDC00);
+	bool valid = true;
+	std::string narrow(MaxUTF8Size(unpaired.size()), '\0');
+	narrow.resize(WideToUTF8(unpaired.data(), unpaired.size(), &narrow[0], valid));
+	Check(!valid && narrow == "a\xEF\xBF\xBD" "b\xEF\xBF\xBD" && narrow == TwoPassEncode(unpaired), "validation: U+FFFD for unpaired surrogates");
+}
+
+// A random code point: mostly ASCII, since titles are, the rest spread over the two, three and four byte forms
+static char32_t RandomCodePoint(std::mt19937& ioRandom)
+{
+	switch (ioRandom() % 8) {
+	case 0: return 0x80 + ioRandom() % 0x780;
+	case 1: return 0x800 + ioRandom() % (0xD800 - 0x800);
+	case 2: return 0xE000 + ioRandom() % 0x2000;
+	case 3: return 0x10000 + ioRandom() % 0x100000;
+	default: return 0x20 + ioRandom() % 0x5F;
+	}
+}
+
+// Random valid text through both conversions and back, and random bytes through the decoder
+static void CheckRoundTrips()
+{
+	std::mt19937 random(187);
+	size_t encodeMismatches = 0;
+	size_t roundTripMismatches = 0;
+	size_t decodeMismatches = 0;
+	for (size_t n = 0; n < kRandomStrings; ++n) {
+		std::wstring wide;
+		size_t length = random() % kMaxRandomLength;
+		bool allASCII = random() % 4 == 0;
+		for (size_t i = 0; i < length; ++i) {
+			AppendWide(wide, allASCII ? 0x20 + random() % 0x5F : RandomCodePoint(random));
+		}
+
+		bool valid = false;
+		std::string narrow(MaxUTF8Size(wide.size()), '\0');
+		narrow.resize(WideToUTF8(wide.data(), wide.size(), &narrow[0], valid));
+		if (!valid || narrow != TwoPassEncode(wide)) {
+			++encodeMismatches;
+		}
+		std::wstring back(MaxWideSize(narrow.size()), L'\0');
+		back.resize(UTF8ToWide(narrow.data(), narrow.size(), &back[0], valid));
+		if (!valid || back != wide || ValidUTF8Length(narrow) != narrow.size()) {
+			++roundTripMismatches;
+		}
+
+		// Mostly ASCII with stray bytes, so the vector blocks are broken off at random places
+		std::string bytes;
+		for (size_t i = 0; i < length; ++i) {
+			bytes += static_cast<char>(random() % 4 == 0 ? random() % 0x100 : 0x20 + random() % 0x5F);
+		}
+		std::wstring decoded(MaxWideSize(bytes.size()), L'\0');
+		decoded.resize(UTF8ToWide(bytes.data(), bytes.size(), &decoded[0], valid));
+		if (decoded != SimpleDecode(bytes) || valid != (ValidUTF8Length(bytes) == bytes.size())) {
+			++decodeMismatches;
+		}
+	}
+
+	auto count = " of " + std::to_string(kRandomStrings);
+	Check(encodeMismatches == 0, "round trip: " + std::to_string(encodeMismatches) + count + " encoded differently from the two-pass encoder");
+	Check(roundTripMismatches == 0, "round trip: " + std::to_string(roundTripMismatches) + count + " came back different");
+	Check(decodeMismatches == 0, "round trip: " + std::to_string(decodeMismatches) + count + " random byte strings decoded differently");
+}
+
+// Nanoseconds per conversion of inText, by the two-pass encoder and by ToUTF8
+static void Time(const char* inName, const std::wstring& inText, size_t inIterations)
+{
+	size_t sink = 0;
+	auto start = Clock::now();
+	for (size_t i = 0; i < inIterations; ++i) {
+		sink += TwoPassEncode(inText).size();
+	}
+	auto middle = Clock::now();
+	for (size_t i = 0; i < inIterations; ++i) {
+		sink += ToUTF8(inText).size();
+	}
+	auto end = Clock::now();
+
+	auto twoPass = std::chrono::duration<double, std::nano>(middle - start).count() / inIterations;
+	auto transcoder = std::chrono::duration<double, std::nano>(end - middle).count() / inIterations;
+	std::printf("%-14s %6zu units  two-pass %10.1f ns  transcoder %10.1f ns  %5.1fx  (%zu)\n", inName, inText.size(), twoPass, transcoder,
+		twoPass / transcoder, sink);
+}
+
+static void RunBenchmarks(size_t inIterations)
+{
+	std::mt19937 random(187);
+	const char alphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+	std::wstring base64;
+	for (size_t i = 0; i < kBase64Size; ++i) {
+		base64 += static_cast<wchar_t>(alphabet[random() % 64]);
+	}
+
+	// 10 KB is a few hundred titles' worth, so it gets proportionally fewer runs
+	Time("ASCII title", L"Never Gonna Give You Up (Official Music Video)", inIterations);
+	Time("CJK title", L"\u65E5\u672C\u8A9E\u306E\u30BF\u30A4\u30C8\u30EB\u304C\u3068\u3066\u3082\u9577\u3044\u66F2 - \u30A2\u30FC\u30C6\u30A3\u30B9\u30C8", inIterations);
+	Time("10 KB base64", base64, inIterations / 100 + 1);
+}
+
+int main(int argc, const char* const argv[])
+{
+	size_t iterations = 100000;
+	for (int i = 1; i + 1 < argc; i += 2) {
+		std::string parameter(argv[i]);
+		if (parameter == "-iterations") {
+			iterations = std::strtoul(argv[i + 1], nullptr, 10);
+		}
+		else {
+			std::fprintf(stderr, "Unknown parameter %s\n", parameter.c_str());
+			return 1;
+		}
+	}
+
+	CheckValidation();
+	CheckRoundTrips();
+	if (sFailures == 0 && iterations > 0) {
+		RunBenchmarks(iterations);
+	}
+
+	std::printf("%d failure(s)\n", sFailures);
+	return sFailures == 0 ? 0 : 1;
+}
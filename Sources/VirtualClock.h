@@ -0,0 +1,38 @@
+//==============================================================================
+/**
+@file       VirtualClock.h
+
+@brief      Manually advanced time for driving the tick scheduler without waiting
+
+@copyright  (c) 2021, bionyx187
+			This source code is licensed under the MIT-style license found in the LICENSE file.
+
+**/
+//==============================================================================
+
+#pragma once
+
+#include <chrono>
+
+// Stands in for std::chrono::steady_clock. Time only moves when the owner moves it, so an hour of
+// ticks runs as fast as the tick function allows and every deadline is hit exactly.
+class VirtualClock
+{
+public:
+	using time_point = std::chrono::steady_clock::time_point;
+	using duration = std::chrono::steady_clock::duration;
+
+	time_point Now() const { return mNow; }
+
+	// Time never goes backwards; earlier times are ignored.
+	void AdvanceTo(time_point inTime)
+	{
+		if (inTime > mNow) {
+			mNow = inTime;
+		}
+	}
+	void Advance(duration inDuration) { AdvanceTo(mNow + inDuration); }
+
+private:
+	time_point mNow{};
+};
@@ -57,12 +57,12 @@ void __cdecl dbgprintf(const char *format, ...);
 using json = nlohmann::json;
 
 
-// Configuration for event logging
+// Logging categories that start out at the Debug level. Any category can be turned up
+// at runtime from the property inspector; see Logger.h.
 
 #define LOG_SESSIONS 0
 #define LOG_EVENTS 0
 #define LOG_MESSAGES 0
-#define LOG_EXCEPTIONS 1
 
 //-------------------------------------------------------------------
 // websocketpp
@@ -72,6 +72,18 @@
             {
                 refreshTime.value = settings.refresh_time;
             }
+
+		var scrollMode = document.getElementById("scroll_mode");
+            if (settings.hasOwnProperty("scroll_mode"))
+            {
+                scrollMode.value = settings.scroll_mode;
+            }
+
+		var metricsPort = document.getElementById("metrics_port");
+            if (settings.hasOwnProperty("metrics_port") && settings.metrics_port > 0)
+            {
+                metricsPort.value = settings.metrics_port;
+            }
 	}
 
         function getSettings()
@@ -95,12 +107,16 @@
             {
 		console.log("have websocket");
 		var refreshTime = document.getElementById("refresh_time");
+		var scrollMode = document.getElementById("scroll_mode");
+		var metricsPort = document.getElementById("metrics_port");
                 const json = 
                 {
                     "event": "setSettings",
                     "context": uuid,
                     "payload":{
                         "refresh_time" : parseInt(refreshTime.value, 10),
+                        "scroll_mode" : scrollMode.value,
+                        "metrics_port" : parseInt(metricsPort.value, 10) || 0,
                     }
                 };
                 websocket.send(JSON.stringify(json));